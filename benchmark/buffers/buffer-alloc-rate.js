@@ -0,0 +1,46 @@
+'use strict';
+
+// Measures the rate at which short-lived Buffers can be allocated and
+// released through the native ArrayBuffer allocator. The JS-side pool is
+// disabled so that every allocation reaches the allocator.
+const common = require('../common.js');
+const assert = require('assert');
+const bench = common.createBenchmark(main, {
+  type: [
+    'allocUnsafe',
+    'alloc',
+    'from-string',
+    'arraybuffer',
+  ],
+  len: [64, 1024, 16384, 65536],
+  n: [5e5]
+});
+
+function main({ len, n, type }) {
+  Buffer.poolSize = 0;
+  let fn;
+  switch (type) {
+    case 'allocUnsafe':
+      fn = () => Buffer.allocUnsafe(len);
+      break;
+    case 'alloc':
+      fn = () => Buffer.alloc(len);
+      break;
+    case 'from-string': {
+      const str = 'a'.repeat(len);
+      fn = () => Buffer.from(str, 'latin1');
+      break;
+    }
+    case 'arraybuffer':
+      fn = () => new ArrayBuffer(len);
+      break;
+    default:
+      assert.fail('Should not get here');
+  }
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    fn();
+  }
+  bench.end(n);
+}
@@ -0,0 +1,47 @@
+'use strict';
+const common = require('../common.js');
+
+// Covers comparison and pattern fills from tiny to very large buffers. The
+// number of iterations is scaled so that every configuration processes about
+// the same number of bytes.
+const bench = common.createBenchmark(main, {
+  type: [
+    'compare',
+    'equals',
+    'fill("abc")',
+    'fill(Buffer)',
+  ],
+  size: [16, 1024, 64 * 1024, 1024 * 1024, 64 * 1024 * 1024],
+  bytes: [2 ** 30]
+});
+
+function main({ type, size, bytes }) {
+  const n = Math.max(1, Math.floor(bytes / size));
+  const a = Buffer.alloc(size, 'a');
+  const b = Buffer.alloc(size, 'a');
+  // Make the buffers differ at the end so that the whole range is scanned.
+  b[size - 1] = 'b'.charCodeAt(0);
+  const pattern = Buffer.from('0123456789abcdef'.repeat(3));
+
+  let fn;
+  switch (type) {
+    case 'compare':
+      fn = () => Buffer.compare(a, b);
+      break;
+    case 'equals':
+      fn = () => a.equals(b);
+      break;
+    case 'fill("abc")':
+      fn = () => a.fill('abc');
+      break;
+    case 'fill(Buffer)':
+      fn = () => a.fill(pattern);
+      break;
+  }
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    fn();
+  }
+  bench.end(n);
+}
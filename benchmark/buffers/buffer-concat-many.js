@@ -0,0 +1,31 @@
+'use strict';
+const common = require('../common.js');
+const { BufferChain } = require('buffer');
+
+// Models body parsers that collect many small chunks per request.
+const bench = common.createBenchmark(main, {
+  type: ['concat', 'bufferchain'],
+  pieces: [16, 256, 1024],
+  pieceSize: [16, 512],
+  n: [1e4]
+});
+
+function main({ n, type, pieces, pieceSize }) {
+  const list = [];
+  for (let i = 0; i < pieces; i++)
+    list.push(Buffer.alloc(pieceSize, i));
+
+  if (type === 'concat') {
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      Buffer.concat(list);
+    }
+    bench.end(n);
+  } else {
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      new BufferChain(list).toBuffer();
+    }
+    bench.end(n);
+  }
+}
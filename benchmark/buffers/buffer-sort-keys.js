@@ -0,0 +1,37 @@
+'use strict';
+const common = require('../common.js');
+const { sortKeys } = require('buffer');
+
+const bench = common.createBenchmark(main, {
+  method: ['sortKeys', 'Buffer.compare'],
+  keyLength: [8, 32],
+  keys: [1e3, 1e5],
+  n: [10]
+});
+
+function main({ n, method, keyLength, keys }) {
+  const source = Buffer.allocUnsafe(keyLength * keys);
+  for (let i = 0; i < source.length; i++)
+    source[i] = Math.floor(Math.random() * 256);
+  const offsets = new Uint32Array(keys);
+  for (let i = 0; i < keys; i++)
+    offsets[i] = i * keyLength;
+
+  if (method === 'sortKeys') {
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      sortKeys(source, offsets, keyLength);
+    }
+    bench.end(n);
+  } else {
+    const views = Array.from(offsets,
+                             (offset) => source.subarray(offset,
+                                                         offset + keyLength));
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      Array.from(views.keys()).sort((a, b) => Buffer.compare(views[a],
+                                                             views[b]));
+    }
+    bench.end(n);
+  }
+}
@@ -0,0 +1,31 @@
+'use strict';
+const common = require('../common.js');
+const { createTranscodeStream } = require('buffer');
+
+const bench = common.createBenchmark(main, {
+  conversion: ['latin1:utf8', 'utf8:utf16le', 'utf16le:utf8', 'utf8:latin1'],
+  chunkSize: [1024, 64 * 1024],
+  size: [64 * 1024 * 1024]
+});
+
+function main({ conversion, chunkSize, size }) {
+  const [from, to] = conversion.split(':');
+  const text = 'Grüße aus Köln, ¿qué tal? '.repeat(chunkSize / 16);
+  const chunk = Buffer.from(text, from).slice(0, chunkSize);
+  const n = Math.ceil(size / chunkSize);
+
+  const stream = createTranscodeStream(from, to);
+  stream.on('data', () => {});
+  stream.on('end', () => bench.end(size / 2 ** 20));
+
+  bench.start();
+  let written = 0;
+  (function write() {
+    while (written < n) {
+      written++;
+      if (!stream.write(chunk))
+        return stream.once('drain', write);
+    }
+    stream.end();
+  })();
+}
@@ -0,0 +1,95 @@
+// Compares how fast connections are accepted, and how evenly they are spread
+// over the workers, between cluster's round-robin and shared-handle modes and
+// workers listening with SO_REUSEPORT.
+'use strict';
+
+const cluster = require('cluster');
+const net = require('net');
+
+if (cluster.isMaster) {
+  const common = require('../common.js');
+  const bench = common.createBenchmark(main, {
+    mode: ['round-robin', 'shared', 'reusePort'],
+    // `skew` reports how many more connections the busiest worker accepted
+    // than it would have with a perfectly even spread, e.g. 1.5 for 50% more.
+    metric: ['rate', 'skew'],
+    workers: [2, 4],
+    concurrency: [50],
+    n: [1e4]
+  });
+
+  function main({ mode, metric, workers, concurrency, n }) {
+    cluster.schedulingPolicy = mode === 'round-robin' ?
+      cluster.SCHED_RR : cluster.SCHED_NONE;
+    cluster.setupMaster({ args: [mode] });
+
+    const counts = [];
+    let listening = 0;
+    for (let i = 0; i < workers; i++) {
+      const worker = cluster.fork();
+      worker.on('listening', () => {
+        if (++listening === workers)
+          run();
+      });
+      worker.on('message', (count) => {
+        counts.push(count);
+        if (counts.length === workers)
+          finish();
+      });
+    }
+
+    let started = 0;
+    let done = 0;
+    let start;
+
+    function run() {
+      start = process.hrtime();
+      bench.start();
+      for (let i = 0; i < concurrency; i++)
+        connect();
+    }
+
+    function connect() {
+      if (started === n)
+        return;
+      started++;
+      const socket = net.connect(common.PORT, '127.0.0.1');
+      socket.on('close', () => {
+        if (++done === n) {
+          if (metric === 'rate')
+            bench.end(n);
+          for (const id in cluster.workers)
+            cluster.workers[id].send('count');
+        } else {
+          connect();
+        }
+      });
+      socket.resume();
+    }
+
+    function finish() {
+      if (metric === 'skew') {
+        const max = Math.max(...counts);
+        bench.report(max / (n / workers), process.hrtime(start));
+      }
+      for (const id in cluster.workers)
+        cluster.workers[id].disconnect();
+    }
+  }
+} else {
+  const mode = process.argv[2];
+  let accepted = 0;
+  const server = net.createServer((socket) => {
+    accepted++;
+    socket.end();
+  });
+  server.listen({
+    port: require('../common.js').PORT,
+    host: '127.0.0.1',
+    reusePort: mode === 'reusePort'
+  });
+  process.on('message', () => {
+    process.send(accepted);
+  });
+  process.on('disconnect', () => server.close());
+}
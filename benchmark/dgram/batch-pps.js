@@ -0,0 +1,75 @@
+// Test UDP packet rates on loopback when sending and receiving in batches.
+'use strict';
+
+const common = require('../common.js');
+const dgram = require('dgram');
+const PORT = common.PORT;
+
+// `num` is the number of datagrams queued up each time, either as separate
+// send() calls or as one sendBatch() call. `recvBatchSize` 0 disables
+// batched receive.
+const bench = common.createBenchmark(main, {
+  len: [64, 512],
+  num: [64],
+  method: ['send', 'sendBatch'],
+  recvBatchSize: [0, 20],
+  type: ['send', 'recv'],
+  dur: [5]
+});
+
+function main({ dur, len, num, method, recvBatchSize, type }) {
+  const messages = Array.from({ length: num }, () => Buffer.alloc(len, 'x'));
+  let sent = 0;
+  let received = 0;
+  const server = dgram.createSocket({
+    type: 'udp4',
+    recvBatchSize: recvBatchSize || undefined
+  });
+  const client = dgram.createSocket('udp4');
+
+  function onbatch(err, count) {
+    if (err) throw err;
+    sent += count;
+    // The setImmediate() is necessary to have event loop progress on OSes
+    // that only perform synchronous I/O on nonblocking UDP sockets.
+    setImmediate(sendMore);
+  }
+
+  function onsend() {
+    if (++sent % num === 0)
+      setImmediate(sendMore);
+  }
+
+  function sendMore() {
+    if (method === 'sendBatch') {
+      client.sendBatch(messages, PORT, '127.0.0.1', onbatch);
+    } else {
+      for (let i = 0; i < num; i++)
+        client.send(messages[i], PORT, '127.0.0.1', onsend);
+    }
+  }
+
+  if (recvBatchSize) {
+    server.on('messages', (msgs) => {
+      received += msgs.length;
+    });
+  } else {
+    server.on('message', () => {
+      received++;
+    });
+  }
+
+  server.on('listening', () => {
+    bench.start();
+    sendMore();
+
+    setTimeout(() => {
+      // Report thousands of packets per second.
+      const packets = type === 'send' ? sent : received;
+      bench.end(packets / 1000);
+      process.exit(0);
+    }, dur * 1000);
+  });
+
+  server.bind(PORT);
+}
@@ -4,12 +4,14 @@ const common = require('../common');
 
 const bench = common.createBenchmark(main, {
   len: [4, 8, 16, 32],
+  lazy: ['true', 'false'],
   n: [1e5]
 }, {
   flags: ['--expose-internals', '--no-warnings']
 });
 
-function main({ len, n }) {
+function main({ len, lazy, n }) {
+  const lazyHeaders = lazy === 'true';
   const { HTTPParser } = common.binding('http_parser');
   const REQUEST = HTTPParser.REQUEST;
   const kOnHeaders = HTTPParser.kOnHeaders | 0;
@@ -24,14 +26,14 @@ function main({ len, n }) {
     bench.start();
     for (let i = 0; i < n; i++) {
       parser.execute(header, 0, header.length);
-      parser.initialize(REQUEST, {});
+      parser.initialize(REQUEST, {}, 0, false, lazyHeaders);
     }
     bench.end(n);
   }
 
   function newParser(type) {
     const parser = new HTTPParser();
-    parser.initialize(type, {});
+    parser.initialize(type, {}, 0, false, lazyHeaders);
 
     parser.headers = [];
 
@@ -0,0 +1,59 @@
+// Throughput of keep-alive client requests to a local server through
+// http.Agent and http.PoolAgent.
+'use strict';
+
+const common = require('../common.js');
+const http = require('http');
+
+const bench = common.createBenchmark(main, {
+  agent: ['agent', 'pool-lifo', 'pool-fifo', 'pool-latency'],
+  concurrency: [10, 100],
+  maxSockets: [10, 100],
+  n: [2e4]
+});
+
+function main({ agent, concurrency, maxSockets, n }) {
+  const options = { keepAlive: true, maxSockets };
+  if (agent === 'agent') {
+    agent = new http.Agent(options);
+  } else {
+    options.scheduling = agent.slice(5);
+    agent = new http.PoolAgent(options);
+  }
+
+  const server = http.createServer((req, res) => {
+    res.end('ok');
+  });
+
+  let started = 0;
+  let done = 0;
+
+  server.listen(common.PORT, '127.0.0.1', () => {
+    bench.start();
+    for (let i = 0; i < concurrency; i++)
+      request();
+  });
+
+  function request() {
+    if (started === n)
+      return;
+    started++;
+    http.get({
+      agent,
+      host: '127.0.0.1',
+      port: common.PORT,
+      path: '/'
+    }, (res) => {
+      res.resume();
+      res.on('end', () => {
+        if (++done === n) {
+          bench.end(n);
+          agent.destroy();
+          server.close();
+        } else {
+          request();
+        }
+      });
+    });
+  }
+}
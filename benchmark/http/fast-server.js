@@ -0,0 +1,34 @@
+// Compares http.createFastServer() with http.createServer() for small
+// responses, like benchmark/http/simple.js does for the latter.
+'use strict';
+const common = require('../common.js');
+const http = require('http');
+
+const bench = common.createBenchmark(main, {
+  server: ['fast', 'http'],
+  len: [4, 1024],
+  c: [50, 500],
+  duration: 5
+});
+
+function main({ server: type, len, c, duration }) {
+  const body = Buffer.alloc(len, 'x');
+  const create = type === 'fast' ? http.createFastServer : http.createServer;
+  const server = create((req, res) => {
+    res.writeHead(200, {
+      'Content-Type': 'text/plain',
+      'Content-Length': body.length
+    });
+    res.end(body);
+  });
+
+  server.listen(common.PORT, () => {
+    bench.http({
+      path: '/',
+      connections: c,
+      duration
+    }, () => {
+      server.close();
+    });
+  });
+}
@@ -6,13 +6,15 @@ const bench = common.createBenchmark(main, {
   connections: [50], // Concurrent connections
   headers: [20], // Number of header lines to append after the common headers
   w: [0, 6], // Amount of trailing whitespace
+  lazy: ['true', 'false'], // Whether the server delivers headers lazily
   duration: 5
 });
 
-function main({ connections, headers, w, duration }) {
-  const server = http.createServer((req, res) => {
-    res.end();
-  });
+function main({ connections, headers: n, w, lazy, duration }) {
+  const server = http.createServer({ lazyHeaders: lazy === 'true' },
+                                   (req, res) => {
+                                     res.end();
+                                   });
 
   server.listen(common.PORT, () => {
     const headers = {
@@ -22,7 +24,7 @@ function main({ connections, headers, w, duration }) {
       'Date': new Date().toString(),
       'Cache-Control': 'no-cache'
     };
-    for (let i = 0; i < headers; i++) {
+    for (let i = 0; i < n; i++) {
       // Note:
       // - autocannon does not send header values with OWS
       // - wrk can only send trailing OWS. This is a side-effect of wrk
@@ -5,10 +5,11 @@ const PORT = common.PORT;
 
 const bench = common.createBenchmark(main, {
   n: [1e3],
-  nheaders: [0, 10, 100, 1000]
+  nheaders: [0, 10, 100, 1000],
+  respond: ['empty', 'headers']
 }, { flags: ['--no-warnings'] });
 
-function main({ n, nheaders }) {
+function main({ n, nheaders, respond }) {
   const http2 = require('http2');
   const server = http2.createServer({
     maxHeaderListPairs: 20000
@@ -28,8 +29,16 @@ function main({ n, nheaders }) {
     headersObject[`foo${i}`] = `some header value ${i}`;
   }
 
+  // With `respond` set to 'headers' the response carries the same header
+  // block, so the client decodes as many headers as the server.
+  const responseHeaders = {};
+  if (respond === 'headers') {
+    for (let i = 0; i < nheaders; i++)
+      responseHeaders[`foo${i}`] = `some header value ${i}`;
+  }
+
   server.on('stream', (stream) => {
-    stream.respond();
+    stream.respond(responseHeaders);
     stream.end('Hi!');
   });
   server.listen(PORT, () => {
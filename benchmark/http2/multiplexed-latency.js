@@ -0,0 +1,77 @@
+// Rate of small sequential requests on a session that is also busy with
+// large downloads, for each stream scheduler.
+'use strict';
+
+const common = require('../common.js');
+const PORT = common.PORT;
+
+const bench = common.createBenchmark(main, {
+  scheduler: ['default', 'weighted', 'urgency', 'small-first'],
+  downloads: [1, 4],
+  n: [500]
+}, { flags: ['--no-warnings'] });
+
+function main({ scheduler, downloads, n }) {
+  const http2 = require('http2');
+  const {
+    STREAM_SCHEDULER_DEFAULT,
+    STREAM_SCHEDULER_WEIGHTED,
+    STREAM_SCHEDULER_URGENCY,
+    STREAM_SCHEDULER_SMALL_FIRST
+  } = http2.constants;
+  const streamScheduler = {
+    'default': STREAM_SCHEDULER_DEFAULT,
+    'weighted': STREAM_SCHEDULER_WEIGHTED,
+    'urgency': STREAM_SCHEDULER_URGENCY,
+    'small-first': STREAM_SCHEDULER_SMALL_FIRST
+  }[scheduler];
+
+  const large = Buffer.alloc(8 * 1024 * 1024);
+  const small = Buffer.alloc(512);
+
+  const server = http2.createServer({ streamScheduler });
+  server.on('stream', (stream, headers) => {
+    const body = headers[':path'] === '/large' ? large : small;
+    stream.respond({ 'content-length': body.length });
+    stream.end(body);
+    stream.on('error', () => {});
+  });
+
+  server.listen(PORT, () => {
+    const client = http2.connect(`http://localhost:${PORT}/`, {
+      settings: { initialWindowSize: 1024 * 1024 }
+    });
+    let done = false;
+
+    // The downloads restart as soon as they finish, so that the small
+    // requests always compete with them.
+    function download() {
+      if (done)
+        return;
+      const req = client.request({ ':path': '/large', 'priority': 'u=5' });
+      req.resume();
+      req.on('end', download);
+      req.on('error', () => {});
+    }
+
+    function request(remaining) {
+      const req = client.request({ ':path': '/small', 'priority': 'u=1' });
+      req.resume();
+      req.on('end', () => {
+        if (remaining > 0) {
+          request(remaining - 1);
+        } else {
+          bench.end(n);
+          done = true;
+          server.close();
+          client.destroy();
+        }
+      });
+    }
+
+    for (let i = 0; i < downloads; i++)
+      download();
+    bench.start();
+    request(n);
+  });
+}
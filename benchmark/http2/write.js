@@ -5,7 +5,7 @@ const common = require('../common.js');
 const bench = common.createBenchmark(main, {
   streams: [100, 200, 1000],
   length: [64 * 1024, 128 * 1024, 256 * 1024, 1024 * 1024],
-  size: [100000],
+  size: [100, 100000],
   benchmarker: ['test-double-http2'],
   duration: 5
 }, { flags: ['--no-warnings'] });
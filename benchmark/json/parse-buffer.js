@@ -0,0 +1,63 @@
+'use strict';
+const common = require('../common.js');
+const { parseJSON } = require('buffer');
+
+const bench = common.createBenchmark(main, {
+  method: ['JSON.parse', 'parseJSON', 'parseJSON-lazy'],
+  payload: ['records', 'numbers', 'strings', 'unicode'],
+  size: [1e3, 1e5],
+  n: [20]
+});
+
+function makePayload(payload, size) {
+  switch (payload) {
+    case 'records':
+      return Array.from({ length: size }, (_, i) => ({
+        id: i,
+        name: `user${i}`,
+        email: `user${i}@example.com`,
+        active: i % 3 !== 0,
+        score: i / 7,
+        tags: ['a', 'b', 'c']
+      }));
+    case 'numbers':
+      return Array.from({ length: size * 4 }, (_, i) => i * 1.25);
+    case 'strings':
+      return Array.from({ length: size / 10 },
+                        (_, i) => `${i}:${'x'.repeat(4096)}`);
+    case 'unicode':
+      return Array.from({ length: size }, (_, i) => ({
+        key: `ключ ${i}`,
+        value: 'значение ☃'
+      }));
+    default:
+      throw new Error(`Unsupported payload ${payload}`);
+  }
+}
+
+function main({ n, method, payload, size }) {
+  const source = Buffer.from(JSON.stringify(makePayload(payload, size)));
+
+  switch (method) {
+    case 'JSON.parse':
+      bench.start();
+      for (let i = 0; i < n; i++)
+        JSON.parse(source.toString());
+      bench.end(n);
+      break;
+    case 'parseJSON':
+      bench.start();
+      for (let i = 0; i < n; i++)
+        parseJSON(source);
+      bench.end(n);
+      break;
+    case 'parseJSON-lazy':
+      bench.start();
+      for (let i = 0; i < n; i++)
+        parseJSON(source, { lazyStringThreshold: 1024 });
+      bench.end(n);
+      break;
+    default:
+      throw new Error(`Unsupported method ${method}`);
+  }
+}
@@ -0,0 +1,43 @@
+// Rate at which a server accepts connections that arrive in bursts, with and
+// without accept batching.
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  batching: ['true', 'false'],
+  concurrency: [10, 100],
+  n: [2e4]
+});
+
+function main({ batching, concurrency, n }) {
+  const server = net.createServer({ acceptBatching: batching === 'true' },
+                                  (socket) => socket.destroy());
+
+  let started = 0;
+  let done = 0;
+
+  server.listen(common.PORT, '127.0.0.1', () => {
+    bench.start();
+    for (let i = 0; i < concurrency; i++)
+      connect();
+  });
+
+  function connect() {
+    if (started === n)
+      return;
+    started++;
+    const socket = net.connect(common.PORT, '127.0.0.1');
+    socket.on('error', () => {});
+    socket.on('close', () => {
+      if (++done === n) {
+        bench.end(n);
+        server.close();
+      } else {
+        connect();
+      }
+    });
+    socket.resume();
+  }
+}
@@ -0,0 +1,58 @@
+// Request rate of a ping-pong connection with an idle timeout, while the
+// server holds many other idle connections with an idle timeout.
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  idle: [0, 1000],
+  timeout: ['true', 'false'],
+  len: [64],
+  dur: [5]
+});
+
+function main({ idle, timeout, len, dur }) {
+  const chunk = Buffer.alloc(len, 'x');
+  const msecs = timeout === 'true' ? 60000 : 0;
+  let requests = 0;
+
+  const server = net.createServer((socket) => {
+    socket.setTimeout(msecs);
+    socket.on('data', (data) => socket.write(data));
+  });
+
+  server.listen(common.PORT, () => {
+    let connected = 0;
+    for (let i = 0; i < idle; i++)
+      net.connect(common.PORT, onIdleConnect).setTimeout(msecs);
+    if (idle === 0)
+      run();
+
+    function onIdleConnect() {
+      if (++connected === idle)
+        run();
+    }
+  });
+
+  function run() {
+    const client = net.connect(common.PORT, () => {
+      client.setTimeout(msecs);
+      bench.start();
+      client.write(chunk);
+      setTimeout(() => {
+        bench.end(requests);
+        process.exit(0);
+      }, dur * 1000);
+    });
+    let received = 0;
+    client.on('data', (data) => {
+      received += data.length;
+      if (received >= len) {
+        received -= len;
+        requests++;
+        client.write(chunk);
+      }
+    });
+  }
+}
@@ -0,0 +1,55 @@
+// Round-trip latency of small messages sent through a TCP proxy that forwards
+// data in both directions, either with socket.pipe() or natively with
+// socket.pipeNative().
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  mode: ['pipe', 'native'],
+  len: [64, 4096],
+  n: [1e4]
+});
+
+function main({ mode, len, n }) {
+  const message = Buffer.alloc(len, 'x');
+
+  const backend = net.createServer((socket) => {
+    socket.pipe(socket);
+  });
+
+  const proxy = net.createServer({ allowHalfOpen: true }, (client) => {
+    const upstream = net.connect({
+      port: backend.address().port,
+      allowHalfOpen: true
+    });
+    if (mode === 'native') {
+      client.pipeNative(upstream);
+      upstream.pipeNative(client);
+    } else {
+      client.pipe(upstream);
+      upstream.pipe(client);
+    }
+  });
+
+  backend.listen(0, () => proxy.listen(common.PORT, () => {
+    const client = net.connect(common.PORT, () => {
+      let roundtrips = 0;
+      let received = 0;
+      client.on('data', (data) => {
+        received += data.length;
+        if (received < len)
+          return;
+        received = 0;
+        if (++roundtrips === n) {
+          bench.end(n);
+          process.exit(0);
+        }
+        client.write(message);
+      });
+      bench.start();
+      client.write(message);
+    });
+  }));
+}
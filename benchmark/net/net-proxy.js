@@ -0,0 +1,69 @@
+// Throughput of a TCP proxy that forwards a client's data to a sink, either
+// with socket.pipe(), with `onread` and a pool of read buffers that are
+// recycled once their contents have been written upstream, or natively with
+// socket.pipeNative().
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  mode: ['pipe', 'onread', 'native'],
+  len: [1024, 64 * 1024],
+  recvbuflen: [64 * 1024],
+  dur: [5]
+});
+
+function main({ mode, len, recvbuflen, dur }) {
+  const chunk = Buffer.alloc(len, 'x');
+  let received = 0;
+
+  const sink = net.createServer((socket) => {
+    socket.on('data', (data) => received += data.length);
+  });
+
+  const pool = [];
+  const onread = {
+    buffer() {
+      return pool.pop() || Buffer.allocUnsafe(recvbuflen);
+    },
+    callback(nread, buf) {
+      const upstream = this.upstream;
+      const written = upstream.write(buf.subarray(0, nread), () => {
+        pool.push(buf);
+      });
+      if (!written)
+        upstream.once('drain', () => this.resume());
+      return written;
+    }
+  };
+
+  const proxy = net.createServer({
+    onread: mode === 'onread' ? onread : undefined
+  }, (socket) => {
+    const upstream = net.connect(sink.address().port);
+    if (mode === 'onread')
+      socket.upstream = upstream;
+    else if (mode === 'native')
+      socket.pipeNative(upstream);
+    else
+      socket.pipe(upstream);
+  });
+
+  sink.listen(0, () => proxy.listen(common.PORT, () => {
+    const client = net.connect(common.PORT, () => {
+      bench.start();
+      write();
+      setTimeout(() => {
+        const gbits = (received * 8) / (1024 * 1024 * 1024);
+        bench.end(gbits);
+        process.exit(0);
+      }, dur * 1000);
+    });
+
+    function write() {
+      while (client.write(chunk));
+      client.once('drain', write);
+    }
+  }));
+}
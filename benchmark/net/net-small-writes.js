@@ -0,0 +1,48 @@
+// Throughput of a client that performs many small writes in a row, with and
+// without write coalescing.
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  coalesce: ['true', 'false'],
+  len: [16, 128, 1024],
+  writes: [64],
+  dur: [5]
+});
+
+function main({ coalesce, len, writes, dur }) {
+  const chunk = Buffer.alloc(len, 'x');
+  let received = 0;
+
+  const server = net.createServer((socket) => {
+    socket.on('data', (data) => received += data.length);
+  });
+
+  server.listen(common.PORT, () => {
+    const client = net.connect(common.PORT);
+    client.setWriteCoalescing(coalesce === 'true');
+    client.on('connect', () => {
+      bench.start();
+      write();
+      setTimeout(() => {
+        const gbits = (received * 8) / (1024 * 1024 * 1024);
+        bench.end(gbits);
+        process.exit(0);
+      }, dur * 1000);
+    });
+
+    function write() {
+      // Yield to the event loop after each batch so that the coalesced data
+      // is flushed, as it would be by a server answering many requests.
+      let ok = true;
+      for (let i = 0; i < writes; i++)
+        ok = client.write(chunk);
+      if (ok)
+        setImmediate(write);
+      else
+        client.once('drain', write);
+    }
+  });
+}
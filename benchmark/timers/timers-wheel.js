@@ -0,0 +1,45 @@
+// Compares the timer lists with the native timer wheel that is used for the
+// idle timeouts of sockets with --experimental-timer-wheel. Each of the `n`
+// timeouts gets a distinct duration, like sockets with different idle and
+// keep-alive timeouts.
+'use strict';
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  type: ['lists', 'wheel'],
+  op: ['insert', 'refresh', 'cancel'],
+  n: [1e6]
+}, { flags: ['--expose-internals'] });
+
+function cb() {}
+
+function main({ type, op, n }) {
+  const {
+    setUnrefTimeout,
+    setUnrefWheelTimeout
+  } = require('internal/timers');
+  const { clearTimeout } = require('timers');
+  const create = type === 'wheel' ? setUnrefWheelTimeout : setUnrefTimeout;
+  const timeouts = new Array(n);
+
+  if (op === 'insert')
+    bench.start();
+  for (let i = 0; i < n; i++)
+    timeouts[i] = create(cb, 60000 + i);
+
+  if (op === 'refresh') {
+    bench.start();
+    for (let i = 0; i < n; i++)
+      timeouts[i].refresh();
+  } else if (op === 'cancel') {
+    bench.start();
+    for (let i = 0; i < n; i++)
+      clearTimeout(timeouts[i]);
+  }
+  bench.end(n);
+
+  if (op !== 'cancel') {
+    for (let i = 0; i < n; i++)
+      clearTimeout(timeouts[i]);
+  }
+}
@@ -0,0 +1,58 @@
+// Time from a request to the first readable bytes of its response on a new
+// connection, with and without dynamic record sizing. The rate is in first
+// bytes per second, leaving out the time spent on handshakes.
+'use strict';
+const common = require('../common.js');
+const fixtures = require('../../test/common/fixtures');
+const tls = require('tls');
+
+const bench = common.createBenchmark(main, {
+  dynamicRecordSizing: ['false', 'true'],
+  size: [16 * 1024, 1024 * 1024],
+  n: [100]
+});
+
+function main({ dynamicRecordSizing, size, n }) {
+  const options = {
+    key: fixtures.readKey('rsa_private.pem'),
+    cert: fixtures.readKey('rsa_cert.crt'),
+    ca: fixtures.readKey('rsa_ca.crt'),
+    ciphers: 'AES256-GCM-SHA384',
+    dynamicRecordSizing: dynamicRecordSizing === 'true'
+  };
+  const response = Buffer.alloc(size, 'r');
+
+  const server = tls.createServer(options, (conn) => {
+    conn.once('data', () => conn.end(response));
+  });
+
+  let remaining = n;
+  let total = 0n;
+
+  function request() {
+    const conn = tls.connect({
+      port: common.PORT,
+      rejectUnauthorized: false
+    }, () => {
+      const start = process.hrtime.bigint();
+      let received = 0;
+      conn.on('data', (chunk) => {
+        if (received === 0)
+          total += process.hrtime.bigint() - start;
+        received += chunk.length;
+      });
+      conn.on('end', () => {
+        conn.destroy();
+        if (--remaining > 0)
+          return request();
+        const elapsed = Number(total) / 1e9;
+        bench.report(n / elapsed,
+                     [Math.floor(elapsed), (elapsed % 1) * 1e9]);
+        server.close();
+      });
+      conn.write('?');
+    });
+  }
+
+  server.listen(common.PORT, request);
+}
@@ -0,0 +1,95 @@
+// Resumed handshakes per second against TLS servers in several worker
+// threads, with each connection going to a different thread than the one
+// that created the session.
+'use strict';
+
+const fixtures = require('../../test/common/fixtures');
+const tls = require('tls');
+const { Worker, isMainThread, parentPort, workerData } =
+  require('worker_threads');
+
+if (!isMainThread) {
+  const options = {
+    key: fixtures.readKey('rsa_private.pem'),
+    cert: fixtures.readKey('rsa_cert.crt'),
+    maxVersion: workerData.version
+  };
+  if (workerData.sharedCache)
+    options.sessionCache = { name: 'benchmark' };
+  const server = tls.createServer(options, (socket) => socket.end());
+  server.listen(0, '127.0.0.1', () => {
+    parentPort.postMessage(server.address().port);
+  });
+  parentPort.on('close', () => server.close());
+} else {
+  const common = require('../common.js');
+  const bench = common.createBenchmark(main, {
+    sharedCache: ['true', 'false'],
+    version: ['TLSv1.3', 'TLSv1.2'],
+    workers: [4],
+    concurrency: [10],
+    n: [5e3]
+  });
+
+  function main({ sharedCache, version, workers, concurrency, n }) {
+    const ports = [];
+    const threads = [];
+    for (let i = 0; i < workers; i++) {
+      const worker = new Worker(__filename, {
+        workerData: { sharedCache: sharedCache === 'true', version }
+      });
+      worker.on('message', (port) => {
+        ports.push(port);
+        if (ports.length === workers)
+          start();
+      });
+      threads.push(worker);
+    }
+
+    let started = 0;
+    let finished = 0;
+    let resumed = 0;
+
+    function start() {
+      // Create the first session outside of the measurement.
+      connect(0, undefined, (session) => {
+        bench.start();
+        for (let i = 0; i < concurrency; i++)
+          next(session);
+      });
+    }
+
+    function next(session) {
+      if (started === n)
+        return;
+      connect(++started % workers, session, (newSession) => {
+        if (++finished === n) {
+          bench.end(n);
+          if (resumed < n)
+            console.error(`${n - resumed} of ${n} handshakes were full`);
+          for (const worker of threads)
+            worker.terminate();
+          return;
+        }
+        next(newSession);
+      });
+    }
+
+    function connect(index, session, cb) {
+      let newSession = session;
+      const socket = tls.connect({
+        port: ports[index],
+        host: '127.0.0.1',
+        rejectUnauthorized: false,
+        session
+      });
+      socket.on('session', (s) => { newSession = s; });
+      socket.on('secureConnect', () => {
+        if (socket.isSessionReused())
+          resumed++;
+      });
+      socket.resume();
+      socket.on('close', () => cb(newSession));
+    }
+  }
+}
@@ -2,6 +2,8 @@
 const common = require('../common.js');
 const bench = common.createBenchmark(main, {
   dur: [5],
+  dynamicRecordSizing: ['false', 'true'],
+  kernelTLS: ['false', 'true'],
   type: ['buf', 'asc', 'utf'],
   size: [100, 1024, 1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024]
 });
@@ -10,7 +12,7 @@ const fixtures = require('../../test/common/fixtures');
 var options;
 const tls = require('tls');
 
-function main({ dur, type, size }) {
+function main({ dur, dynamicRecordSizing, kernelTLS, type, size }) {
   var encoding;
   var chunk;
   switch (type) {
@@ -39,7 +41,12 @@ function main({ dur, type, size }) {
   const server = tls.createServer(options, onConnection);
   var conn;
   server.listen(common.PORT, () => {
-    const opt = { port: common.PORT, rejectUnauthorized: false };
+    const opt = {
+      port: common.PORT,
+      rejectUnauthorized: false,
+      dynamicRecordSizing: dynamicRecordSizing === 'true',
+      kernelTLS: kernelTLS === 'true'
+    };
     conn = tls.connect(opt, () => {
       setTimeout(done, dur * 1000);
       bench.start();
@@ -0,0 +1,84 @@
+// Compares accepting connections on one thread and handing them to worker
+// threads with the round-robin handle passing of cluster processes.
+'use strict';
+
+const cluster = require('cluster');
+const net = require('net');
+const { Worker, isMainThread, parentPort } = require('worker_threads');
+
+function serve(socket) {
+  socket.on('data', (data) => socket.end(data));
+}
+
+if (!isMainThread) {
+  parentPort.on('message', (handle) => {
+    serve(new net.Socket({ handle }));
+  });
+} else if (cluster.isWorker) {
+  net.createServer(serve).listen(require('../common.js').PORT, '127.0.0.1');
+  process.on('disconnect', () => process.exit());
+} else {
+  const common = require('../common.js');
+  const bench = common.createBenchmark(main, {
+    // Network handles cannot be transferred to threads on Windows.
+    mode: process.platform === 'win32' ? ['cluster'] : ['worker', 'cluster'],
+    workers: [2, 4],
+    concurrency: [50],
+    n: [1e4]
+  });
+
+  function main({ mode, workers, concurrency, n }) {
+    let finish;
+    if (mode === 'worker') {
+      const threads = [];
+      for (let i = 0; i < workers; i++)
+        threads.push(new Worker(__filename));
+      let next = 0;
+      const server = net.createServer({ pauseOnConnect: true }, (socket) => {
+        threads[next++ % workers].postMessage(socket, [socket]);
+      });
+      server.listen(common.PORT, '127.0.0.1', run);
+      finish = () => {
+        server.close();
+        for (const thread of threads)
+          thread.terminate();
+      };
+    } else {
+      cluster.schedulingPolicy = cluster.SCHED_RR;
+      let listening = 0;
+      for (let i = 0; i < workers; i++) {
+        cluster.fork().on('listening', () => {
+          if (++listening === workers)
+            run();
+        });
+      }
+      finish = () => cluster.disconnect();
+    }
+
+    let started = 0;
+    let done = 0;
+
+    function run() {
+      bench.start();
+      for (let i = 0; i < concurrency; i++)
+        connect();
+    }
+
+    function connect() {
+      if (started === n)
+        return;
+      started++;
+      const socket = net.connect(common.PORT, '127.0.0.1');
+      socket.on('close', () => {
+        if (++done === n) {
+          bench.end(n);
+          finish();
+        } else {
+          connect();
+        }
+      });
+      socket.end('ping');
+      socket.resume();
+    }
+  }
+}
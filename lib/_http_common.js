@@ -22,6 +22,7 @@
 'use strict';
 
 const {
+  ArrayIsArray,
   MathMin,
   Symbol,
 } = primordials;
@@ -36,7 +37,8 @@ const incoming = require('_http_incoming');
 const {
   IncomingMessage,
   readStart,
-  readStop
+  readStop,
+  setHeaderList
 } = incoming;
 
 const debug = require('internal/util/debuglog').debuglog('http');
@@ -96,13 +98,18 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
   incoming.url = url;
   incoming.upgrade = upgrade;
 
-  let n = headers.length;
+  // `headers` is a native HeaderList if the parser delivers headers lazily.
+  const lazy = !ArrayIsArray(headers);
+  let n = lazy ? headers.count() * 2 : headers.length;
 
   // If parser.maxHeaderPairs <= 0 assume that there's no limit.
   if (parser.maxHeaderPairs > 0)
     n = MathMin(n, parser.maxHeaderPairs);
 
-  incoming._addHeaderLines(headers, n);
+  if (lazy)
+    setHeaderList(incoming, headers, n);
+  else
+    incoming._addHeaderLines(headers, n);
 
   if (typeof method === 'number') {
     // server only
@@ -22,12 +22,18 @@
 'use strict';
 
 const {
+  ObjectDefineProperties,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
+  Symbol,
 } = primordials;
 
 const Stream = require('stream');
 
+const kHeaderList = Symbol('kHeaderList');
+const kHeadersCount = Symbol('kHeadersCount');
+const kLazyHeaders = Symbol('kLazyHeaders');
+
 function readStart(socket) {
   if (socket && !socket._paused && socket.readable)
     socket.resume();
@@ -143,6 +149,79 @@ function _addHeaderLines(headers, n) {
 }
 
 
+// Used instead of _addHeaderLines() when the parser delivers headers lazily.
+// `headers` and `rawHeaders` become accessors on `msg` that create them from
+// the native HeaderList `list` the first time they are read, and then turn
+// back into data properties. `n` limits the number of headers like in
+// _addHeaderLines().
+function setHeaderList(msg, list, n) {
+  msg[kHeaderList] = list;
+  msg[kHeadersCount] = n;
+  msg[kLazyHeaders] = true;
+  ObjectDefineProperties(msg, lazyHeaderProperties);
+}
+
+const lazyHeaderProperties = {
+  headers: {
+    configurable: true,
+    enumerable: true,
+    get() {
+      const headers = {};
+      const src = this.rawHeaders;
+      const n = this[kHeadersCount];
+      for (let i = 0; i < n; i += 2)
+        _addHeaderLine(src[i], src[i + 1], headers);
+      setHeadersData(this, 'headers', headers);
+      return headers;
+    },
+    set(val) {
+      setHeadersData(this, 'headers', val);
+    }
+  },
+  rawHeaders: {
+    configurable: true,
+    enumerable: true,
+    get() {
+      const rawHeaders = this[kHeaderList].toArray();
+      setHeadersData(this, 'rawHeaders', rawHeaders);
+      return rawHeaders;
+    },
+    set(val) {
+      setHeadersData(this, 'rawHeaders', val);
+    }
+  }
+};
+
+function setHeadersData(msg, name, value) {
+  ObjectDefineProperty(msg, name, {
+    configurable: true,
+    enumerable: true,
+    writable: true,
+    value
+  });
+  if (name === 'headers')
+    msg[kLazyHeaders] = false;
+}
+
+// Same as `msg.headers[name.toLowerCase()]`, but if the headers of `msg` are
+// still in a native HeaderList, only strings for the matching headers are
+// created.
+function getIncomingHeader(msg, name) {
+  if (msg[kLazyHeaders] !== true)
+    return msg.headers[name.toLowerCase()];
+
+  const list = msg[kHeaderList];
+  const dest = {};
+  const n = msg[kHeadersCount];
+  for (let i = list.find(name, 0);
+    i !== -1 && i * 2 < n;
+    i = list.find(name, i + 1)) {
+    _addHeaderLine(list.field(i), list.value(i), dest);
+  }
+  return dest[name.toLowerCase()];
+}
+
+
 // This function is used to help avoid the lowercasing of a field name if it
 // matches a 'traditional cased' version of a field name. It then returns the
 // lowercased name to both avoid calling toLowerCase() a second time and to
@@ -300,5 +379,7 @@ IncomingMessage.prototype._dump = function _dump() {
 module.exports = {
   IncomingMessage,
   readStart,
-  readStop
+  readStop,
+  getIncomingHeader,
+  setHeaderList
 };
@@ -29,6 +29,7 @@ const {
   ObjectPrototypeHasOwnProperty,
   ObjectSetPrototypeOf,
   Symbol,
+  Uint32Array,
 } = primordials;
 
 const { getDefaultHighWaterMark } = require('internal/streams/state');
@@ -61,12 +62,30 @@ const {
   hideStackFrames
 } = require('internal/errors');
 const { validateString } = require('internal/validators');
+const {
+  serializeHeaders,
+  kHeaderSourceOutHeaders,
+  kHeaderSourceEntries,
+  kHeaderSourceObject,
+  kHeaderConnection,
+  kHeaderConnectionClose,
+  kHeaderConnectionKeepAlive,
+  kHeaderTransferEncoding,
+  kHeaderChunked,
+  kHeaderContentLength,
+  kHeaderDate,
+  kHeaderExpect,
+  kHeaderTrailer
+} = internalBinding('http_parser');
 
 const HIGH_WATER_MARK = getDefaultHighWaterMark();
 const { CRLF, debug } = common;
 
 const kCorked = Symbol('corked');
 
+// Receives the kHeader* flags of the headers that serializeHeaders() saw.
+const headerFlags = new Uint32Array(1);
+
 const RE_CONN_CLOSE = /(?:^|\W)close(?:$|\W)/i;
 const RE_TE_CHUNKED = common.chunkExpression;
 
@@ -343,7 +362,13 @@ function _writeRaw(data, encoding, callback) {
   if (conn && conn._httpMessage === this && conn.writable) {
     // There might be pending data in the this.output buffer.
     if (this.outputData.length) {
+      // Cork so that the pending data, usually the head, and this chunk
+      // reach the socket with a single writev.
+      conn.cork();
       this._flushOutput(conn);
+      const ret = conn.write(data, encoding, callback);
+      conn.uncork();
+      return ret;
     }
     // Directly write to socket.
     return conn.write(data, encoding, callback);
@@ -371,12 +396,26 @@ function _storeHeader(firstLine, headers) {
   };
 
   if (headers) {
-    if (headers === this[kOutHeaders]) {
+    let source;
+    if (headers === this[kOutHeaders])
+      source = kHeaderSourceOutHeaders;
+    else if (ArrayIsArray(headers))
+      source = kHeaderSourceEntries;
+    else
+      source = kHeaderSourceObject;
+    // The headers are validated and serialized natively. If that is not
+    // possible, e.g. because a header is invalid, the JS implementation
+    // below takes over and throws the appropriate error.
+    const lines = serializeHeaders(headers, source, headerFlags);
+    if (lines !== undefined) {
+      state.header += lines;
+      applyHeaderFlags(this, state, headerFlags[0]);
+    } else if (source === kHeaderSourceOutHeaders) {
       for (const key in headers) {
         const entry = headers[key];
         processHeader(this, state, entry[0], entry[1], false);
       }
-    } else if (ArrayIsArray(headers)) {
+    } else if (source === kHeaderSourceEntries) {
       for (const entry of headers) {
         processHeader(this, state, entry[0], entry[1], true);
       }
@@ -490,6 +529,35 @@ function storeHeader(self, state, key, value, validate) {
   matchHeader(self, state, key, value);
 }
 
+// Same as calling matchHeader() for each header that serializeHeaders()
+// has seen.
+function applyHeaderFlags(self, state, flags) {
+  if (flags & kHeaderConnection) {
+    state.connection = true;
+    self._removedConnection = false;
+    if (flags & kHeaderConnectionClose)
+      self._last = true;
+    if (flags & kHeaderConnectionKeepAlive)
+      self.shouldKeepAlive = true;
+  }
+  if (flags & kHeaderTransferEncoding) {
+    state.te = true;
+    self._removedTE = false;
+    if (flags & kHeaderChunked)
+      self.chunkedEncoding = true;
+  }
+  if (flags & kHeaderContentLength) {
+    state.contLen = true;
+    self._removedContLen = false;
+  }
+  if (flags & kHeaderDate)
+    state.date = true;
+  if (flags & kHeaderExpect)
+    state.expect = true;
+  if (flags & kHeaderTrailer)
+    state.trailer = true;
+}
+
 function matchHeader(self, state, field, value) {
   if (field.length < 4 || field.length > 17)
     return;
@@ -918,5 +986,7 @@ function(err, event) {
 };
 
 module.exports = {
-  OutgoingMessage
+  OutgoingMessage,
+  validateHeaderName,
+  validateHeaderValue
 };
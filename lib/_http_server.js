@@ -56,7 +56,10 @@ const {
   defaultTriggerAsyncIdScope,
   getOrSetAsyncId
 } = require('internal/async_hooks');
-const { IncomingMessage } = require('_http_incoming');
+const {
+  IncomingMessage,
+  getIncomingHeader
+} = require('_http_incoming');
 const {
   ERR_HTTP_HEADERS_SENT,
   ERR_HTTP_INVALID_STATUS_CODE,
@@ -343,6 +346,12 @@ function Server(options, requestListener) {
   }
   this.insecureHTTPParser = insecureHTTPParser;
 
+  const lazyHeaders = options.lazyHeaders;
+  if (lazyHeaders !== undefined && typeof lazyHeaders !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE('lazyHeaders', 'boolean', lazyHeaders);
+  }
+  this.lazyHeaders = lazyHeaders === true;
+
   net.Server.call(this, { allowHalfOpen: true });
 
   if (requestListener) {
@@ -426,6 +435,7 @@ function connectionListenerInternal(server, socket) {
     server.maxHeaderSize || 0,
     server.insecureHTTPParser === undefined ?
       isLenient() : server.insecureHTTPParser,
+    server.lazyHeaders,
   );
   parser.socket = socket;
 
@@ -768,9 +778,10 @@ function parserOnIncoming(server, socket, state, req, keepAlive) {
   res.on('finish',
          resOnFinish.bind(undefined, req, res, socket, state, server));
 
-  if (req.headers.expect !== undefined &&
+  const expect = getIncomingHeader(req, 'expect');
+  if (expect !== undefined &&
       (req.httpVersionMajor === 1 && req.httpVersionMinor === 1)) {
-    if (continueExpression.test(req.headers.expect)) {
+    if (continueExpression.test(expect)) {
       res._expect_continue = true;
 
       if (server.listenerCount('checkContinue') > 0) {
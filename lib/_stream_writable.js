@@ -40,7 +40,7 @@ Writable.WritableState = WritableState;
 
 const EE = require('events');
 const Stream = require('stream');
-const { Buffer } = require('buffer');
+const { Buffer, BufferChain } = require('buffer');
 const destroyImpl = require('internal/streams/destroy');
 const {
   getHighWaterMark,
@@ -272,6 +272,7 @@ Writable.prototype.write = function(chunk, encoding, cb) {
       cb = nop;
   }
 
+  let isBufferChain = false;
   if (chunk === null) {
     throw new ERR_STREAM_NULL_VALUES();
   } else if (!state.objectMode) {
@@ -285,6 +286,8 @@ Writable.prototype.write = function(chunk, encoding, cb) {
     } else if (Stream._isUint8Array(chunk)) {
       chunk = Stream._uint8ArrayToBuffer(chunk);
       encoding = 'buffer';
+    } else if (chunk instanceof BufferChain) {
+      isBufferChain = true;
     } else {
       throw new ERR_INVALID_ARG_TYPE(
         'chunk', ['string', 'Buffer', 'Uint8Array'], chunk);
@@ -302,12 +305,30 @@ Writable.prototype.write = function(chunk, encoding, cb) {
     process.nextTick(cb, err);
     errorOrDestroy(this, err, true);
     return false;
+  } else if (isBufferChain) {
+    return writeBufferChain(this, chunk, cb);
   } else {
     state.pendingcb++;
     return writeOrBuffer(this, state, chunk, encoding, cb);
   }
 };
 
+// Writes the elements of a BufferChain as separate chunks while corked, so
+// that streams implementing _writev() receive all of them in a single call
+// instead of one flattened copy.
+function writeBufferChain(stream, list, cb) {
+  const chunks = list.toArray();
+  if (chunks.length === 0)
+    return stream.write(Buffer.alloc(0), cb);
+
+  stream.cork();
+  for (let i = 0; i < chunks.length - 1; i++)
+    stream.write(chunks[i]);
+  const ret = stream.write(chunks[chunks.length - 1], cb);
+  stream.uncork();
+  return ret;
+}
+
 Writable.prototype.cork = function() {
   this._writableState.corked++;
 };
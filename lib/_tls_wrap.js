@@ -72,6 +72,7 @@ const {
 const { onpskexchange: kOnPskExchange } = internalBinding('symbols');
 const { getOptionValue } = require('internal/options');
 const {
+  validateObject,
   validateString,
   validateBuffer,
   validateUint32
@@ -86,8 +87,11 @@ const kHandshakeTimeout = Symbol('handshake-timeout');
 const kRes = Symbol('res');
 const kSNICallback = Symbol('snicallback');
 const kEnableTrace = Symbol('enableTrace');
+const kDynamicRecordSizing = Symbol('dynamicRecordSizing');
+const kKernelTLS = Symbol('kernelTLS');
 const kPskCallback = Symbol('pskcallback');
 const kPskIdentityHint = Symbol('pskidentityhint');
+const kOnRead = Symbol('onread');
 
 const noop = () => {};
 
@@ -456,6 +460,18 @@ function TLSSocket(socket, opts) {
       'options.enableTrace', 'boolean', enableTrace);
   }
 
+  const dynamicRecordSizing = tlsOptions.dynamicRecordSizing;
+  if (dynamicRecordSizing !== undefined &&
+      typeof dynamicRecordSizing !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE(
+      'options.dynamicRecordSizing', 'boolean', dynamicRecordSizing);
+  }
+
+  const kernelTLS = tlsOptions.kernelTLS;
+  if (kernelTLS !== undefined && typeof kernelTLS !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE('options.kernelTLS', 'boolean', kernelTLS);
+  }
+
   if (tlsOptions.ALPNProtocols)
     tls.convertALPNProtocols(tlsOptions.ALPNProtocols, tlsOptions);
 
@@ -494,6 +510,7 @@ function TLSSocket(socket, opts) {
     handle: this._wrapHandle(wrap),
     allowHalfOpen: socket ? socket.allowHalfOpen : tlsOptions.allowHalfOpen,
     pauseOnCreate: tlsOptions.pauseOnConnect,
+    onread: tlsOptions.onread,
     manualStart: true
   });
 
@@ -507,6 +524,12 @@ function TLSSocket(socket, opts) {
   if (enableTrace && this._handle)
     this._handle.enableTrace();
 
+  if (dynamicRecordSizing && this._handle)
+    this._handle.enableDynamicRecordSizing();
+
+  if (kernelTLS && this._handle)
+    this._handle.enableKernelTLS();
+
   // Read on next tick so the caller has a chance to setup listeners
   process.nextTick(initRead, this, socket);
 }
@@ -1003,6 +1026,7 @@ function makeSocketMethodProxy(name) {
   'getSession',
   'getTLSTicket',
   'isSessionReused',
+  'isKernelTLS',
   'enableTrace',
 ].forEach((method) => {
   TLSSocket.prototype[method] = makeSocketMethodProxy(method);
@@ -1063,9 +1087,12 @@ function tlsConnectionListener(rawSocket) {
     ALPNProtocols: this.ALPNProtocols,
     SNICallback: this[kSNICallback] || SNICallback,
     enableTrace: this[kEnableTrace],
+    dynamicRecordSizing: this[kDynamicRecordSizing],
+    kernelTLS: this[kKernelTLS],
     pauseOnConnect: this.pauseOnConnect,
     pskCallback: this[kPskCallback],
     pskIdentityHint: this[kPskIdentityHint],
+    onread: this[kOnRead],
   });
 
   socket.on('secure', onServerSocketSecure);
@@ -1123,6 +1150,7 @@ function tlsConnectionListener(rawSocket) {
 // - clientCertEngine: string.
 // - ca: string or array of strings.
 // - sessionTimeout: integer.
+// - sessionCache: { name, maxSize, ticketKeyRotation }.
 //
 // emit 'secureConnection'
 //   function (tlsSocket) { }
@@ -1163,6 +1191,19 @@ function Server(options, listener) {
   if (options.ticketKeys)
     this.ticketKeys = options.ticketKeys;
 
+  if (options.sessionCache !== undefined) {
+    validateObject(options.sessionCache, 'options.sessionCache');
+    const {
+      name,
+      maxSize = 20480,
+      ticketKeyRotation = 3600
+    } = options.sessionCache;
+    validateString(name, 'options.sessionCache.name');
+    validateUint32(maxSize, 'options.sessionCache.maxSize', true);
+    validateUint32(ticketKeyRotation, 'options.sessionCache.ticketKeyRotation');
+    this.sessionCache = { name, maxSize, ticketKeyRotation };
+  }
+
   if (options.ALPNProtocols)
     tls.convertALPNProtocols(options.ALPNProtocols, this);
 
@@ -1187,6 +1228,16 @@ function Server(options, listener) {
     throw new ERR_INVALID_ARG_TYPE(
       'options.pskCallback', 'function', options.pskCallback);
   }
+  if (options.dynamicRecordSizing !== undefined &&
+      typeof options.dynamicRecordSizing !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE(
+      'options.dynamicRecordSizing', 'boolean', options.dynamicRecordSizing);
+  }
+  if (options.kernelTLS !== undefined &&
+      typeof options.kernelTLS !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE(
+      'options.kernelTLS', 'boolean', options.kernelTLS);
+  }
   if (this[kPskIdentityHint] && typeof this[kPskIdentityHint] !== 'string') {
     throw new ERR_INVALID_ARG_TYPE(
       'options.pskIdentityHint',
@@ -1196,13 +1247,19 @@ function Server(options, listener) {
   }
 
   // constructor call
-  net.Server.call(this, options, tlsConnectionListener);
+  // `onread` applies to the cleartext side of the TLS sockets, not to the
+  // raw sockets they wrap.
+  net.Server.call(this, { ...options, onread: undefined },
+                  tlsConnectionListener);
+  this[kOnRead] = options.onread;
 
   if (listener) {
     this.on('secureConnection', listener);
   }
 
   this[kEnableTrace] = options.enableTrace;
+  this[kDynamicRecordSizing] = options.dynamicRecordSizing;
+  this[kKernelTLS] = options.kernelTLS;
 }
 
 ObjectSetPrototypeOf(Server.prototype, net.Server.prototype);
@@ -1325,6 +1382,11 @@ Server.prototype.setSecureContext = function(options) {
   if (this.sessionTimeout)
     this._sharedCreds.context.setSessionTimeout(this.sessionTimeout);
 
+  if (this.sessionCache) {
+    const { name, maxSize, ticketKeyRotation } = this.sessionCache;
+    this._sharedCreds.context.setSessionCache(name, maxSize, ticketKeyRotation);
+  }
+
   if (options.ticketKeys) {
     this.ticketKeys = options.ticketKeys;
     this.setTicketKeys(this.ticketKeys);
@@ -1581,7 +1643,10 @@ exports.connect = function connect(...args) {
     ALPNProtocols: options.ALPNProtocols,
     requestOCSP: options.requestOCSP,
     enableTrace: options.enableTrace,
+    dynamicRecordSizing: options.dynamicRecordSizing,
+    kernelTLS: options.kernelTLS,
     pskCallback: options.pskCallback,
+    onread: options.onread,
   });
 
   tlssock[kConnectOptions] = options;
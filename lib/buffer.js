@@ -37,6 +37,7 @@ const {
   ObjectGetOwnPropertyDescriptor,
   ObjectGetPrototypeOf,
   ObjectSetPrototypeOf,
+  Symbol,
   SymbolSpecies,
   SymbolToPrimitive,
   Uint8ArrayPrototype,
@@ -46,11 +47,13 @@ const {
   byteLengthUtf8,
   compare: _compare,
   compareOffset,
+  concat: _concat,
   createFromString,
   fill: bindingFill,
   indexOfBuffer,
   indexOfNumber,
   indexOfString,
+  sortKeys: _sortKeys,
   swap16: _swap16,
   swap32: _swap32,
   swap64: _swap64,
@@ -74,7 +77,8 @@ const {
 const {
   isAnyArrayBuffer,
   isArrayBufferView,
-  isUint8Array
+  isUint8Array,
+  isUint32Array
 } = require('internal/util/types');
 const {
   inspect: utilInspect
@@ -96,7 +100,10 @@ const {
 } = require('internal/errors');
 const {
   validateInt32,
-  validateString
+  validateInteger,
+  validateObject,
+  validateString,
+  validateUint32
 } = require('internal/validators');
 
 const {
@@ -540,7 +547,6 @@ Buffer.isEncoding = function isEncoding(encoding) {
 Buffer[kIsEncodingSymbol] = Buffer.isEncoding;
 
 Buffer.concat = function concat(list, length) {
-  let i;
   if (!ArrayIsArray(list)) {
     throw new ERR_INVALID_ARG_TYPE('list', 'Array', list);
   }
@@ -548,39 +554,19 @@ Buffer.concat = function concat(list, length) {
   if (list.length === 0)
     return new FastBuffer();
 
-  if (length === undefined) {
-    length = 0;
-    for (i = 0; i < list.length; i++) {
-      if (list[i].length) {
-        length += list[i].length;
-      }
-    }
-  } else {
+  if (length !== undefined) {
     validateInt32(length, 'length', 0);
   }
 
-  const buffer = Buffer.allocUnsafe(length);
-  let pos = 0;
-  for (i = 0; i < list.length; i++) {
-    const buf = list[i];
-    if (!isUint8Array(buf)) {
-      // TODO(BridgeAR): This should not be of type ERR_INVALID_ARG_TYPE.
-      // Instead, find the proper error code for this.
-      throw new ERR_INVALID_ARG_TYPE(
-        `list[${i}]`, ['Buffer', 'Uint8Array'], list[i]);
-    }
-    pos += _copyActual(buf, buffer, pos, 0, buf.length);
-  }
-
-  // Note: `length` is always equal to `buffer.length` at this point
-  if (pos < length) {
-    // Zero-fill the remaining bytes if the specified `length` was more than
-    // the actual total length, i.e. if we have some remaining allocated bytes
-    // there were not initialized.
-    TypedArrayFill.call(buffer, 0, pos, length);
-  }
+  // Lengths are summed, validated and copied in a single native pass.
+  const result = _concat(list, length);
+  if (typeof result !== 'number')
+    return result;
 
-  return buffer;
+  // TODO(BridgeAR): This should not be of type ERR_INVALID_ARG_TYPE.
+  // Instead, find the proper error code for this.
+  throw new ERR_INVALID_ARG_TYPE(
+    `list[${result}]`, ['Buffer', 'Uint8Array'], list[result]);
 };
 
 function base64ByteLength(str, bytes) {
@@ -1165,6 +1151,7 @@ Buffer.prototype.swap64 = function swap64() {
 Buffer.prototype.toLocaleString = Buffer.prototype.toString;
 
 let transcode;
+let createTranscodeStream;
 if (internalBinding('config').hasIntl) {
   const {
     icuErrName,
@@ -1193,11 +1180,110 @@ if (internalBinding('config').hasIntl) {
     err.errno = result;
     throw err;
   };
+
+  // Returns a Transform stream that converts chunks between two encodings
+  // without materializing the whole input.
+  createTranscodeStream = function createTranscodeStream(fromEncoding,
+                                                         toEncoding,
+                                                         options) {
+    const { TranscodeStream } = require('internal/transcode_stream');
+    return new TranscodeStream(fromEncoding, toEncoding, options);
+  };
+}
+
+// Sorts many keys stored in a single buffer with one native call, instead of
+// calling Buffer.compare() from a JS comparator for every pair of keys.
+function sortKeys(source, offsets, lengths) {
+  if (!isUint8Array(source)) {
+    throw new ERR_INVALID_ARG_TYPE('source', ['Buffer', 'Uint8Array'], source);
+  }
+  if (!isUint32Array(offsets)) {
+    throw new ERR_INVALID_ARG_TYPE('offsets', 'Uint32Array', offsets);
+  }
+  let keyLength = 0;
+  if (typeof lengths === 'number') {
+    validateUint32(lengths, 'lengths');
+    keyLength = lengths;
+    lengths = undefined;
+  } else if (!isUint32Array(lengths)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'lengths', ['number', 'Uint32Array'], lengths);
+  } else if (lengths.length !== offsets.length) {
+    throw new ERR_INVALID_ARG_VALUE(
+      'lengths', lengths, 'must have the same length as offsets');
+  }
+
+  const result = _sortKeys(source, offsets, lengths, keyLength);
+  if (typeof result !== 'number')
+    return result;
+  throw new ERR_BUFFER_OUT_OF_BOUNDS(`offsets[${result}]`);
+}
+
+let jsonBinding;
+
+// Parses UTF-8 encoded JSON text directly from the bytes of `source`, without
+// first decoding it into a string as `JSON.parse(source.toString())` would.
+function parseJSON(source, options = {}) {
+  if (!isArrayBufferView(source)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'source', ['Buffer', 'TypedArray', 'DataView'], source);
+  }
+  validateObject(options, 'options');
+  const { lazyStringThreshold } = options;
+  if (lazyStringThreshold !== undefined)
+    validateInteger(lazyStringThreshold, 'options.lazyStringThreshold', 0);
+
+  if (jsonBinding === undefined)
+    jsonBinding = internalBinding('json');
+  return jsonBinding.parse(source, lazyStringThreshold);
+}
+
+const kChunks = Symbol('kChunks');
+const kByteLength = Symbol('kByteLength');
+
+// A sequence of Buffers that is treated as one contiguous run of bytes
+// without copying them. Writable streams accept it as a single chunk and pass
+// the individual Buffers on to `_writev()` where it is implemented.
+class BufferChain {
+  constructor(chunks = []) {
+    if (!ArrayIsArray(chunks)) {
+      throw new ERR_INVALID_ARG_TYPE('chunks', 'Array', chunks);
+    }
+    this[kChunks] = [];
+    this[kByteLength] = 0;
+    for (let i = 0; i < chunks.length; i++)
+      this.append(chunks[i]);
+  }
+
+  get length() {
+    return this[kByteLength];
+  }
+
+  append(chunk) {
+    if (!isUint8Array(chunk)) {
+      throw new ERR_INVALID_ARG_TYPE('chunk', ['Buffer', 'Uint8Array'], chunk);
+    }
+    this[kChunks].push(chunk);
+    this[kByteLength] += chunk.length;
+    return this;
+  }
+
+  toArray() {
+    return this[kChunks].slice();
+  }
+
+  toBuffer() {
+    return Buffer.concat(this[kChunks], this[kByteLength]);
+  }
 }
 
 module.exports = {
   Buffer,
+  BufferChain,
   SlowBuffer,
+  createTranscodeStream,
+  parseJSON,
+  sortKeys,
   transcode,
   // Legacy
   kMaxLength,
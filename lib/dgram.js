@@ -34,6 +34,11 @@ const {
   _createSocketHandle,
   newHandle,
 } = require('internal/dgram');
+const {
+  fromSocketOptionValue,
+  socketOptionId,
+  toSocketOption
+} = require('internal/net');
 const { guessHandleType } = internalBinding('util');
 const {
   ERR_INVALID_ARG_TYPE,
@@ -48,6 +53,7 @@ const {
 } = errors.codes;
 const {
   isInt32,
+  validateInteger,
   validateString,
   validateNumber,
   validatePort,
@@ -63,7 +69,7 @@ const {
 const { UV_UDP_REUSEADDR } = internalBinding('constants').os;
 
 const {
-  constants: { UV_UDP_IPV6ONLY },
+  constants: { UV_UDP_IPV6ONLY, kBindReusePort, kMaxRecvBatchSize },
   UDP,
   SendWrap
 } = internalBinding('udp_wrap');
@@ -91,6 +97,7 @@ function Socket(type, listener) {
   let lookup;
   let recvBufferSize;
   let sendBufferSize;
+  let recvBatchSize;
 
   let options;
   if (type !== null && typeof type === 'object') {
@@ -99,6 +106,11 @@ function Socket(type, listener) {
     lookup = options.lookup;
     recvBufferSize = options.recvBufferSize;
     sendBufferSize = options.sendBufferSize;
+    recvBatchSize = options.recvBatchSize;
+    if (recvBatchSize !== undefined) {
+      validateInteger(recvBatchSize, 'options.recvBatchSize',
+                      1, kMaxRecvBatchSize);
+    }
   }
 
   const handle = newHandle(type, lookup);
@@ -117,9 +129,11 @@ function Socket(type, listener) {
     connectState: CONNECT_STATE_DISCONNECTED,
     queue: undefined,
     reuseAddr: options && options.reuseAddr, // Use UV_UDP_REUSEADDR if true.
+    reusePort: options && options.reusePort, // Use SO_REUSEPORT if true.
     ipv6Only: options && options.ipv6Only,
     recvBufferSize,
-    sendBufferSize
+    sendBufferSize,
+    recvBatchSize
   };
 }
 ObjectSetPrototypeOf(Socket.prototype, EventEmitter.prototype);
@@ -135,6 +149,10 @@ function startListening(socket) {
   const state = socket[kStateSymbol];
 
   state.handle.onmessage = onMessage;
+  if (state.recvBatchSize) {
+    state.handle.onmessagebatch = onMessageBatch;
+    state.handle.setRecvBatchSize(state.recvBatchSize);
+  }
   // Todo: handle errors
   state.handle.recvStart();
   state.receiving = true;
@@ -157,6 +175,7 @@ function replaceHandle(self, newHandle) {
   newHandle.lookup = oldHandle.lookup;
   newHandle.bind = oldHandle.bind;
   newHandle.send = oldHandle.send;
+  newHandle.sendBatch = oldHandle.sendBatch;
   newHandle[owner_symbol] = self;
 
   // Replace the existing handle by the handle we got from master.
@@ -314,8 +333,12 @@ Socket.prototype.bind = function(port_, address_ /* , callback */) {
       flags |= UV_UDP_REUSEADDR;
     if (state.ipv6Only)
       flags |= UV_UDP_IPV6ONLY;
+    if (state.reusePort)
+      flags |= kBindReusePort;
 
-    if (cluster.isWorker && !exclusive) {
+    // With SO_REUSEPORT every worker binds a socket of its own and the kernel
+    // spreads the datagrams over them, so there is nothing to share.
+    if (cluster.isWorker && !exclusive && !state.reusePort) {
       bindServerHandle(this, {
         address: ip,
         port: port,
@@ -683,6 +706,127 @@ function doSend(ex, self, ip, list, address, port, callback) {
   }
 }
 
+// valid combinations
+// For connectionless sockets
+// sendBatch(list, port, address, callback)
+// sendBatch(list, port, address)
+// sendBatch(list, port, callback)
+// sendBatch(list, port)
+// For connected sockets
+// sendBatch(list, callback)
+// sendBatch(list)
+Socket.prototype.sendBatch = function(list, port, address, callback) {
+  const state = this[kStateSymbol];
+  const connected = state.connectState === CONNECT_STATE_CONNECTED;
+
+  if (!ArrayIsArray(list))
+    throw new ERR_INVALID_ARG_TYPE('list', 'Array', list);
+  const messages = fixBufferList(list);
+  if (messages === null) {
+    throw new ERR_INVALID_ARG_TYPE('list elements',
+                                   ['Buffer', 'Uint8Array', 'string'], list);
+  }
+
+  if (connected) {
+    if (typeof port === 'function') {
+      callback = port;
+      port = undefined;
+    }
+    if (port || address)
+      throw new ERR_SOCKET_DGRAM_IS_CONNECTED();
+  } else {
+    if (typeof address === 'function') {
+      callback = address;
+      address = undefined;
+    } else if (address && typeof address !== 'string') {
+      throw new ERR_INVALID_ARG_TYPE('address', ['string', 'falsy'], address);
+    }
+    port = validatePort(port, 'Port', { allowZero: false });
+  }
+
+  if (typeof callback !== 'function')
+    callback = undefined;
+
+  healthCheck(this);
+
+  if (state.bindState === BIND_STATE_UNBOUND)
+    this.bind({ port: 0, exclusive: true }, null);
+
+  if (state.bindState !== BIND_STATE_BOUND) {
+    enqueue(this,
+            this.sendBatch.bind(this, messages, port, address, callback));
+    return;
+  }
+
+  const afterDns = (ex, ip) => {
+    defaultTriggerAsyncIdScope(
+      this[async_id_symbol],
+      doSendBatch,
+      ex, this, ip, messages, address, port, callback
+    );
+  };
+
+  if (!connected) {
+    state.handle.lookup(address, afterDns);
+  } else {
+    afterDns(null, null);
+  }
+};
+
+function doSendBatch(ex, self, ip, list, address, port, callback) {
+  const state = self[kStateSymbol];
+
+  if (ex) {
+    if (typeof callback === 'function') {
+      process.nextTick(callback, ex);
+      return;
+    }
+
+    process.nextTick(() => self.emit('error', ex));
+    return;
+  } else if (!state.handle) {
+    return;
+  }
+
+  // Send as much as possible right away, with as few system calls as
+  // possible. Whatever the socket does not accept without blocking goes
+  // through the regular, queued send() path one datagram at a time.
+  let sent = 0;
+  if (list.length > 0) {
+    if (port)
+      sent = state.handle.sendBatch(list, list.length, port, ip);
+    else
+      sent = state.handle.sendBatch(list, list.length);
+  }
+
+  if (sent < 0) {
+    if (callback) {
+      const ex = exceptionWithHostPort(sent, 'send', address, port);
+      process.nextTick(callback, ex);
+    }
+    return;
+  }
+
+  let pending = list.length - sent;
+  if (pending === 0) {
+    if (callback)
+      process.nextTick(callback, null, sent);
+    return;
+  }
+
+  let error = null;
+  const afterSendOne = (err) => {
+    if (err)
+      error = error || err;
+    else
+      sent++;
+    if (--pending === 0 && callback)
+      callback(error, sent);
+  };
+  for (let i = sent; i < list.length; i++)
+    doSend(null, self, ip, [list[i]], address, port, afterSendOne);
+}
+
 function afterSend(err, sent) {
   if (err) {
     err = exceptionWithHostPort(err, 'send', this.address, this.port);
@@ -909,6 +1053,27 @@ function onMessage(nread, handle, buf, rinfo) {
 }
 
 
+// All datagrams of a batch share the memory of `buf`; `rinfo.size` is the
+// length of each of them.
+function onMessageBatch(count, handle, buf, rinfos) {
+  const self = handle[owner_symbol];
+  const messages = new Array(count);
+  let offset = 0;
+  for (let i = 0; i < count; i++) {
+    const end = offset + rinfos[i].size;
+    messages[i] = buf.slice(offset, end);
+    offset = end;
+  }
+
+  if (self.listenerCount('messages') === 0) {
+    for (let i = 0; i < count; i++)
+      self.emit('message', messages[i], rinfos[i]);
+    return;
+  }
+  self.emit('messages', messages, rinfos);
+}
+
+
 Socket.prototype.ref = function() {
   const handle = this[kStateSymbol].handle;
 
@@ -949,6 +1114,29 @@ Socket.prototype.getSendBufferSize = function() {
 };
 
 
+Socket.prototype.setSocketOption = function(option, value) {
+  const { id, value: optionValue } = toSocketOption(option, value, true);
+  healthCheck(this);
+
+  const err = this[kStateSymbol].handle.setSocketOption(id, optionValue);
+  if (err)
+    throw errnoException(err, 'setsockopt');
+  return this;
+};
+
+
+Socket.prototype.getSocketOption = function(option) {
+  const id = socketOptionId(option, true);
+  healthCheck(this);
+
+  const ctx = {};
+  const value = this[kStateSymbol].handle.getSocketOption(id, ctx);
+  if (value === undefined)
+    throw errors.uvException(ctx);
+  return fromSocketOptionValue(option, value);
+};
+
+
 // Deprecated private APIs.
 ObjectDefineProperty(Socket.prototype, '_handle', {
   get: deprecate(function() {
@@ -30,6 +30,8 @@ const { ClientRequest } = require('_http_client');
 const { methods } = require('_http_common');
 const { IncomingMessage } = require('_http_incoming');
 const { OutgoingMessage } = require('_http_outgoing');
+const { FastServer } = require('internal/http/fast_server');
+const { PoolAgent } = require('internal/http/pool_agent');
 const {
   _connectionListener,
   STATUS_CODES,
@@ -42,6 +44,10 @@ function createServer(opts, requestListener) {
   return new Server(opts, requestListener);
 }
 
+function createFastServer(opts, requestListener) {
+  return new FastServer(opts, requestListener);
+}
+
 function request(url, options, cb) {
   return new ClientRequest(url, options, cb);
 }
@@ -60,8 +66,10 @@ module.exports = {
   ClientRequest,
   IncomingMessage,
   OutgoingMessage,
+  PoolAgent,
   Server,
   ServerResponse,
+  createFastServer,
   createServer,
   get,
   request
@@ -0,0 +1,399 @@
+'use strict';
+
+const {
+  ArrayIsArray,
+  ObjectCreate,
+  ObjectKeys,
+  ObjectSetPrototypeOf,
+  Symbol,
+  Uint32Array,
+} = primordials;
+
+const net = require('net');
+const {
+  HTTPParser,
+  serializeHeaders,
+  kHeaderSourceOutHeaders,
+  kHeaderConnectionClose
+} = internalBinding('http_parser');
+const {
+  _checkInvalidHeaderChar: checkInvalidHeaderChar,
+  freeParser,
+  isLenient,
+  methods,
+  parsers,
+  prepareError
+} = require('_http_common');
+const {
+  getIncomingHeader,
+  setHeaderList
+} = require('_http_incoming');
+const {
+  validateHeaderName,
+  validateHeaderValue
+} = require('_http_outgoing');
+const { STATUS_CODES } = require('_http_server');
+const {
+  codes: {
+    ERR_HTTP_HEADERS_SENT,
+    ERR_HTTP_INVALID_HEADER_VALUE,
+    ERR_HTTP_INVALID_STATUS_CODE,
+    ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_CHAR
+  },
+  errnoException
+} = require('internal/errors');
+const { isArrayBufferView } = require('internal/util/types');
+const {
+  validateInteger,
+  validateString
+} = require('internal/validators');
+const debug = require('internal/util/debuglog').debuglog('http');
+
+const kOnExecute = HTTPParser.kOnExecute | 0;
+const kOnRequest = HTTPParser.kOnRequest | 0;
+const kOnWriteComplete = HTTPParser.kOnWriteComplete | 0;
+
+const kOutHeaders = Symbol('kOutHeaders');
+const kState = Symbol('kState');
+const kId = Symbol('kId');
+
+// Receives the flags of the headers that serializeHeaders() saw.
+const headerFlags = new Uint32Array(1);
+
+const errorResponses = {
+  HPE_BODY_OVERFLOW: 413,
+  HPE_HEADER_OVERFLOW: 431
+};
+
+// A request that was read completely before it is handed to the server's
+// 'request' listeners.
+class FastRequest {
+  constructor(socket, method, url, headers, body, versionMajor,
+              versionMinor) {
+    this.socket = socket;
+    this.method = method;
+    this.url = url;
+    this.httpVersionMajor = versionMajor;
+    this.httpVersionMinor = versionMinor;
+    this.httpVersion = `${versionMajor}.${versionMinor}`;
+    this.body = body === undefined ? null : body;
+    // `headers` and `rawHeaders` are created from the native HeaderList
+    // the first time they are read, like with the lazyHeaders option of
+    // http.createServer().
+    setHeaderList(this, headers, headers.count() * 2);
+  }
+
+  getHeader(name) {
+    validateString(name, 'name');
+    return getIncomingHeader(this, name);
+  }
+}
+
+// The response to a FastRequest. The whole response is written by end().
+class FastResponse {
+  constructor(state, id, isHead, shouldKeepAlive) {
+    this.statusCode = 200;
+    this.statusMessage = undefined;
+    this.finished = false;
+    this[kState] = state;
+    this[kId] = id;
+    this[kOutHeaders] = null;
+    this.isHead = isHead;
+    this.shouldKeepAlive = shouldKeepAlive;
+  }
+
+  get headersSent() {
+    return this.finished;
+  }
+
+  setHeader(name, value) {
+    if (this.finished)
+      throw new ERR_HTTP_HEADERS_SENT('set');
+    validateHeaderName(name);
+    if (ArrayIsArray(value)) {
+      for (let i = 0; i < value.length; i++)
+        validateFastHeaderValue(name, value[i]);
+    } else {
+      validateFastHeaderValue(name, value);
+    }
+
+    let headers = this[kOutHeaders];
+    if (headers === null)
+      this[kOutHeaders] = headers = ObjectCreate(null);
+    headers[name.toLowerCase()] = [name, value];
+    return this;
+  }
+
+  getHeader(name) {
+    validateString(name, 'name');
+    const headers = this[kOutHeaders];
+    if (headers === null)
+      return;
+    const entry = headers[name.toLowerCase()];
+    return entry && entry[1];
+  }
+
+  removeHeader(name) {
+    validateString(name, 'name');
+    if (this.finished)
+      throw new ERR_HTTP_HEADERS_SENT('remove');
+    const headers = this[kOutHeaders];
+    if (headers !== null)
+      delete headers[name.toLowerCase()];
+  }
+
+  writeHead(statusCode, reason, headers) {
+    if (this.finished)
+      throw new ERR_HTTP_HEADERS_SENT('render');
+    if (typeof reason === 'string') {
+      this.statusMessage = reason;
+    } else {
+      headers = reason;
+    }
+    this.statusCode = statusCode;
+    if (headers) {
+      const keys = ObjectKeys(headers);
+      for (let i = 0; i < keys.length; i++)
+        this.setHeader(keys[i], headers[keys[i]]);
+    }
+    return this;
+  }
+
+  end(body) {
+    if (this.finished)
+      return this;
+    if (body !== undefined && body !== null && typeof body !== 'string' &&
+        !isArrayBufferView(body)) {
+      throw new ERR_INVALID_ARG_TYPE('body',
+                                     ['string', 'Buffer', 'TypedArray',
+                                      'DataView'],
+                                     body);
+    }
+
+    const statusCode = this.statusCode;
+    validateInteger(statusCode, 'statusCode');
+    if (statusCode < 100 || statusCode > 999)
+      throw new ERR_HTTP_INVALID_STATUS_CODE(statusCode);
+    let statusMessage = this.statusMessage;
+    if (statusMessage === undefined)
+      statusMessage = STATUS_CODES[statusCode] || 'unknown';
+    else if (checkInvalidHeaderChar(statusMessage))
+      throw new ERR_INVALID_CHAR('statusMessage');
+
+    let lines = '';
+    let flags = 0;
+    const headers = this[kOutHeaders];
+    if (headers !== null) {
+      // The headers were validated by setHeader().
+      lines = serializeHeaders(headers, kHeaderSourceOutHeaders, headerFlags);
+      flags = headerFlags[0];
+    }
+
+    const state = this[kState];
+    // The connection is gone.
+    if (state.parser === null) {
+      this.finished = true;
+      return this;
+    }
+
+    const keepAlive =
+      this.shouldKeepAlive && (flags & kHeaderConnectionClose) === 0;
+    const written = state.parser.respond(this[kId], statusCode,
+                                         `${statusMessage}`, lines, flags,
+                                         body, keepAlive, this.isHead);
+    this.finished = true;
+    if (!keepAlive)
+      state.lastId = this[kId];
+    onResponseWritten(state, written);
+    return this;
+  }
+}
+
+function validateFastHeaderValue(name, value) {
+  validateHeaderValue(name, value);
+  if (typeof value !== 'string' && typeof value !== 'number')
+    throw new ERR_HTTP_INVALID_HEADER_VALUE(value, name);
+  // Responses have a known length, so they are never chunked.
+  if (name.length === 17 && name.toLowerCase() === 'transfer-encoding')
+    throw new ERR_HTTP_INVALID_HEADER_VALUE(value, name);
+}
+
+function onResponseWritten(state, written) {
+  const { socket } = state;
+  if (socket.destroyed)
+    return;
+  if (state.lastId !== -1 && written > state.lastId) {
+    socket.destroySoon();
+  } else if (written === state.requests) {
+    // All requests have been answered.
+    socket.setTimeout(state.server.keepAliveTimeout);
+    state.keepAliveTimeoutSet = true;
+  }
+}
+
+// Called by the parser for each write of a response, and for writes that
+// failed synchronously.
+function onWriteComplete(state, status, handle, error) {
+  if (status < 0)
+    state.socket.destroy(errnoException(status, 'write', error));
+}
+
+// Called by the parser for each complete request. Keep the arguments in sync
+// with Parser::DeliverRequest() in src/node_http_parser.cc.
+function onRequest(state, id, method, url, headers, body, versionMajor,
+                   versionMinor, shouldKeepAlive, rejectStatus) {
+  const { server, socket } = state;
+  state.requests++;
+  if (state.keepAliveTimeoutSet) {
+    socket.setTimeout(server.timeout);
+    state.keepAliveTimeoutSet = false;
+  }
+
+  // The request has an Expect header that cannot be met. Nothing after it is
+  // read, so the connection is closed after the response.
+  if (rejectStatus !== 0) {
+    const res = new FastResponse(state, id, false, false);
+    res.statusCode = rejectStatus;
+    res.end();
+    return;
+  }
+
+  const req = new FastRequest(socket, methods[method], url, headers, body,
+                              versionMajor, versionMinor);
+  const res = new FastResponse(state, id, req.method === 'HEAD',
+                               shouldKeepAlive);
+  server.emit('request', req, res);
+}
+
+function onParserExecute(state, ret) {
+  const { parser, socket } = state;
+  prepareError(ret, parser, undefined);
+  debug('fast server parse error', ret);
+
+  if (!state.server.emit('clientError', ret, socket)) {
+    if (socket.writable) {
+      const status = errorResponses[ret.code] || 400;
+      socket.write(`HTTP/1.1 ${status} ${STATUS_CODES[status]}\r\n` +
+                   'Connection: close\r\n\r\n');
+    }
+    socket.destroy(ret);
+  }
+}
+
+function socketOnError(err) {
+  debug('fast server socket error', err);
+}
+
+function socketOnTimeout() {
+  if (!this.server.emit('timeout', this))
+    this.destroy();
+}
+
+function socketOnClose() {
+  const state = this[kState];
+  const { parser } = state;
+  if (parser !== null) {
+    parser[kOnRequest] = null;
+    parser[kOnWriteComplete] = null;
+    freeParser(parser, null, this);
+    state.parser = null;
+  }
+}
+
+function connectionListener(socket) {
+  const server = this;
+  socket.on('error', socketOnError);
+  socket.on('timeout', socketOnTimeout);
+  socket.on('close', socketOnClose);
+  if (server.timeout)
+    socket.setTimeout(server.timeout);
+
+  // The parser reads from the socket's handle directly.
+  if (!socket._handle || !socket._handle.isStreamBase ||
+      socket._handle._consumed) {
+    socket.destroy();
+    return;
+  }
+
+  const parser = parsers.alloc();
+  parser.initialize(
+    HTTPParser.REQUEST,
+    {},
+    server.maxHeaderSize || 0,
+    server.insecureHTTPParser === undefined ?
+      isLenient() : server.insecureHTTPParser
+  );
+  parser.enableFastMode(server.maxBodySize);
+
+  const state = {
+    server,
+    socket,
+    parser,
+    requests: 0,
+    // The id of the last request on this connection, if known.
+    lastId: -1,
+    keepAliveTimeoutSet: false
+  };
+  socket[kState] = state;
+  socket.parser = parser;
+  parser.socket = socket;
+  parser[kOnRequest] = onRequest.bind(undefined, state);
+  parser[kOnWriteComplete] = onWriteComplete.bind(undefined, state);
+  parser[kOnExecute] = onParserExecute.bind(undefined, state);
+
+  parser._consumed = true;
+  socket._handle._consumed = true;
+  parser.consume(socket._handle);
+}
+
+function FastServer(options, requestListener) {
+  if (!(this instanceof FastServer))
+    return new FastServer(options, requestListener);
+
+  if (typeof options === 'function') {
+    requestListener = options;
+    options = {};
+  } else if (options == null || typeof options === 'object') {
+    options = { ...options };
+  } else {
+    throw new ERR_INVALID_ARG_TYPE('options', 'object', options);
+  }
+
+  const { maxHeaderSize, maxBodySize = 1024 * 1024 } = options;
+  if (maxHeaderSize !== undefined)
+    validateInteger(maxHeaderSize, 'maxHeaderSize', 0);
+  this.maxHeaderSize = maxHeaderSize;
+  validateInteger(maxBodySize, 'maxBodySize', 0);
+  this.maxBodySize = maxBodySize;
+
+  const insecureHTTPParser = options.insecureHTTPParser;
+  if (insecureHTTPParser !== undefined &&
+      typeof insecureHTTPParser !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE(
+      'insecureHTTPParser', 'boolean', insecureHTTPParser);
+  }
+  this.insecureHTTPParser = insecureHTTPParser;
+
+  net.Server.call(this, { allowHalfOpen: false });
+
+  if (requestListener)
+    this.on('request', requestListener);
+  this.on('connection', connectionListener);
+
+  this.timeout = 0;
+  this.keepAliveTimeout = 5000;
+}
+ObjectSetPrototypeOf(FastServer.prototype, net.Server.prototype);
+ObjectSetPrototypeOf(FastServer, net.Server);
+
+FastServer.prototype.setTimeout = function setTimeout(msecs, callback) {
+  this.timeout = msecs;
+  if (callback)
+    this.on('timeout', callback);
+  return this;
+};
+
+module.exports = {
+  FastServer
+};
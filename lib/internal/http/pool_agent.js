@@ -0,0 +1,463 @@
+'use strict';
+
+const {
+  Map,
+  ObjectSetPrototypeOf,
+  Set,
+  Symbol,
+} = primordials;
+
+const net = require('net');
+const EventEmitter = require('events');
+const { Agent } = require('_http_agent');
+const { async_id_symbol } = require('internal/async_hooks').symbols;
+const {
+  codes: {
+    ERR_INVALID_ARG_VALUE,
+    ERR_INVALID_CALLBACK
+  }
+} = require('internal/errors');
+const FixedQueue = require('internal/fixed_queue');
+const { Histogram } = require('internal/histogram');
+const { validateInteger } = require('internal/validators');
+const { createHistogram } = internalBinding('performance');
+const { getLibuvNow } = internalBinding('timers');
+const debug = require('internal/util/debuglog').debuglog('http');
+
+let dns;
+
+// Connect times are recorded in nanoseconds, up to one minute.
+const kMaxConnectTime = 60e9;
+// Weight of the latest request in the average request duration of a socket,
+// which is used by the 'latency' scheduling.
+const kLatencyWeight = 0.2;
+
+const kPools = Symbol('kPools');
+const kPool = Symbol('kPool');
+const kAddress = Symbol('kAddress');
+const kLatency = Symbol('kLatency');
+const kAssignTime = Symbol('kAssignTime');
+
+const schedulings = ['lifo', 'fifo', 'latency'];
+
+class ReusedHandle {
+  constructor(type, handle) {
+    this.type = type;
+    this.handle = handle;
+  }
+}
+
+// The sockets, queued requests and metrics of one origin, i.e. of all
+// requests that have the same agent.getName().
+class Pool {
+  constructor(agent, name, options) {
+    this.agent = agent;
+    this.name = name;
+    this.options = options;
+    // Sockets that are assigned to a request.
+    this.active = new Set();
+    this.idle = [];
+    this.pending = new FixedQueue();
+    this.pendingCount = 0;
+    // Cached DNS results and the number of open sockets per address, if
+    // lookupTTL is set.
+    this.addresses = null;
+    this.addressesExpire = 0;
+    this.load = new Map();
+
+    this.requests = 0;
+    this.reused = 0;
+    this.connects = 0;
+    this.connectTime = createHistogram(1, kMaxConnectTime);
+    this.connectTimeHistogram = new Histogram(this.connectTime);
+  }
+
+  get size() {
+    return this.active.size + this.idle.length;
+  }
+}
+
+function PoolAgent(options) {
+  if (!(this instanceof PoolAgent))
+    return new PoolAgent(options);
+
+  EventEmitter.call(this);
+
+  this.defaultPort = 80;
+  this.protocol = 'http:';
+
+  this.options = { ...options };
+  // Don't confuse net and make it think that we're connecting to a pipe
+  this.options.path = null;
+
+  const {
+    keepAlive = true,
+    keepAliveMsecs = 1000,
+    maxSockets = Infinity,
+    maxFreeSockets = 256,
+    scheduling = 'lifo',
+    lookupTTL = 0
+  } = this.options;
+  if (maxSockets !== Infinity)
+    validateInteger(maxSockets, 'options.maxSockets', 1);
+  validateInteger(maxFreeSockets, 'options.maxFreeSockets', 0);
+  if (!schedulings.includes(scheduling)) {
+    throw new ERR_INVALID_ARG_VALUE('options.scheduling', scheduling,
+                                    "must be 'lifo', 'fifo' or 'latency'");
+  }
+  validateInteger(lookupTTL, 'options.lookupTTL', 0);
+
+  this.keepAlive = keepAlive;
+  this.keepAliveMsecs = keepAliveMsecs;
+  this.maxSockets = maxSockets;
+  this.maxFreeSockets = maxFreeSockets;
+  this.scheduling = scheduling;
+  this.lookupTTL = lookupTTL;
+  this[kPools] = new Map();
+}
+ObjectSetPrototypeOf(PoolAgent.prototype, EventEmitter.prototype);
+ObjectSetPrototypeOf(PoolAgent, EventEmitter);
+
+PoolAgent.prototype.createConnection = net.createConnection;
+PoolAgent.prototype.getName = Agent.prototype.getName;
+PoolAgent.prototype.keepSocketAlive = Agent.prototype.keepSocketAlive;
+PoolAgent.prototype.reuseSocket = Agent.prototype.reuseSocket;
+
+PoolAgent.prototype.addRequest = function addRequest(req, options) {
+  options = { ...options, ...this.options };
+  if (options.socketPath)
+    options.path = options.socketPath;
+
+  const pool = getPool(this, options);
+  pool.requests++;
+
+  const socket = takeIdleSocket(pool);
+  if (socket !== undefined) {
+    // Guard against an uninitialized or user supplied Socket.
+    const handle = socket._handle;
+    if (handle && typeof handle.asyncReset === 'function') {
+      // Assign the handle a new asyncId and run any destroy()/init() hooks.
+      handle.asyncReset(new ReusedHandle(handle.getProviderType(), handle));
+      socket[async_id_symbol] = handle.getAsyncId();
+    }
+
+    pool.reused++;
+    this.reuseSocket(socket, req);
+    assignSocket(pool, req, socket);
+  } else if (pool.size < this.maxSockets) {
+    assignSocket(pool, req, createSocket(pool, options));
+  } else {
+    debug('wait for socket', pool.name);
+    pool.pending.push(req);
+    pool.pendingCount++;
+  }
+};
+
+// Opens `count` connections to the origin of `options` ahead of the first
+// requests. The connections count against maxSockets.
+PoolAgent.prototype.preconnect = function preconnect(options, count, callback) {
+  if (typeof count === 'function') {
+    callback = count;
+    count = 1;
+  } else if (count === undefined) {
+    count = 1;
+  }
+  validateInteger(count, 'count', 1);
+  if (callback !== undefined && typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK(callback);
+
+  options = { ...options, ...this.options };
+  options.host = options.host || options.hostname || 'localhost';
+  options.port = options.port || this.defaultPort;
+  if (options.socketPath)
+    options.path = options.socketPath;
+
+  const pool = getPool(this, options);
+  const agentTimeout = this.options.timeout || 0;
+  let remaining = count < this.maxSockets - pool.size ?
+    count : this.maxSockets - pool.size;
+  let called = false;
+  const done = (err) => {
+    if (called || (err === null && --remaining > 0))
+      return;
+    called = true;
+    if (callback !== undefined)
+      callback(err);
+  };
+  if (remaining <= 0) {
+    process.nextTick(done, null);
+    return;
+  }
+
+  for (let i = remaining; i > 0; i--) {
+    const socket = createSocket(pool, options);
+    const onConnect = () => {
+      socket.removeListener('error', onError);
+      done(null);
+    };
+    const onError = (err) => {
+      socket.removeListener('connect', onConnect);
+      done(err);
+    };
+    socket.once('connect', onConnect);
+    socket.once('error', onError);
+    socket.on('error', onIdleSocketError);
+    this.keepSocketAlive(socket);
+    if (socket.timeout !== agentTimeout)
+      socket.setTimeout(agentTimeout);
+    pool.idle.push(socket);
+  }
+};
+
+PoolAgent.prototype.getMetrics = function getMetrics() {
+  const metrics = {};
+  for (const pool of this[kPools].values()) {
+    metrics[pool.name] = {
+      pending: pool.pendingCount,
+      active: pool.active.size,
+      idle: pool.idle.length,
+      requests: pool.requests,
+      reused: pool.reused,
+      reuseRate: pool.requests === 0 ? 0 : pool.reused / pool.requests,
+      connects: pool.connects,
+      connectTime: pool.connectTimeHistogram
+    };
+  }
+  return metrics;
+};
+
+PoolAgent.prototype.destroy = function destroy() {
+  for (const pool of this[kPools].values()) {
+    for (const socket of pool.idle)
+      socket.destroy();
+    for (const socket of pool.active)
+      socket.destroy();
+  }
+};
+
+function getPool(agent, options) {
+  const name = agent.getName(options);
+  let pool = agent[kPools].get(name);
+  if (pool === undefined) {
+    pool = new Pool(agent, name, options);
+    agent[kPools].set(name, pool);
+  }
+  return pool;
+}
+
+function takeIdleSocket(pool) {
+  const { idle } = pool;
+  while (idle.length > 0) {
+    let socket;
+    switch (pool.agent.scheduling) {
+      case 'fifo':
+        socket = idle.shift();
+        break;
+      case 'latency': {
+        let index = 0;
+        for (let i = 1; i < idle.length; i++) {
+          if (idle[i][kLatency] < idle[index][kLatency])
+            index = i;
+        }
+        socket = idle[index];
+        idle.splice(index, 1);
+        break;
+      }
+      default:
+        socket = idle.pop();
+    }
+    if (!socket.destroyed)
+      return socket;
+  }
+}
+
+function createSocket(pool, options) {
+  const agent = pool.agent;
+  options = { ...options, encoding: null, _agentKey: pool.name };
+  if (agent.lookupTTL > 0 && !options.path && options.lookup === undefined) {
+    options.lookup = (hostname, dnsOptions, cb) => {
+      lookupCached(pool, hostname, dnsOptions, cb);
+    };
+  }
+
+  debug('createConnection', pool.name, options);
+  const start = process.hrtime();
+  const socket = agent.createConnection(options);
+  socket[kPool] = pool;
+  socket[kLatency] = 0;
+  socket.once('connect', () => {
+    const [seconds, nanoseconds] = process.hrtime(start);
+    pool.connectTime.record(seconds * 1e9 + nanoseconds);
+    pool.connects++;
+  });
+  if (options.lookup !== undefined)
+    socket.on('lookup', onSocketLookup);
+  socket.on('free', onSocketFree);
+  socket.on('close', onSocketClose);
+  socket.on('timeout', onSocketTimeout);
+  socket.on('agentRemove', onSocketAgentRemove);
+  return socket;
+}
+
+function assignSocket(pool, req, socket) {
+  pool.active.add(socket);
+  if (pool.agent.scheduling === 'latency')
+    socket[kAssignTime] = process.hrtime();
+  socket.removeListener('error', onIdleSocketError);
+  req.onSocket(socket);
+  const agentTimeout = pool.agent.options.timeout || 0;
+  if (req.timeout === undefined || req.timeout === agentTimeout) {
+    return;
+  }
+  socket.setTimeout(req.timeout);
+}
+
+// Removes `socket` from its pool and uses the free slot for the next queued
+// request. The pool itself is removed from the agent once it is empty.
+function releaseSocket(pool, socket) {
+  if (!pool.active.delete(socket)) {
+    const index = pool.idle.indexOf(socket);
+    if (index !== -1)
+      pool.idle.splice(index, 1);
+  }
+  const address = socket[kAddress];
+  if (address !== undefined) {
+    socket[kAddress] = undefined;
+    pool.load.set(address, pool.load.get(address) - 1);
+  }
+
+  if (pool.pendingCount > 0 && pool.size < pool.agent.maxSockets) {
+    debug('releaseSocket, have a request, make a socket');
+    const req = pool.pending.shift();
+    pool.pendingCount--;
+    assignSocket(pool, req, createSocket(pool, pool.options));
+  } else if (pool.size === 0 && pool.pendingCount === 0) {
+    const pools = pool.agent[kPools];
+    // A new pool may have been created for the same origin in the meantime.
+    if (pools.get(pool.name) === pool)
+      pools.delete(pool.name);
+  }
+}
+
+function onSocketFree() {
+  const socket = this;
+  const pool = socket[kPool];
+  const agent = pool.agent;
+  debug('PoolAgent socket free', pool.name);
+
+  const start = socket[kAssignTime];
+  if (start !== undefined) {
+    const [seconds, nanoseconds] = process.hrtime(start);
+    const duration = seconds * 1e9 + nanoseconds;
+    const latency = socket[kLatency];
+    socket[kLatency] = latency === 0 ?
+      duration : latency + kLatencyWeight * (duration - latency);
+    socket[kAssignTime] = undefined;
+  }
+
+  if (socket.writable && pool.pendingCount > 0) {
+    const req = pool.pending.shift();
+    pool.pendingCount--;
+    pool.reused++;
+    assignSocket(pool, req, socket);
+    return;
+  }
+
+  // If there are no pending requests, then put it in the idle list, but
+  // only if we're allowed to do so.
+  const req = socket._httpMessage;
+  if (req &&
+      req.shouldKeepAlive &&
+      socket.writable &&
+      agent.keepAlive &&
+      pool.idle.length < agent.maxFreeSockets &&
+      agent.keepSocketAlive(socket)) {
+    pool.active.delete(socket);
+    socket[async_id_symbol] = -1;
+    socket._httpMessage = null;
+
+    const agentTimeout = agent.options.timeout || 0;
+    if (socket.timeout !== agentTimeout)
+      socket.setTimeout(agentTimeout);
+
+    pool.idle.push(socket);
+  } else {
+    socket.destroy();
+  }
+}
+
+function onSocketClose() {
+  debug('PoolAgent socket close');
+  releaseSocket(this[kPool], this);
+}
+
+function onSocketTimeout() {
+  // Destroy if idle.
+  if (!this[kPool].active.has(this))
+    this.destroy();
+}
+
+function onSocketAgentRemove() {
+  // We need this function for cases like HTTP 'upgrade'
+  // (defined by WebSockets) where we need to remove a socket from the
+  // pool because it'll be locked up indefinitely
+  debug('PoolAgent socket agentRemove');
+  this.removeListener('lookup', onSocketLookup);
+  this.removeListener('free', onSocketFree);
+  this.removeListener('close', onSocketClose);
+  this.removeListener('timeout', onSocketTimeout);
+  this.removeListener('agentRemove', onSocketAgentRemove);
+  releaseSocket(this[kPool], this);
+}
+
+function onSocketLookup(err, address) {
+  if (err)
+    return;
+  const { load } = this[kPool];
+  this[kAddress] = address;
+  load.set(address, (load.get(address) || 0) + 1);
+}
+
+function onIdleSocketError(err) {
+  debug('PoolAgent error on idle socket:', err.message);
+  this.destroy();
+}
+
+// Resolves `hostname` at most once per lookupTTL milliseconds and returns
+// the resolved address with the fewest open sockets.
+function lookupCached(pool, hostname, dnsOptions, callback) {
+  if (pool.addresses !== null && getLibuvNow() < pool.addressesExpire) {
+    process.nextTick(pickAddress, pool, callback);
+    return;
+  }
+
+  if (dns === undefined)
+    dns = require('dns');
+  dns.lookup(hostname, { ...dnsOptions, all: true }, (err, addresses) => {
+    if (err) {
+      callback(err);
+      return;
+    }
+    pool.addresses = addresses;
+    pool.addressesExpire = getLibuvNow() + pool.agent.lookupTTL;
+    pickAddress(pool, callback);
+  });
+}
+
+function pickAddress(pool, callback) {
+  const { addresses, load } = pool;
+  let best = addresses[0];
+  let bestLoad = load.get(best.address) || 0;
+  for (let i = 1; i < addresses.length && bestLoad > 0; i++) {
+    const count = load.get(addresses[i].address) || 0;
+    if (count < bestLoad) {
+      best = addresses[i];
+      bestLoad = count;
+    }
+  }
+  callback(null, best.address, best.family);
+}
+
+module.exports = {
+  PoolAgent
+};
@@ -94,7 +94,8 @@ const {
   },
   hideStackFrames
 } = require('internal/errors');
-const { validateNumber,
+const { validateInteger,
+        validateNumber,
         validateString,
         validateUint32,
         isUint32,
@@ -114,6 +115,7 @@ const {
   getDefaultSettings,
   getSessionState,
   getSettings,
+  getPseudoHeader,
   getStreamState,
   isPayloadMeaningless,
   kSocket,
@@ -268,7 +270,10 @@ const {
   HTTP_STATUS_MISDIRECTED_REQUEST,
 
   STREAM_OPTION_EMPTY_PAYLOAD,
-  STREAM_OPTION_GET_TRAILERS
+  STREAM_OPTION_GET_TRAILERS,
+
+  STREAM_SCHEDULER_DEFAULT,
+  STREAM_SCHEDULER_SMALL_FIRST
 } = constants;
 
 const STREAM_FLAGS_PENDING = 0x0;
@@ -289,6 +294,18 @@ function emit(self, ...args) {
   self.emit(...args);
 }
 
+// The header object of a block of headers is only built when the block is
+// emitted to a listener.
+function emitSessionStream(session, stream, flags, headers) {
+  if (session.listenerCount('stream') > 0)
+    session.emit('stream', stream, toHeaderObject(headers), flags, headers);
+}
+
+function emitStreamHeaders(stream, event, flags, headers) {
+  if (stream.listenerCount(event) > 0)
+    stream.emit(event, toHeaderObject(headers), flags, headers);
+}
+
 // Called when a new block of headers has been received for a given
 // stream. The stream may or may not be new. If the stream is new,
 // create the associated Http2Stream instance and emit the 'stream'
@@ -307,9 +324,6 @@ function onSessionHeaders(handle, id, cat, flags, headers) {
   const endOfStream = !!(flags & NGHTTP2_FLAG_END_STREAM);
   let stream = streams.get(id);
 
-  // Convert the array of header name value pairs into an object
-  const obj = toHeaderObject(headers);
-
   if (stream === undefined) {
     if (session.closed) {
       // We are not accepting any new streams at this point. This callback
@@ -322,8 +336,12 @@ function onSessionHeaders(handle, id, cat, flags, headers) {
     const opts = { readable: !endOfStream };
     // session[kType] can be only one of two possible values
     if (type === NGHTTP2_SESSION_SERVER) {
-      stream = new ServerHttp2Stream(session, handle, id, opts, obj);
-      if (obj[HTTP2_HEADER_METHOD] === HTTP2_METHOD_HEAD) {
+      stream = new ServerHttp2Stream(
+        session, handle, id, opts,
+        getPseudoHeader(headers, HTTP2_HEADER_SCHEME),
+        getPseudoHeader(headers, HTTP2_HEADER_AUTHORITY));
+      if (getPseudoHeader(headers, HTTP2_HEADER_METHOD) ===
+          HTTP2_METHOD_HEAD) {
         // For head requests, there must not be a body...
         // end the writable side immediately.
         stream.end();
@@ -335,10 +353,12 @@ function onSessionHeaders(handle, id, cat, flags, headers) {
     }
     if (endOfStream)
       stream[kState].endAfterHeaders = true;
-    process.nextTick(emit, session, 'stream', stream, obj, flags, headers);
+    process.nextTick(emitSessionStream, session, stream, flags, headers);
   } else {
     let event;
-    const status = obj[HTTP2_HEADER_STATUS];
+    let status = getPseudoHeader(headers, HTTP2_HEADER_STATUS);
+    if (status !== undefined)
+      status |= 0;
     if (cat === NGHTTP2_HCAT_RESPONSE) {
       if (!endOfStream &&
           status !== undefined &&
@@ -362,7 +382,7 @@ function onSessionHeaders(handle, id, cat, flags, headers) {
       originSet.delete(stream[kOrigin]);
     }
     debugStream(id, type, "emitting stream '%s' event", event);
-    process.nextTick(emit, stream, event, obj, flags, headers);
+    process.nextTick(emitStreamHeaders, stream, event, flags, headers);
   }
   if (endOfStream) {
     stream.push(null);
@@ -2427,12 +2447,12 @@ function afterOpen(session, options, headers, streamOptions, err, fd) {
 }
 
 class ServerHttp2Stream extends Http2Stream {
-  constructor(session, handle, id, options, headers) {
+  constructor(session, handle, id, options, protocol, authority) {
     super(session, options);
     handle.owner = this;
     this[kInit](id, handle);
-    this[kProtocol] = headers[HTTP2_HEADER_SCHEME];
-    this[kAuthority] = headers[HTTP2_HEADER_AUTHORITY];
+    this[kProtocol] = protocol;
+    this[kAuthority] = authority;
   }
 
   // True if the remote peer accepts push streams
@@ -2510,7 +2530,9 @@ class ServerHttp2Stream extends Http2Stream {
     }
 
     const id = ret.id();
-    const stream = new ServerHttp2Stream(session, ret, id, options, headers);
+    const stream = new ServerHttp2Stream(session, ret, id, options,
+                                         headers[HTTP2_HEADER_SCHEME],
+                                         headers[HTTP2_HEADER_AUTHORITY]);
     stream[kSentHeaders] = headers;
 
     if (options.endStream)
@@ -2862,6 +2884,11 @@ function initializeOptions(options) {
     );
   }
 
+  if (options.streamScheduler !== undefined) {
+    validateInteger(options.streamScheduler, 'options.streamScheduler',
+                    STREAM_SCHEDULER_DEFAULT, STREAM_SCHEDULER_SMALL_FIRST);
+  }
+
   // Used only with allowHTTP1
   options.Http1IncomingMessage = options.Http1IncomingMessage ||
     http.IncomingMessage;
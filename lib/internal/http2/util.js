@@ -193,6 +193,7 @@ const IDX_STREAM_STATE_SUM_DEPENDENCY_WEIGHT = 2;
 const IDX_STREAM_STATE_LOCAL_CLOSE = 3;
 const IDX_STREAM_STATE_REMOTE_CLOSE = 4;
 const IDX_STREAM_STATE_LOCAL_WINDOW_SIZE = 5;
+const IDX_STREAM_STATE_REMOTE_WINDOW_SIZE = 6;
 
 const IDX_OPTIONS_MAX_DEFLATE_DYNAMIC_TABLE_SIZE = 0;
 const IDX_OPTIONS_MAX_RESERVED_REMOTE_STREAMS = 1;
@@ -203,7 +204,8 @@ const IDX_OPTIONS_MAX_HEADER_LIST_PAIRS = 5;
 const IDX_OPTIONS_MAX_OUTSTANDING_PINGS = 6;
 const IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS = 7;
 const IDX_OPTIONS_MAX_SESSION_MEMORY = 8;
-const IDX_OPTIONS_FLAGS = 9;
+const IDX_OPTIONS_STREAM_SCHEDULER = 9;
+const IDX_OPTIONS_FLAGS = 10;
 
 function updateOptionsBuffer(options) {
   let flags = 0;
@@ -252,6 +254,11 @@ function updateOptionsBuffer(options) {
     optionsBuffer[IDX_OPTIONS_MAX_SESSION_MEMORY] =
       MathMax(1, options.maxSessionMemory);
   }
+  if (typeof options.streamScheduler === 'number') {
+    flags |= (1 << IDX_OPTIONS_STREAM_SCHEDULER);
+    optionsBuffer[IDX_OPTIONS_STREAM_SCHEDULER] =
+      options.streamScheduler;
+  }
   optionsBuffer[IDX_OPTIONS_FLAGS] = flags;
 }
 
@@ -399,7 +406,8 @@ function getStreamState(stream) {
     sumDependencyWeight: streamState[IDX_STREAM_STATE_SUM_DEPENDENCY_WEIGHT],
     localClose: streamState[IDX_STREAM_STATE_LOCAL_CLOSE],
     remoteClose: streamState[IDX_STREAM_STATE_REMOTE_CLOSE],
-    localWindowSize: streamState[IDX_STREAM_STATE_LOCAL_WINDOW_SIZE]
+    localWindowSize: streamState[IDX_STREAM_STATE_LOCAL_WINDOW_SIZE],
+    remoteWindowSize: streamState[IDX_STREAM_STATE_REMOTE_WINDOW_SIZE]
   };
 }
 
@@ -578,6 +586,15 @@ function toHeaderObject(headers) {
   return obj;
 }
 
+// Returns the first value of the pseudo-header `name` in a flat array of
+// header names and values as passed up from the binding.
+function getPseudoHeader(headers, name) {
+  for (let n = 0; n < headers.length; n += 2) {
+    if (headers[n] === name)
+      return headers[n + 1];
+  }
+}
+
 function isPayloadMeaningless(method) {
   return kNoPayloadMethods.has(method);
 }
@@ -600,6 +617,7 @@ module.exports = {
   assertWithinRange,
   getDefaultSettings,
   getSessionState,
+  getPseudoHeader,
   getSettings,
   getStreamState,
   isPayloadMeaningless,
@@ -1,6 +1,7 @@
 'use strict';
 
 const {
+  ObjectPrototypeHasOwnProperty,
   RegExp,
   Symbol,
 } = primordials;
@@ -8,6 +9,13 @@ const {
 const Buffer = require('buffer').Buffer;
 const { writeBuffer } = internalBinding('fs');
 const errors = require('internal/errors');
+const {
+  ERR_INVALID_ARG_VALUE
+} = errors.codes;
+const {
+  validateBoolean,
+  validateInt32
+} = require('internal/validators');
 
 // IPv4 Segment
 const v4Seg = '(?:[0-9]|[1-9][0-9]|1[0-9][0-9]|2[0-4][0-9]|25[0-5])';
@@ -59,10 +67,80 @@ function makeSyncWrite(fd) {
   };
 }
 
+// The socket options supported by setSocketOption() and getSocketOption(),
+// the type of their values and whether they apply to UDP sockets.
+const socketOptions = {
+  TCP_NOTSENT_LOWAT: { boolean: false, udp: false },
+  TCP_USER_TIMEOUT: { boolean: false, udp: false },
+  TCP_QUICKACK: { boolean: true, udp: false },
+  SO_BUSY_POLL: { boolean: false, udp: true },
+  TCP_FASTOPEN: { boolean: false, udp: false },
+  TCP_FASTOPEN_CONNECT: { boolean: true, udp: false },
+  TCP_DEFER_ACCEPT: { boolean: false, udp: false },
+};
+
+// Must be kept in sync with TCP_INFO_FIELDS in src/socket_options.h.
+const tcpInfoFields = [
+  'state',
+  'rtt',
+  'rttVariance',
+  'rto',
+  'retransmits',
+  'totalRetransmits',
+  'congestionWindow',
+  'slowStartThreshold',
+  'mss',
+  'unacked',
+  'lost',
+];
+
+// Lazily loaded, so that users of isIP() such as `dns` do not need the
+// tcp_wrap binding.
+let socketOptionIds;
+
+function getSocketOption(option, udp) {
+  if (socketOptionIds === undefined)
+    socketOptionIds = internalBinding('tcp_wrap').constants.socketOptions;
+  if (!ObjectPrototypeHasOwnProperty(socketOptions, option) ||
+      (udp && !socketOptions[option].udp)) {
+    throw new ERR_INVALID_ARG_VALUE('option', option,
+                                    'is not a supported socket option');
+  }
+  return socketOptions[option];
+}
+
+// Validates `value` and returns the id and the numeric value of `option`,
+// in the form that the setSocketOption() methods of handles accept.
+function toSocketOption(option, value, udp) {
+  if (getSocketOption(option, udp).boolean) {
+    validateBoolean(value, 'value');
+    value = value ? 1 : 0;
+  } else {
+    validateInt32(value, 'value', 0);
+  }
+  return { id: socketOptionIds[option], value };
+}
+
+function socketOptionId(option, udp) {
+  getSocketOption(option, udp);
+  return socketOptionIds[option];
+}
+
+function fromSocketOptionValue(option, value) {
+  return socketOptions[option].boolean ? value !== 0 : value;
+}
+
 module.exports = {
+  fromSocketOptionValue,
   isIP,
   isIPv4,
   isIPv6,
   makeSyncWrite,
-  normalizedArgsSymbol: Symbol('normalizedArgs')
+  socketOptionId,
+  tcpInfoFields,
+  toSocketOption,
+  normalizedArgsSymbol: Symbol('normalizedArgs'),
+  // Method of net.Socket and net.Server that returns the handle to transfer
+  // when the object is listed in the transferList of postMessage().
+  transferHandleSymbol: Symbol('transferHandle')
 };
@@ -26,10 +26,12 @@ const { owner_symbol } = require('internal/async_hooks').symbols;
 const {
   kTimeout,
   setUnrefTimeout,
+  setUnrefWheelTimeout,
   getTimerDuration
 } = require('internal/timers');
 const { isUint8Array } = require('internal/util/types');
 const { clearTimeout } = require('timers');
+const { getOptionValue } = require('internal/options');
 
 const kMaybeDestroy = Symbol('kMaybeDestroy');
 const kUpdateTimer = Symbol('kUpdateTimer');
@@ -38,6 +40,9 @@ const kHandle = Symbol('kHandle');
 const kSession = Symbol('kSession');
 
 const debug = require('internal/util/debuglog').debuglog('stream');
+
+// Lazily initialized from --experimental-timer-wheel.
+let useTimerWheel;
 const kBuffer = Symbol('kBuffer');
 const kBufferGen = Symbol('kBufferGen');
 const kBufferCb = Symbol('kBufferCb');
@@ -221,6 +226,12 @@ function onStreamRead(arrayBuffer) {
   }
 }
 
+function onStreamIdleTimeout() {
+  const stream = this[owner_symbol];
+  if (stream)
+    stream._onTimeout();
+}
+
 function setStreamTimeout(msecs, callback) {
   if (this.destroyed)
     return;
@@ -234,6 +245,19 @@ function setStreamTimeout(msecs, callback) {
   //  even if it will be rescheduled we don't want to leak an existing timer.
   clearTimeout(this[kTimeout]);
 
+  if (useTimerWheel === undefined)
+    useTimerWheel = getOptionValue('--experimental-timer-wheel');
+
+  // TCP and pipe handles keep track of their idle time in C++, so that no JS
+  // timer needs to be refreshed on every read and write.
+  const handle = this._handle;
+  const isNative = !useTimerWheel && handle != null &&
+                   handle.setIdleTimeout !== undefined;
+  if (isNative) {
+    this[kTimeout] = null;
+    handle.setIdleTimeout(msecs);
+  }
+
   if (msecs === 0) {
     if (callback !== undefined) {
       if (typeof callback !== 'function')
@@ -241,7 +265,13 @@ function setStreamTimeout(msecs, callback) {
       this.removeListener('timeout', callback);
     }
   } else {
-    this[kTimeout] = setUnrefTimeout(this._onTimeout.bind(this), msecs);
+    if (isNative) {
+      handle.ontimeout = onStreamIdleTimeout;
+    } else {
+      this[kTimeout] = useTimerWheel ?
+        setUnrefWheelTimeout(this._onTimeout.bind(this), msecs) :
+        setUnrefTimeout(this._onTimeout.bind(this), msecs);
+    }
     if (this[kSession]) this[kSession][kUpdateTimer]();
 
     if (callback !== undefined) {
@@ -84,7 +84,8 @@ const {
   scheduleTimer,
   toggleTimerRef,
   getLibuvNow,
-  immediateInfo
+  immediateInfo,
+  TimerWheel
 } = internalBinding('timers');
 
 const {
@@ -371,6 +372,106 @@ function setUnrefTimeout(callback, after) {
   return timer;
 }
 
+// Unrefed timeouts that live in a native TimerWheel instead of the timer
+// lists. These are used for the idle timeouts of sockets when
+// --experimental-timer-wheel is set, see setStreamTimeout().
+const kWheelResolution = 10;
+const kWheelId = Symbol('wheelId');
+let timerWheel = null;
+// Maps the ids handed out by the wheel to WheelTimeout instances.
+const wheelTimeouts = [];
+
+function WheelTimeout(callback, after) {
+  if (timerWheel === null) {
+    timerWheel = new TimerWheel(kWheelResolution);
+    timerWheel.ontimeout = onWheelTimeouts;
+  }
+
+  this._idleTimeout = after;
+  this._onTimeout = callback;
+  this._destroyed = false;
+  this[kWheelId] = timerWheel.add(after);
+  wheelTimeouts[this[kWheelId]] = this;
+
+  initAsyncResource(this, 'Timeout');
+}
+
+WheelTimeout.prototype.refresh = function() {
+  if (!this._destroyed)
+    timerWheel.refresh(this[kWheelId]);
+  return this;
+};
+
+WheelTimeout.prototype.hasRef = function() {
+  return false;
+};
+
+// Called by clearTimeout().
+function unenrollWheelTimeout(timer) {
+  if (timer._destroyed)
+    return;
+
+  timer._destroyed = true;
+  if (destroyHooksExist())
+    emitDestroy(timer[async_id_symbol]);
+
+  const id = timer[kWheelId];
+  timerWheel.remove(id);
+  wheelTimeouts[id] = undefined;
+  timer._idleTimeout = -1;
+}
+
+// Called with the ids of all timeouts that expired within the same tick of
+// the wheel. Unlike the timers in the timer lists, these are not destroyed
+// after they fire, so that they can be refreshed on later socket activity.
+function onWheelTimeouts(ids) {
+  let i = 0;
+  try {
+    for (; i < ids.length; i++)
+      runWheelTimeout(wheelTimeouts[ids[i]]);
+  } finally {
+    // If one of the callbacks threw, the others still need to run. The wheel
+    // may hand out the ids of removed timeouts again once this returns, so
+    // look up the remaining timeouts now.
+    if (i < ids.length - 1) {
+      const rest = [];
+      for (let j = i + 1; j < ids.length; j++)
+        rest.push(wheelTimeouts[ids[j]]);
+      process.nextTick(runWheelTimeouts, rest);
+    }
+  }
+}
+
+function runWheelTimeouts(timers, start = 0) {
+  let i = start;
+  try {
+    for (; i < timers.length; i++)
+      runWheelTimeout(timers[i]);
+  } finally {
+    if (i < timers.length - 1)
+      process.nextTick(runWheelTimeouts, timers, i + 1);
+  }
+}
+
+function runWheelTimeout(timer) {
+  if (timer === undefined || timer._destroyed || !timer._onTimeout)
+    return;
+
+  const asyncId = timer[async_id_symbol];
+  emitBefore(asyncId, timer[trigger_async_id_symbol], timer);
+  timer._onTimeout();
+  emitAfter(asyncId);
+}
+
+function setUnrefWheelTimeout(callback, after) {
+  // Type checking identical to setTimeout()
+  if (typeof callback !== 'function') {
+    throw new ERR_INVALID_CALLBACK(callback);
+  }
+
+  return new WheelTimeout(callback, after);
+}
+
 // Type checking used by timers.enroll() and Socket#setTimeout()
 function getTimerDuration(msecs, name) {
   validateNumber(msecs, name);
@@ -597,6 +698,9 @@ module.exports = {
   kRefed,
   initAsyncResource,
   setUnrefTimeout,
+  WheelTimeout,
+  setUnrefWheelTimeout,
+  unenrollWheelTimeout,
   getTimerDuration,
   immediateQueue,
   getTimerCallbacks,
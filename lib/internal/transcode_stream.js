@@ -0,0 +1,97 @@
+'use strict';
+
+const {
+  ObjectSetPrototypeOf,
+  Symbol,
+} = primordials;
+
+const {
+  ERR_ENCODING_NOT_SUPPORTED
+} = require('internal/errors').codes;
+const { normalizeEncoding } = require('internal/util');
+const { validateObject, validateString } = require('internal/validators');
+const { Transform } = require('stream');
+const {
+  getTranscoder,
+  hasConverter,
+  icuErrName,
+  transcodeChunk
+} = internalBinding('icu');
+
+const kHandle = Symbol('kHandle');
+
+// Must match TranscoderObject::TranscoderFlags in src/node_i18n.cc.
+const kFlush = 0x1;
+const kFatal = 0x2;
+
+// ICU names of the encodings that Node.js knows under a different name.
+const converterNames = {
+  __proto__: null,
+  ascii: 'us-ascii',
+  latin1: 'iso8859-1',
+  utf16le: 'utf16le',
+  utf8: 'utf-8'
+};
+
+function getConverterName(encoding, name) {
+  validateString(encoding, name);
+  const normalized = normalizeEncoding(encoding);
+  if (normalized !== undefined && converterNames[normalized] !== undefined)
+    return converterNames[normalized];
+  if (!hasConverter(encoding))
+    throw new ERR_ENCODING_NOT_SUPPORTED(encoding);
+  return encoding;
+}
+
+function transcodeError(status) {
+  const code = icuErrName(status);
+  // eslint-disable-next-line no-restricted-syntax
+  const err = new Error(`Unable to transcode Buffer [${code}]`);
+  err.code = code;
+  err.errno = status;
+  return err;
+}
+
+function TranscodeStream(fromEncoding, toEncoding, options) {
+  if (!(this instanceof TranscodeStream))
+    return new TranscodeStream(fromEncoding, toEncoding, options);
+
+  const from = getConverterName(fromEncoding, 'fromEnc');
+  const to = getConverterName(toEncoding, 'toEnc');
+  if (options === undefined) {
+    options = {};
+  } else {
+    validateObject(options, 'options');
+  }
+
+  const handle = getTranscoder(from, to, options.fatal ? kFatal : 0);
+  if (typeof handle === 'number')
+    throw transcodeError(handle);
+
+  Transform.call(this, options);
+  this[kHandle] = handle;
+}
+ObjectSetPrototypeOf(TranscodeStream.prototype, Transform.prototype);
+ObjectSetPrototypeOf(TranscodeStream, Transform);
+
+function pushResult(stream, result, callback) {
+  if (typeof result === 'number')
+    return callback(transcodeError(result));
+  if (result.length > 0)
+    stream.push(result);
+  callback();
+}
+
+TranscodeStream.prototype._transform = function(chunk, encoding, callback) {
+  pushResult(this, transcodeChunk(this[kHandle], chunk, 0), callback);
+};
+
+TranscodeStream.prototype._flush = function(callback) {
+  pushResult(this,
+             transcodeChunk(this[kHandle], new Uint8Array(0), kFlush),
+             callback);
+};
+
+module.exports = {
+  TranscodeStream
+};
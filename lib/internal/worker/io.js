@@ -1,12 +1,15 @@
 'use strict';
 
 const {
+  ArrayIsArray,
+  ArrayPrototypeSlice,
   ObjectAssign,
   ObjectCreate,
   ObjectDefineProperty,
   ObjectGetOwnPropertyDescriptors,
   ObjectGetPrototypeOf,
   ObjectSetPrototypeOf,
+  ReflectApply,
   Symbol,
 } = primordials;
 
@@ -28,6 +31,7 @@ const {
   getEnvMessagePort
 } = internalBinding('worker');
 
+const { transferHandleSymbol } = require('internal/net');
 const { Readable, Writable } = require('stream');
 const EventEmitter = require('events');
 const { inspect } = require('internal/util/inspect');
@@ -67,6 +71,34 @@ ObjectSetPrototypeOf(MessagePort.prototype, EventEmitter.prototype);
 MessagePort.prototype.ref = MessagePortPrototype.ref;
 MessagePort.prototype.unref = MessagePortPrototype.unref;
 
+// net.Socket and net.Server instances can be listed in the transfer list in
+// place of their handles. They are replaced with their handles, and so is
+// `value` if it is one of them.
+MessagePort.prototype.postMessage = function postMessage(value, transferList) {
+  let list;
+  if (ArrayIsArray(transferList))
+    list = transferList;
+  else if (transferList != null && ArrayIsArray(transferList.transfer))
+    list = transferList.transfer;
+  if (list === undefined)
+    return ReflectApply(MessagePortPrototype.postMessage, this, arguments);
+
+  let handles;
+  for (let i = 0; i < list.length; i++) {
+    const entry = list[i];
+    if (entry == null || typeof entry[transferHandleSymbol] !== 'function')
+      continue;
+    if (handles === undefined)
+      handles = ArrayPrototypeSlice(list);
+    handles[i] = entry[transferHandleSymbol]();
+    if (value === entry)
+      value = handles[i];
+  }
+  if (handles === undefined)
+    return ReflectApply(MessagePortPrototype.postMessage, this, arguments);
+  return MessagePortPrototype.postMessage.call(this, value, handles);
+};
+
 // A communication channel consisting of a handle (that wraps around an
 // uv_async_t) which can receive information from other threads and emits
 // .onmessage events, and a function used for sending data to a MessagePort
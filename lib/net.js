@@ -25,6 +25,7 @@ const {
   ArrayIsArray,
   Boolean,
   Error,
+  Float64Array,
   Number,
   NumberIsNaN,
   ObjectDefineProperty,
@@ -38,22 +39,30 @@ const { inspect } = require('internal/util/inspect');
 const debug = require('internal/util/debuglog').debuglog('net');
 const { deprecate } = require('internal/util');
 const {
+  fromSocketOptionValue,
   isIP,
   isIPv4,
   isIPv6,
   normalizedArgsSymbol,
-  makeSyncWrite
+  makeSyncWrite,
+  socketOptionId,
+  tcpInfoFields,
+  toSocketOption,
+  transferHandleSymbol
 } = require('internal/net');
 const assert = require('internal/assert');
 const {
   UV_EADDRINUSE,
+  UV_EBADF,
   UV_EINVAL,
-  UV_ENOTCONN
+  UV_ENOTCONN,
+  UV_ENOTSUP
 } = internalBinding('uv');
 
 const { Buffer } = require('buffer');
 const { guessHandleType } = internalBinding('util');
 const { ShutdownWrap } = internalBinding('stream_wrap');
+const { StreamPipe } = internalBinding('stream_pipe');
 const {
   TCP,
   TCPConnectWrap,
@@ -86,6 +95,7 @@ const {
     ERR_INVALID_ADDRESS_FAMILY,
     ERR_INVALID_ARG_TYPE,
     ERR_INVALID_ARG_VALUE,
+    ERR_INVALID_CALLBACK,
     ERR_INVALID_FD_TYPE,
     ERR_INVALID_IP_ADDRESS,
     ERR_INVALID_OPT_VALUE,
@@ -95,6 +105,7 @@ const {
   },
   errnoException,
   exceptionWithHostPort,
+  uvException,
   uvExceptionWithHostPort
 } = require('internal/errors');
 const { isUint8Array } = require('internal/util/types');
@@ -104,6 +115,7 @@ const {
   validateString
 } = require('internal/validators');
 const kLastWriteQueueSize = Symbol('lastWriteQueueSize');
+const kPendingSocketOptions = Symbol('pendingSocketOptions');
 const {
   DTRACE_NET_SERVER_CONNECTION,
   DTRACE_NET_STREAM_END
@@ -115,14 +127,20 @@ let dns;
 
 const { clearTimeout } = require('timers');
 const { kTimeout } = require('internal/timers');
+const { Histogram } = require('internal/histogram');
 
 const DEFAULT_IPV4_ADDR = '0.0.0.0';
 const DEFAULT_IPV6_ADDR = '::';
 
 function noop() {}
 
-function getFlags(ipv6Only) {
-  return ipv6Only === true ? TCPConstants.UV_TCP_IPV6ONLY : 0;
+function getFlags(ipv6Only, reusePort) {
+  let flags = 0;
+  if (ipv6Only === true)
+    flags |= TCPConstants.UV_TCP_IPV6ONLY;
+  if (reusePort === true)
+    flags |= TCPConstants.kBindReusePort;
+  return flags;
 }
 
 function createHandle(fd, is_server) {
@@ -240,6 +258,7 @@ function initSocketHandle(self) {
   if (self._handle) {
     self._handle[owner_symbol] = self;
     self._handle.onread = onStreamRead;
+    self._handle.ontransfer = onHandleTransfer;
     self[async_id_symbol] = getNewAsyncId(self._handle);
 
     let userBuf = self[kBuffer];
@@ -260,6 +279,9 @@ function initSocketHandle(self) {
 const kBytesRead = Symbol('kBytesRead');
 const kBytesWritten = Symbol('kBytesWritten');
 const kSetNoDelay = Symbol('kSetNoDelay');
+const kOnRead = Symbol('kOnRead');
+const kAcceptBatching = Symbol('kAcceptBatching');
+const kAcceptMetrics = Symbol('kAcceptMetrics');
 
 function Socket(options) {
   if (!(this instanceof Socket)) return new Socket(options);
@@ -299,58 +321,57 @@ function Socket(options) {
   // Default to *not* allowing half open sockets.
   this.allowHalfOpen = Boolean(allowHalfOpen);
 
+  const onread = options.onread;
+  if (onread !== null && typeof onread === 'object' &&
+      (isUint8Array(onread.buffer) || typeof onread.buffer === 'function') &&
+      typeof onread.callback === 'function') {
+    if (typeof onread.buffer === 'function') {
+      this[kBuffer] = true;
+      this[kBufferGen] = onread.buffer;
+    } else {
+      this[kBuffer] = onread.buffer;
+    }
+    this[kBufferCb] = onread.callback;
+  }
+
   if (options.handle) {
     this._handle = options.handle; // private
     this[async_id_symbol] = getNewAsyncId(this._handle);
-  } else {
-    const onread = options.onread;
-    if (onread !== null && typeof onread === 'object' &&
-        (isUint8Array(onread.buffer) || typeof onread.buffer === 'function') &&
-        typeof onread.callback === 'function') {
-      if (typeof onread.buffer === 'function') {
-        this[kBuffer] = true;
-        this[kBufferGen] = onread.buffer;
-      } else {
-        this[kBuffer] = onread.buffer;
-      }
-      this[kBufferCb] = onread.callback;
-    }
-    if (options.fd !== undefined) {
-      const { fd } = options;
-      let err;
+  } else if (options.fd !== undefined) {
+    const { fd } = options;
+    let err;
 
-      // createHandle will throw ERR_INVALID_FD_TYPE if `fd` is not
-      // a valid `PIPE` or `TCP` descriptor
-      this._handle = createHandle(fd, false);
+    // createHandle will throw ERR_INVALID_FD_TYPE if `fd` is not
+    // a valid `PIPE` or `TCP` descriptor
+    this._handle = createHandle(fd, false);
 
-      err = this._handle.open(fd);
+    err = this._handle.open(fd);
 
-      // While difficult to fabricate, in some architectures
-      // `open` may return an error code for valid file descriptors
-      // which cannot be opened. This is difficult to test as most
-      // un-openable fds will throw on `createHandle`
+    // While difficult to fabricate, in some architectures
+    // `open` may return an error code for valid file descriptors
+    // which cannot be opened. This is difficult to test as most
+    // un-openable fds will throw on `createHandle`
+    if (err)
+      throw errnoException(err, 'open');
+
+    this[async_id_symbol] = this._handle.getAsyncId();
+
+    if ((fd === 1 || fd === 2) &&
+        (this._handle instanceof Pipe) &&
+        process.platform === 'win32') {
+      // Make stdout and stderr blocking on Windows
+      err = this._handle.setBlocking(true);
       if (err)
-        throw errnoException(err, 'open');
-
-      this[async_id_symbol] = this._handle.getAsyncId();
-
-      if ((fd === 1 || fd === 2) &&
-          (this._handle instanceof Pipe) &&
-          process.platform === 'win32') {
-        // Make stdout and stderr blocking on Windows
-        err = this._handle.setBlocking(true);
-        if (err)
-          throw errnoException(err, 'setBlocking');
-
-        this._writev = null;
-        this._write = makeSyncWrite(fd);
-        // makeSyncWrite adjusts this value like the original handle would, so
-        // we need to let it do that by turning it into a writable, own
-        // property.
-        ObjectDefineProperty(this._handle, 'bytesWritten', {
-          value: 0, writable: true
-        });
-      }
+        throw errnoException(err, 'setBlocking');
+
+      this._writev = null;
+      this._write = makeSyncWrite(fd);
+      // makeSyncWrite adjusts this value like the original handle would, so
+      // we need to let it do that by turning it into a writable, own
+      // property.
+      ObjectDefineProperty(this._handle, 'bytesWritten', {
+        value: 0, writable: true
+      });
     }
   }
 
@@ -472,7 +493,10 @@ Socket.prototype._onTimeout = function() {
     const { writeQueueSize } = handle;
     if (lastWriteQueueSize !== writeQueueSize) {
       this[kLastWriteQueueSize] = writeQueueSize;
-      this._unrefTimer();
+      if (this[kTimeout] === null && handle.refreshIdleTimeout !== undefined)
+        handle.refreshIdleTimeout();
+      else
+        this._unrefTimer();
       return;
     }
   }
@@ -512,6 +536,170 @@ Socket.prototype.setKeepAlive = function(setting, msecs) {
 };
 
 
+Socket.prototype.setWriteCoalescing = function(enable) {
+  if (!this._handle) {
+    this.once('connect', () => this.setWriteCoalescing(enable));
+    return this;
+  }
+
+  if (this._handle.setWriteCoalescing)
+    this._handle.setWriteCoalescing(enable === undefined ? true : !!enable);
+
+  return this;
+};
+
+
+Socket.prototype.getWriteCoalescingStats = function() {
+  const handle = this._handle;
+  if (!handle || handle.coalescedWrites === undefined)
+    return { coalescedWrites: 0, flushes: 0, syscallsSaved: 0 };
+  const coalescedWrites = handle.coalescedWrites;
+  const flushes = handle.coalescedFlushes;
+  return {
+    coalescedWrites,
+    flushes,
+    syscallsSaved: coalescedWrites - flushes
+  };
+};
+
+
+function setHandleSocketOption(handle, id, value) {
+  if (!handle || handle.setSocketOption === undefined)
+    return handle ? UV_ENOTSUP : UV_EBADF;
+  return handle.setSocketOption(id, value);
+}
+
+function getHandleSocketOption(handle, option) {
+  const id = socketOptionId(option, false);
+  if (!handle || handle.getSocketOption === undefined)
+    throw errnoException(handle ? UV_ENOTSUP : UV_EBADF, 'getsockopt');
+  const ctx = {};
+  const value = handle.getSocketOption(id, ctx);
+  if (value === undefined)
+    throw uvException(ctx);
+  return fromSocketOptionValue(option, value);
+}
+
+
+Socket.prototype.setSocketOption = function(option, value) {
+  const opt = toSocketOption(option, value, false);
+
+  // Options that are set before the socket is connected are applied right
+  // before connecting, by connect() or by the handle.
+  if (!this._handle) {
+    if (this[kPendingSocketOptions] === undefined)
+      this[kPendingSocketOptions] = [];
+    this[kPendingSocketOptions].push(opt);
+    return this;
+  }
+
+  const err = setHandleSocketOption(this._handle, opt.id, opt.value);
+  if (err)
+    throw errnoException(err, 'setsockopt');
+  return this;
+};
+
+
+Socket.prototype.getSocketOption = function(option) {
+  return getHandleSocketOption(this._handle, option);
+};
+
+
+// Reused by all calls to getTCPInfo().
+let tcpInfoArray;
+
+Socket.prototype.getTCPInfo = function() {
+  const handle = this._handle;
+  if (!handle || handle.getTCPInfo === undefined)
+    throw errnoException(handle ? UV_ENOTSUP : UV_EBADF, 'getsockopt');
+  if (tcpInfoArray === undefined)
+    tcpInfoArray = new Float64Array(tcpInfoFields.length);
+  const err = handle.getTCPInfo(tcpInfoArray);
+  if (err)
+    throw errnoException(err, 'getsockopt');
+  const info = {};
+  for (let i = 0; i < tcpInfoFields.length; i++)
+    info[tcpInfoFields[i]] = tcpInfoArray[i];
+  return info;
+};
+
+
+Socket.prototype.pipeNative = function(destination, callback) {
+  if (!(destination instanceof Socket))
+    throw new ERR_INVALID_ARG_TYPE('destination', 'net.Socket', destination);
+  if (callback !== undefined && typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK(callback);
+
+  if (this.connecting || destination.connecting) {
+    const pending = this.connecting ? this : destination;
+    pending.once('connect', () => this.pipeNative(destination, callback));
+    return destination;
+  }
+
+  if (!this._handle || !destination._handle)
+    throw new ERR_SOCKET_CLOSED();
+
+  // From now on, the pipe decides when to read from the source.
+  this._handle.reading = true;
+  this._handle.readStop();
+
+  // Data that has already made it into JS land is written first. The pipe is
+  // only started once all writes made from JS land have completed.
+  let chunk;
+  while ((chunk = this.read()) !== null)
+    destination.write(chunk);
+  if (destination.writableLength > 0) {
+    destination.once('drain',
+                     () => startNativePipe(this, destination, callback));
+  } else {
+    startNativePipe(this, destination, callback);
+  }
+
+  return destination;
+};
+
+function startNativePipe(source, destination, callback) {
+  if (!source._handle || !destination._handle) {
+    const ex = new ERR_SOCKET_CLOSED();
+    if (callback)
+      process.nextTick(callback, ex, 0);
+    return;
+  }
+
+  const pipe = new StreamPipe(source._handle, destination._handle);
+  pipe.onunpipe = onNativeUnpipe;
+  pipe.callback = callback;
+  pipe.start();
+  // Let the source emit 'end' once the pipe has reached EOF.
+  source.resume();
+}
+
+function onNativeUnpipe(err) {
+  const source = this.source[owner_symbol];
+  const destination = this.sink[owner_symbol];
+  const bytesTransferred = this.bytesTransferred();
+  const callback = this.callback;
+
+  if (err !== 0) {
+    const ex = errnoException(err, 'pipe');
+    source.destroy();
+    if (callback) {
+      destination.destroy();
+      callback(ex, bytesTransferred);
+    } else {
+      destination.destroy(ex);
+    }
+    return;
+  }
+
+  // The sink has already been shut down natively; this only brings its
+  // JS state up to date.
+  destination.end();
+  if (callback)
+    callback(null, bytesTransferred);
+}
+
+
 Socket.prototype.address = function() {
   return this._getsockname();
 };
@@ -530,6 +718,14 @@ ObjectDefineProperty(Socket.prototype, 'pending', {
   configurable: true
 });
 
+// Sockets and servers can be listed in the transferList of postMessage() to
+// move their handles to another thread.
+function getTransferHandle() {
+  return this._handle;
+}
+
+Socket.prototype[transferHandleSymbol] = getTransferHandle;
+
 
 ObjectDefineProperty(Socket.prototype, 'readyState', {
   get: function() {
@@ -688,6 +884,26 @@ Socket.prototype._destroy = function(exception, cb) {
   }
 };
 
+// Called once a handle that was transferred to another thread through
+// postMessage() has been closed on this thread.
+function onHandleTransfer() {
+  const self = this[owner_symbol];
+  if (self === undefined || self._handle !== this)
+    return;
+
+  if (self instanceof Server) {
+    self._handle = null;
+    self.close();
+    return;
+  }
+
+  self[kBytesRead] = this.bytesRead;
+  self[kBytesWritten] = this.bytesWritten;
+  self._handle = null;
+  self._sockname = null;
+  self.destroy();
+}
+
 Socket.prototype._getpeername = function() {
   if (!this._peername) {
     if (!this._handle || !this._handle.getpeername) {
@@ -957,6 +1173,18 @@ Socket.prototype.connect = function(...args) {
     initSocketHandle(this);
   }
 
+  const pendingSocketOptions = this[kPendingSocketOptions];
+  if (pendingSocketOptions !== undefined) {
+    this[kPendingSocketOptions] = undefined;
+    for (const { id, value } of pendingSocketOptions) {
+      const err = setHandleSocketOption(this._handle, id, value);
+      if (err) {
+        this.destroy(errnoException(err, 'setsockopt'));
+        return this;
+      }
+    }
+  }
+
   if (cb !== null) {
     this.once('connect', cb);
   }
@@ -1198,6 +1426,9 @@ function Server(options, connectionListener) {
 
   this.allowHalfOpen = options.allowHalfOpen || false;
   this.pauseOnConnect = !!options.pauseOnConnect;
+  this[kOnRead] = options.onread;
+  this[kAcceptBatching] = !!options.acceptBatching;
+  this[kAcceptMetrics] = options.acceptMetrics ? null : undefined;
 }
 ObjectSetPrototypeOf(Server.prototype, EventEmitter.prototype);
 ObjectSetPrototypeOf(Server, EventEmitter);
@@ -1247,12 +1478,13 @@ function createServerHandle(address, port, addressType, fd, flags) {
       if (err) {
         handle.close();
         // Fallback to ipv4
-        return createServerHandle(DEFAULT_IPV4_ADDR, port);
+        return createServerHandle(DEFAULT_IPV4_ADDR, port, undefined,
+                                  undefined, flags);
       }
     } else if (addressType === 6) {
       err = handle.bind6(address, port, flags);
     } else {
-      err = handle.bind(address, port);
+      err = handle.bind(address, port, flags & TCPConstants.kBindReusePort);
     }
   }
 
@@ -1303,8 +1535,22 @@ function setupListenHandle(address, port, addressType, backlog, fd, flags) {
 
   this[async_id_symbol] = getNewAsyncId(this._handle);
   this._handle.onconnection = onconnection;
+  this._handle.ontransfer = onHandleTransfer;
   this._handle[owner_symbol] = this;
 
+  // Handles of cluster workers that use round-robin scheduling are not real
+  // server handles and do not support these.
+  if (this[kAcceptBatching] && this._handle.setAcceptBatching !== undefined)
+    this._handle.setAcceptBatching(true);
+  if (this[kAcceptMetrics] !== undefined &&
+      this._handle.enableAcceptMetrics !== undefined) {
+    const [backlog, latency] = this._handle.enableAcceptMetrics();
+    this[kAcceptMetrics] = {
+      backlog: new Histogram(backlog),
+      latency: new Histogram(latency)
+    };
+  }
+
   // Use a backlog of 512 entries. We pass 511 to the listen() call because
   // the kernel does: backlogsize = roundup_pow_of_two(backlogsize + 1);
   // which will thus give us a backlog of 512 entries.
@@ -1409,7 +1655,10 @@ Server.prototype.listen = function(...args) {
     toNumber(args.length > 2 && args[2]);  // (port, host, backlog)
 
   options = options._handle || options.handle || options;
-  const flags = getFlags(options.ipv6Only);
+  const flags = getFlags(options.ipv6Only, options.reusePort);
+  // With SO_REUSEPORT every cluster worker listens on a socket of its own and
+  // the kernel balances the connections, instead of going through the master.
+  const exclusive = options.exclusive || options.reusePort === true;
   // (handle[, backlog][, cb]) where handle is an object with a handle
   if (options instanceof TCP) {
     this._handle = options;
@@ -1442,11 +1691,12 @@ Server.prototype.listen = function(...args) {
     // start TCP server listening on host:port
     if (options.host) {
       lookupAndListen(this, options.port | 0, options.host, backlog,
-                      options.exclusive, flags);
+                      exclusive, flags);
     } else { // Undefined host, listens on unspecified address
       // Default addressType 4 will be used to search for master server
       listenInCluster(this, null, options.port | 0, 4,
-                      backlog, undefined, options.exclusive);
+                      backlog, undefined, exclusive,
+                      flags & TCPConstants.kBindReusePort);
     }
     return this;
   }
@@ -1510,6 +1760,8 @@ ObjectDefineProperty(Server.prototype, 'listening', {
   enumerable: true
 });
 
+Server.prototype[transferHandleSymbol] = getTransferHandle;
+
 Server.prototype.address = function() {
   if (this._handle && this._handle.getsockname) {
     const out = {};
@@ -1525,6 +1777,26 @@ Server.prototype.address = function() {
   }
 };
 
+Server.prototype.getAcceptMetrics = function() {
+  return this[kAcceptMetrics] || null;
+};
+
+Server.prototype.setSocketOption = function(option, value) {
+  const opt = toSocketOption(option, value, false);
+  if (!this._handle)
+    throw new ERR_SERVER_NOT_RUNNING();
+  const err = setHandleSocketOption(this._handle, opt.id, opt.value);
+  if (err)
+    throw errnoException(err, 'setsockopt');
+  return this;
+};
+
+Server.prototype.getSocketOption = function(option) {
+  if (!this._handle)
+    throw new ERR_SERVER_NOT_RUNNING();
+  return getHandleSocketOption(this._handle, option);
+};
+
 function onconnection(err, clientHandle) {
   const handle = this;
   const self = handle[owner_symbol];
@@ -1536,15 +1808,42 @@ function onconnection(err, clientHandle) {
     return;
   }
 
+  // With accept batching, all connections that were accepted in one
+  // iteration of the event loop are passed at once.
+  if (ArrayIsArray(clientHandle)) {
+    const sockets = [];
+    for (let i = 0; i < clientHandle.length; i++) {
+      const socket = createServerSocket(self, clientHandle[i]);
+      if (socket !== null)
+        sockets.push(socket);
+    }
+    if (sockets.length === 0)
+      return;
+    if (self.listenerCount('connections') > 0) {
+      self.emit('connections', sockets);
+    } else {
+      for (let i = 0; i < sockets.length; i++)
+        self.emit('connection', sockets[i]);
+    }
+    return;
+  }
+
+  const socket = createServerSocket(self, clientHandle);
+  if (socket !== null)
+    self.emit('connection', socket);
+}
+
+function createServerSocket(self, clientHandle) {
   if (self.maxConnections && self._connections >= self.maxConnections) {
     clientHandle.close();
-    return;
+    return null;
   }
 
   const socket = new Socket({
     handle: clientHandle,
     allowHalfOpen: self.allowHalfOpen,
     pauseOnCreate: self.pauseOnConnect,
+    onread: self[kOnRead],
     readable: true,
     writable: true
   });
@@ -1554,7 +1853,7 @@ function onconnection(err, clientHandle) {
   socket._server = self;
 
   DTRACE_NET_SERVER_CONNECTION(socket);
-  self.emit('connection', socket);
+  return socket;
 }
 
 
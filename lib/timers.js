@@ -34,6 +34,8 @@ const L = require('internal/linkedlist');
 const {
   async_id_symbol,
   Timeout,
+  WheelTimeout,
+  unenrollWheelTimeout,
   decRefCount,
   immediateInfoFields: {
     kCount,
@@ -160,7 +162,10 @@ setTimeout[customPromisify] = function(after, value) {
 function clearTimeout(timer) {
   if (timer && timer._onTimeout) {
     timer._onTimeout = null;
-    unenroll(timer);
+    if (timer instanceof WheelTimeout)
+      unenrollWheelTimeout(timer);
+    else
+      unenroll(timer);
   }
 }
 
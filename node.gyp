@@ -140,6 +140,8 @@
       'lib/internal/fs/utils.js',
       'lib/internal/fs/watchers.js',
       'lib/internal/http.js',
+      'lib/internal/http/fast_server.js',
+      'lib/internal/http/pool_agent.js',
       'lib/internal/heap_utils.js',
       'lib/internal/histogram.js',
       'lib/internal/idna.js',
@@ -198,6 +200,7 @@
       'lib/internal/tls.js',
       'lib/internal/trace_events_async_hooks.js',
       'lib/internal/tty.js',
+      'lib/internal/transcode_stream.js',
       'lib/internal/url.js',
       'lib/internal/util.js',
       'lib/internal/util/comparisons.js',
@@ -579,6 +582,7 @@
         'src/node_http_parser.cc',
         'src/node_http2.cc',
         'src/node_i18n.cc',
+        'src/node_json.cc',
         'src/node_main_instance.cc',
         'src/node_messaging.cc',
         'src/node_metadata.cc',
@@ -612,6 +616,7 @@
         'src/pipe_wrap.cc',
         'src/process_wrap.cc',
         'src/signal_wrap.cc',
+        'src/socket_options.cc',
         'src/spawn_sync.cc',
         'src/stream_base.cc',
         'src/stream_pipe.cc',
@@ -619,6 +624,7 @@
         'src/string_bytes.cc',
         'src/string_decoder.cc',
         'src/tcp_wrap.cc',
+        'src/timer_wheel.cc',
         'src/timers.cc',
         'src/tracing/agent.cc',
         'src/tracing/node_trace_buffer.cc',
@@ -701,6 +707,7 @@
         'src/pipe_wrap.h',
         'src/req_wrap.h',
         'src/req_wrap-inl.h',
+        'src/socket_options.h',
         'src/spawn_sync.h',
         'src/stream_base.h',
         'src/stream_base-inl.h',
@@ -711,6 +718,7 @@
         'src/string_decoder-inl.h',
         'src/string_search.h',
         'src/tcp_wrap.h',
+        'src/timer_wheel.h',
         'src/tracing/agent.h',
         'src/tracing/node_trace_buffer.h',
         'src/tracing/node_trace_writer.h',
@@ -858,12 +866,14 @@
             'src/node_crypto_common.cc',
             'src/node_crypto_bio.cc',
             'src/node_crypto_clienthello.cc',
+            'src/node_crypto_session_cache.cc',
             'src/node_crypto.h',
             'src/node_crypto_common.h',
             'src/node_crypto_bio.h',
             'src/node_crypto_clienthello.h',
             'src/node_crypto_clienthello-inl.h',
             'src/node_crypto_groups.h',
+            'src/node_crypto_session_cache.h',
             'src/tls_wrap.cc',
             'src/tls_wrap.h'
           ],
@@ -1162,6 +1172,7 @@
         'test/cctest/test_per_process.cc',
         'test/cctest/test_platform.cc',
         'test/cctest/test_report_util.cc',
+        'test/cctest/test_small_buffer_pool.cc',
         'test/cctest/test_sockaddr.cc',
         'test/cctest/test_traced_value.cc',
         'test/cctest/test_util.cc',
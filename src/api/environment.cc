@@ -1,3 +1,4 @@
+#include "memory_tracker-inl.h"
 #include "node.h"
 #include "node_context_data.h"
 #include "node_errors.h"
@@ -92,19 +93,78 @@ static void HostCleanupFinalizationGroupCallback(
   env->RegisterFinalizationGroupForCleanup(group);
 }
 
+namespace {
+// Set once the current thread's SmallBufferPool has been destroyed, so that
+// late Free() calls during thread or process teardown bypass the pool.
+thread_local bool small_buffer_pool_destroyed = false;
+
+struct SmallBufferPoolHolder {
+  ~SmallBufferPoolHolder() { small_buffer_pool_destroyed = true; }
+  SmallBufferPool pool;
+};
+
+thread_local SmallBufferPoolHolder small_buffer_pool_holder;
+}  // anonymous namespace
+
+SmallBufferPool::~SmallBufferPool() {
+  Clear();
+}
+
+SmallBufferPool* SmallBufferPool::ForCurrentThread() {
+  if (small_buffer_pool_destroyed) return nullptr;
+  return &small_buffer_pool_holder.pool;
+}
+
+void* SmallBufferPool::Get(size_t size) {
+  DCHECK(IsPooledSize(size));
+  const size_t index = SizeClass(size);
+  if (block_count_[index] == 0) return nullptr;
+  cached_bytes_ -= size_t{1} << (kMinSizeLog2 + index);
+  return blocks_[index][--block_count_[index]];
+}
+
+bool SmallBufferPool::Put(void* data, size_t size) {
+  DCHECK(IsPooledSize(size));
+  const size_t index = SizeClass(size);
+  if (block_count_[index] == kMaxBlocksPerClass) return false;
+  cached_bytes_ += size_t{1} << (kMinSizeLog2 + index);
+  blocks_[index][block_count_[index]++] = data;
+  return true;
+}
+
+void SmallBufferPool::Clear() {
+  for (size_t index = 0; index < kSizeClassCount; index++) {
+    while (block_count_[index] > 0)
+      free(blocks_[index][--block_count_[index]]);
+  }
+  cached_bytes_ = 0;
+}
+
+void SmallBufferPool::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("cached_blocks", cached_bytes_);
+}
+
 void* NodeArrayBufferAllocator::Allocate(size_t size) {
   void* ret;
-  if (zero_fill_field_ || per_process::cli_options->zero_fill_all_buffers)
+  const bool zero_fill =
+      zero_fill_field_ || per_process::cli_options->zero_fill_all_buffers;
+  if (SmallBufferPool::IsPooledSize(size)) {
+    ret = AllocatePooled(size);
+    if (LIKELY(ret != nullptr) && zero_fill)
+      memset(ret, 0, size);
+  } else if (zero_fill) {
     ret = UncheckedCalloc(size);
-  else
+  } else {
     ret = UncheckedMalloc(size);
+  }
   if (LIKELY(ret != nullptr))
     total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
   return ret;
 }
 
 void* NodeArrayBufferAllocator::AllocateUninitialized(size_t size) {
-  void* ret = node::UncheckedMalloc(size);
+  void* ret = SmallBufferPool::IsPooledSize(size) ?
+      AllocatePooled(size) : node::UncheckedMalloc(size);
   if (LIKELY(ret != nullptr))
     total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
   return ret;
@@ -112,7 +172,12 @@ void* NodeArrayBufferAllocator::AllocateUninitialized(size_t size) {
 
 void* NodeArrayBufferAllocator::Reallocate(
     void* data, size_t old_size, size_t size) {
-  void* ret = UncheckedRealloc<char>(static_cast<char*>(data), size);
+  // Keep the invariant that every block in the pooled size range has the
+  // full capacity of its size class, so that it can be recycled by Free().
+  const size_t capacity =
+      SmallBufferPool::IsPooledSize(size) ? SmallBufferPool::RoundUp(size) :
+                                            size;
+  void* ret = UncheckedRealloc<char>(static_cast<char*>(data), capacity);
   if (LIKELY(ret != nullptr) || UNLIKELY(size == 0))
     total_mem_usage_.fetch_add(size - old_size, std::memory_order_relaxed);
   return ret;
@@ -120,9 +185,23 @@ void* NodeArrayBufferAllocator::Reallocate(
 
 void NodeArrayBufferAllocator::Free(void* data, size_t size) {
   total_mem_usage_.fetch_sub(size, std::memory_order_relaxed);
+  if (data != nullptr && SmallBufferPool::IsPooledSize(size)) {
+    SmallBufferPool* pool = SmallBufferPool::ForCurrentThread();
+    if (pool != nullptr && pool->Put(data, size))
+      return;
+  }
   free(data);
 }
 
+void* NodeArrayBufferAllocator::AllocatePooled(size_t size) {
+  SmallBufferPool* pool = SmallBufferPool::ForCurrentThread();
+  if (pool != nullptr) {
+    void* ret = pool->Get(size);
+    if (ret != nullptr) return ret;
+  }
+  return node::UncheckedMalloc(SmallBufferPool::RoundUp(size));
+}
+
 DebuggingArrayBufferAllocator::~DebuggingArrayBufferAllocator() {
   CHECK(allocations_.empty());
 }
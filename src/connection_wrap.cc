@@ -2,22 +2,33 @@
 
 #include "connect_wrap.h"
 #include "env-inl.h"
+#include "histogram-inl.h"
 #include "pipe_wrap.h"
 #include "stream_base-inl.h"
 #include "stream_wrap.h"
 #include "tcp_wrap.h"
 #include "util-inl.h"
 
+#include <algorithm>
+
 namespace node {
 
+using v8::Array;
 using v8::Boolean;
 using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::Global;
 using v8::HandleScope;
 using v8::Integer;
 using v8::Local;
 using v8::Object;
 using v8::Value;
 
+// The ranges of the accept metrics: up to 1M connections per iteration of
+// the event loop, and latencies of up to one hour in nanoseconds.
+constexpr int64_t kMaxAcceptBurstSize = 1000000;
+constexpr int64_t kMaxAcceptLatency = 3600LL * 1000 * 1000 * 1000;
+
 
 template <typename WrapType, typename UVType>
 ConnectionWrap<WrapType, UVType>::ConnectionWrap(Environment* env,
@@ -65,15 +76,138 @@ void ConnectionWrap<WrapType, UVType>::OnConnection(uv_stream_t* handle,
 
     // Successful accept. Call the onconnection callback in JavaScript land.
     client_handle = client_obj;
+
+    if (wrap_data->accept_batching_ || wrap_data->accept_backlog_histogram_) {
+      // libuv accepts all pending connections before it returns to the event
+      // loop, so the burst ends in the following check phase.
+      if (!wrap_data->accept_burst_pending_) {
+        wrap_data->accept_burst_pending_ = true;
+        wrap_data->accept_burst_start_ = uv_hrtime();
+        wrap_data->accept_burst_size_ = 0;
+        env->SetImmediate(
+            [wrap = BaseObjectPtr<WrapType>(wrap_data)](Environment* env) {
+              wrap->OnAcceptBurstDone();
+            });
+      }
+      wrap_data->accept_burst_size_++;
+
+      if (wrap_data->accept_batching_) {
+        wrap_data->pending_connections_.emplace_back(env->isolate(),
+                                                     client_obj);
+        return;
+      }
+    }
   } else {
     client_handle = Undefined(env->isolate());
+    // Keep the order in which connections and errors were reported.
+    wrap_data->DeliverPendingConnections();
   }
 
+  if (status == 0)
+    wrap_data->RecordAcceptLatency(1);
   Local<Value> argv[] = { Integer::New(env->isolate(), status), client_handle };
   wrap_data->MakeCallback(env->onconnection_string(), arraysize(argv), argv);
 }
 
 
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::OnAcceptBurstDone() {
+  accept_burst_pending_ = false;
+  if (accept_backlog_histogram_) {
+    accept_backlog_histogram_->Record(
+        std::min<int64_t>(accept_burst_size_, kMaxAcceptBurstSize));
+  }
+  DeliverPendingConnections();
+}
+
+
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::DeliverPendingConnections() {
+  if (pending_connections_.empty())
+    return;
+
+  Environment* env = this->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  std::vector<Global<Object>> pending;
+  pending.swap(pending_connections_);
+  std::vector<Local<Value>> clients(pending.size());
+  for (size_t i = 0; i < pending.size(); i++)
+    clients[i] = pending[i].Get(env->isolate());
+
+  if (IsClosing() || !IsAlive()) {
+    // The server was closed before the connections could be delivered.
+    for (Local<Value> client : clients) {
+      // Keep going, so that one missing wrap does not leak the others.
+      WrapType* wrap = Unwrap<WrapType>(client.As<Object>());
+      if (wrap == nullptr)
+        continue;
+      wrap->Close();
+    }
+    return;
+  }
+
+  RecordAcceptLatency(clients.size());
+  Local<Value> argv[] = {
+    Integer::New(env->isolate(), 0),
+    Array::New(env->isolate(), clients.data(), clients.size())
+  };
+  MakeCallback(env->onconnection_string(), arraysize(argv), argv);
+}
+
+
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::RecordAcceptLatency(size_t count) {
+  if (!accept_latency_histogram_ || accept_burst_start_ == 0)
+    return;
+  int64_t latency = std::max<int64_t>(
+      1, std::min<int64_t>(uv_hrtime() - accept_burst_start_,
+                           kMaxAcceptLatency));
+  for (size_t i = 0; i < count; i++)
+    accept_latency_histogram_->Record(latency);
+}
+
+
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::SetAcceptBatching(
+    const FunctionCallbackInfo<Value>& args) {
+  WrapType* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  wrap->accept_batching_ = args[0]->IsTrue();
+  if (!wrap->accept_batching_)
+    wrap->DeliverPendingConnections();
+}
+
+
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::EnableAcceptMetrics(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  WrapType* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  if (!wrap->accept_backlog_histogram_) {
+    HistogramBase::Initialize(env);
+    BaseObjectPtr<HistogramBase> backlog =
+        HistogramBase::New(env, 1, kMaxAcceptBurstSize);
+    BaseObjectPtr<HistogramBase> latency =
+        HistogramBase::New(env, 1, kMaxAcceptLatency);
+    if (!backlog || !latency)
+      return;
+    wrap->accept_backlog_histogram_ = std::move(backlog);
+    wrap->accept_latency_histogram_ = std::move(latency);
+  }
+
+  Local<Value> histograms[] = {
+    wrap->accept_backlog_histogram_->object(),
+    wrap->accept_latency_histogram_->object()
+  };
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), histograms, arraysize(histograms)));
+}
+
+
 template <typename WrapType, typename UVType>
 void ConnectionWrap<WrapType, UVType>::AfterConnect(uv_connect_t* req,
                                                     int status) {
@@ -127,6 +261,18 @@ template void ConnectionWrap<PipeWrap, uv_pipe_t>::OnConnection(
 template void ConnectionWrap<TCPWrap, uv_tcp_t>::OnConnection(
     uv_stream_t* handle, int status);
 
+template void ConnectionWrap<PipeWrap, uv_pipe_t>::SetAcceptBatching(
+    const FunctionCallbackInfo<Value>& args);
+
+template void ConnectionWrap<TCPWrap, uv_tcp_t>::SetAcceptBatching(
+    const FunctionCallbackInfo<Value>& args);
+
+template void ConnectionWrap<PipeWrap, uv_pipe_t>::EnableAcceptMetrics(
+    const FunctionCallbackInfo<Value>& args);
+
+template void ConnectionWrap<TCPWrap, uv_tcp_t>::EnableAcceptMetrics(
+    const FunctionCallbackInfo<Value>& args);
+
 template void ConnectionWrap<PipeWrap, uv_pipe_t>::AfterConnect(
     uv_connect_t* handle, int status);
 
@@ -3,8 +3,11 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "histogram.h"
 #include "stream_wrap.h"
 
+#include <vector>
+
 namespace node {
 
 class Environment;
@@ -15,12 +18,39 @@ class ConnectionWrap : public LibuvStreamWrap {
   static void OnConnection(uv_stream_t* handle, int status);
   static void AfterConnect(uv_connect_t* req, int status);
 
+  // While accept batching is enabled, the connections that are accepted in
+  // one iteration of the event loop are passed to `onconnection` together,
+  // as an array, from a SetImmediate() callback.
+  static void SetAcceptBatching(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  // Starts recording the number of connections accepted per iteration of the
+  // event loop and the time from the first of them being accepted to each
+  // connection being passed to JS. Returns the two histograms.
+  static void EnableAcceptMetrics(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+
  protected:
   ConnectionWrap(Environment* env,
                  v8::Local<v8::Object> object,
                  ProviderType provider);
 
   UVType handle_;
+
+ private:
+  // Called from a SetImmediate() callback once the connections of one
+  // iteration of the event loop have been accepted.
+  void OnAcceptBurstDone();
+  void DeliverPendingConnections();
+  // Records the latency of `count` connections that are passed to JS now.
+  void RecordAcceptLatency(size_t count);
+
+  bool accept_batching_ = false;
+  bool accept_burst_pending_ = false;
+  uint64_t accept_burst_start_ = 0;
+  size_t accept_burst_size_ = 0;
+  std::vector<v8::Global<v8::Object>> pending_connections_;
+  BaseObjectPtr<HistogramBase> accept_backlog_histogram_;
+  BaseObjectPtr<HistogramBase> accept_latency_histogram_;
 };
 
 }  // namespace node
@@ -618,6 +618,15 @@ inline void Environment::set_http2_state(
   http2_state_ = std::move(buffer);
 }
 
+inline IdleTimeoutTracker* Environment::idle_timeout_tracker() const {
+  return idle_timeout_tracker_;
+}
+
+inline void Environment::set_idle_timeout_tracker(
+    IdleTimeoutTracker* tracker) {
+  idle_timeout_tracker_ = tracker;
+}
+
 inline AliasedFloat64Array* Environment::fs_stats_field_array() {
   return &fs_stats_field_array_;
 }
@@ -1068,6 +1068,9 @@ void Environment::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("async_hooks", async_hooks_);
   tracker->TrackField("immediate_info", immediate_info_);
   tracker->TrackField("tick_info", tick_info_);
+  // The pool is shared by all Environments on this thread.
+  tracker->TrackField("small_buffer_pool",
+                      SmallBufferPool::ForCurrentThread());
 
 #define V(PropertyName, TypeName)                                              \
   tracker->TrackField(#PropertyName, PropertyName());
@@ -54,6 +54,8 @@ struct nghttp2_rcbuf;
 
 namespace node {
 
+class IdleTimeoutTracker;
+
 namespace contextify {
 class ContextifyScript;
 class CompiledFnEntry;
@@ -299,12 +301,15 @@ constexpr size_t kFsStatsBufferLength =
   V(onhandshakestart_string, "onhandshakestart")                               \
   V(onkeylog_string, "onkeylog")                                               \
   V(onmessage_string, "onmessage")                                             \
+  V(onmessagebatch_string, "onmessagebatch")                                   \
   V(onnewsession_string, "onnewsession")                                       \
   V(onocspresponse_string, "onocspresponse")                                   \
   V(onreadstart_string, "onreadstart")                                         \
   V(onreadstop_string, "onreadstop")                                           \
   V(onshutdown_string, "onshutdown")                                           \
   V(onsignal_string, "onsignal")                                               \
+  V(ontimeout_string, "ontimeout")                                             \
+  V(ontransfer_string, "ontransfer")                                           \
   V(onunpipe_string, "onunpipe")                                               \
   V(onwrite_string, "onwrite")                                                 \
   V(openssl_error_stack, "opensslErrorStack")                                  \
@@ -411,6 +416,7 @@ constexpr size_t kFsStatsBufferLength =
   V(http2settings_constructor_template, v8::ObjectTemplate)                    \
   V(http2stream_constructor_template, v8::ObjectTemplate)                      \
   V(http2ping_constructor_template, v8::ObjectTemplate)                        \
+  V(http_header_list_constructor_template, v8::ObjectTemplate)                 \
   V(libuv_stream_wrap_ctor_template, v8::FunctionTemplate)                     \
   V(message_port_constructor_template, v8::FunctionTemplate)                   \
   V(pipe_constructor_template, v8::FunctionTemplate)                           \
@@ -1007,6 +1013,10 @@ class Environment : public MemoryRetainer {
   inline http2::Http2State* http2_state() const;
   inline void set_http2_state(std::unique_ptr<http2::Http2State> state);
 
+  // Created on demand by IdleTimeoutTracker::Get(); freed during cleanup.
+  inline IdleTimeoutTracker* idle_timeout_tracker() const;
+  inline void set_idle_timeout_tracker(IdleTimeoutTracker* tracker);
+
   EnabledDebugList* enabled_debug_list() { return &enabled_debug_list_; }
 
   inline AliasedFloat64Array* fs_stats_field_array();
@@ -1365,6 +1375,7 @@ class Environment : public MemoryRetainer {
   char* http_parser_buffer_ = nullptr;
   bool http_parser_buffer_in_use_ = false;
   std::unique_ptr<http2::Http2State> http2_state_;
+  IdleTimeoutTracker* idle_timeout_tracker_ = nullptr;
 
   EnabledDebugList enabled_debug_list_;
   AliasedFloat64Array fs_stats_field_array_;
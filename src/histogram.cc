@@ -97,6 +97,16 @@ void HistogramBase::DoReset(const FunctionCallbackInfo<Value>& args) {
   histogram->ResetState();
 }
 
+void HistogramBase::DoRecord(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  HistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsNumber());
+  int64_t value = args[0]->IntegerValue(env->context()).FromJust();
+  if (!histogram->Record(value) && histogram->exceeds_ < 0xFFFFFFFF)
+    histogram->exceeds_++;
+}
+
 BaseObjectPtr<HistogramBase> HistogramBase::New(
     Environment* env,
     int64_t lowest,
@@ -134,6 +144,7 @@ void HistogramBase::Initialize(Environment* env) {
   env->SetProtoMethod(histogram, "percentile", HistogramBase::GetPercentile);
   env->SetProtoMethod(histogram, "percentiles", HistogramBase::GetPercentiles);
   env->SetProtoMethod(histogram, "reset", HistogramBase::DoReset);
+  env->SetProtoMethod(histogram, "record", HistogramBase::DoRecord);
 
   env->set_histogram_instance_template(histogramt);
 }
@@ -71,6 +71,7 @@ class HistogramBase : public BaseObject, public Histogram {
   static void GetPercentiles(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DoReset(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void DoRecord(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Initialize(Environment* env);
 
   static BaseObjectPtr<HistogramBase> New(
@@ -52,6 +52,7 @@
   V(http_parser)                                                               \
   V(inspector)                                                                 \
   V(js_stream)                                                                 \
+  V(json)                                                                      \
   V(messaging)                                                                 \
   V(module_wrap)                                                               \
   V(native_module)                                                             \
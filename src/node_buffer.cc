@@ -30,8 +30,10 @@
 #include "util-inl.h"
 #include "v8.h"
 
-#include <cstring>
+#include <algorithm>
 #include <climits>
+#include <cstring>
+#include <numeric>
 
 #define THROW_AND_RETURN_UNLESS_BUFFER(env, obj)                            \
   THROW_AND_RETURN_IF_NOT_BUFFER(env, obj, "argument")                      \
@@ -46,6 +48,7 @@
 namespace node {
 namespace Buffer {
 
+using v8::Array;
 using v8::ArrayBuffer;
 using v8::ArrayBufferView;
 using v8::BackingStore;
@@ -469,8 +472,18 @@ MaybeLocal<Object> New(Environment* env,
       return New(env, data, length, free_callback, nullptr);
     } else {
       // This is malloc()-based, so we can acquire it into our own
-      // ArrayBufferAllocator.
+      // ArrayBufferAllocator. Small blocks may end up in the allocator's
+      // SmallBufferPool, so they need to be grown to their size class first.
       CHECK_NOT_NULL(env->isolate_data()->node_allocator());
+      if (SmallBufferPool::IsPooledSize(length)) {
+        char* new_data =
+            UncheckedRealloc(data, SmallBufferPool::RoundUp(length));
+        if (new_data == nullptr) {
+          auto free_callback = [](char* data, void* hint) { free(data); };
+          return New(env, data, length, free_callback, nullptr);
+        }
+        data = new_data;
+      }
       env->isolate_data()->node_allocator()->RegisterPointer(data, length);
     }
   }
@@ -580,6 +593,90 @@ void Copy(const FunctionCallbackInfo<Value> &args) {
 }
 
 
+// buffer = concat(list[, length])
+// Returns the index of the first element of |list| that is not a Uint8Array
+// instead of a Buffer, so that JS land can throw a descriptive error.
+void Concat(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+
+  CHECK(args[0]->IsArray());
+  Local<Array> list = args[0].As<Array>();
+  const uint32_t count = list->Length();
+
+  MaybeStackBuffer<Local<Uint8Array>, 16> chunks(count);
+  size_t total_length = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> chunk;
+    if (!list->Get(context, i).ToLocal(&chunk)) return;
+    if (!chunk->IsUint8Array()) return args.GetReturnValue().Set(i);
+    chunks[i] = chunk.As<Uint8Array>();
+    total_length += chunks[i]->ByteLength();
+  }
+
+  size_t length = total_length;
+  if (!args[1]->IsUndefined()) {
+    CHECK(args[1]->IsUint32());
+    length = args[1].As<Uint32>()->Value();
+  }
+  if (length > kMaxLength) {
+    env->isolate()->ThrowException(ERR_BUFFER_TOO_LARGE(env->isolate()));
+    return;
+  }
+
+  AllocatedBuffer result = env->AllocateManaged(length, false);
+  if (result.data() == nullptr)
+    return THROW_ERR_MEMORY_ALLOCATION_FAILED(env);
+
+  size_t offset = 0;
+  for (uint32_t i = 0; i < count && offset < length; i++)
+    offset += chunks[i]->CopyContents(result.data() + offset, length - offset);
+  // Zero-fill the remaining bytes if |length| was more than the total length
+  // of all chunks.
+  if (offset < length)
+    memset(result.data() + offset, 0, length - offset);
+
+  Local<Object> buffer;
+  if (result.ToBuffer().ToLocal(&buffer))
+    args.GetReturnValue().Set(buffer);
+}
+
+
+// Repeats the |pattern_length| bytes at the start of |data| until
+// |fill_length| bytes are filled. The pattern is doubled only until it forms
+// a block that comfortably fits into the L1 cache. That block is then copied
+// repeatedly, so that large fills do not have to read back the (by then
+// evicted) region they have just written.
+void RepeatPattern(char* data, size_t pattern_length, size_t fill_length) {
+  static constexpr size_t kFillBlockSize = 16 * 1024;
+
+  // Patterns like "aaaa" or Buffer.alloc(4) reduce to a plain memset().
+  bool is_uniform = true;
+  for (size_t i = 1; i < pattern_length && is_uniform; i++)
+    is_uniform = data[i] == data[0];
+  if (is_uniform) {
+    memset(data + pattern_length, data[0], fill_length - pattern_length);
+    return;
+  }
+
+  size_t in_there = pattern_length;
+  while (in_there < kFillBlockSize && in_there < fill_length - in_there) {
+    memcpy(data + in_there, data, in_there);
+    in_there *= 2;
+  }
+
+  char* ptr = data + in_there;
+  size_t remaining = fill_length - in_there;
+  while (remaining >= in_there) {
+    memcpy(ptr, data, in_there);
+    ptr += in_there;
+    remaining -= in_there;
+  }
+  if (remaining > 0)
+    memcpy(ptr, data, remaining);
+}
+
+
 void Fill(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Local<Context> ctx = env->context();
@@ -662,18 +759,7 @@ void Fill(const FunctionCallbackInfo<Value>& args) {
   if (str_length == 0)
     return args.GetReturnValue().Set(-1);
 
-  size_t in_there = str_length;
-  char* ptr = ts_obj_data + start + str_length;
-
-  while (in_there < fill_length - in_there) {
-    memcpy(ptr, ts_obj_data + start, in_there);
-    ptr += in_there;
-    in_there *= 2;
-  }
-
-  if (in_there < fill_length) {
-    memcpy(ptr, ts_obj_data + start, fill_length - in_there);
-  }
+  RepeatPattern(ts_obj_data + start, str_length, fill_length);
 }
 
 
@@ -800,6 +886,62 @@ void Compare(const FunctionCallbackInfo<Value> &args) {
 }
 
 
+// indices = sortKeys(source, offsets, lengths, keyLength)
+// Sorts the keys stored in |source| at |offsets|, each either |lengths[i]| or
+// |keyLength| bytes long, in Buffer.compare() order. Returns a Uint32Array
+// with the indices of the keys in sorted order, or the index of the first key
+// that is out of bounds so that JS land can throw.
+void SortKeys(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  THROW_AND_RETURN_UNLESS_BUFFER(env, args[0]);
+  SPREAD_BUFFER_ARG(args[0], source);
+  CHECK(args[1]->IsUint32Array());
+  SPREAD_BUFFER_ARG(args[1], offsets_array);
+  const uint32_t* offsets = reinterpret_cast<const uint32_t*>(
+      offsets_array_data);
+  const uint32_t count = offsets_array_length / sizeof(uint32_t);
+
+  const uint32_t* lengths = nullptr;
+  uint32_t key_length = 0;
+  if (args[2]->IsUint32Array()) {
+    SPREAD_BUFFER_ARG(args[2], lengths_array);
+    CHECK_EQ(lengths_array_length, offsets_array_length);
+    lengths = reinterpret_cast<const uint32_t*>(lengths_array_data);
+  } else {
+    CHECK(args[3]->IsUint32());
+    key_length = args[3].As<Uint32>()->Value();
+  }
+
+  auto length_of = [&](uint32_t index) -> size_t {
+    return lengths != nullptr ? lengths[index] : key_length;
+  };
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (offsets[i] > source_length ||
+        length_of(i) > source_length - offsets[i]) {
+      return args.GetReturnValue().Set(i);
+    }
+  }
+
+  Local<ArrayBuffer> ab =
+      ArrayBuffer::New(env->isolate(), count * sizeof(uint32_t));
+  uint32_t* indices = static_cast<uint32_t*>(ab->GetBackingStore()->Data());
+  std::iota(indices, indices + count, 0);
+  std::stable_sort(indices, indices + count, [&](uint32_t a, uint32_t b) {
+    const size_t a_length = length_of(a);
+    const size_t b_length = length_of(b);
+    const size_t cmp_length = std::min(a_length, b_length);
+    const int cmp = cmp_length > 0 ?
+        memcmp(source_data + offsets[a], source_data + offsets[b], cmp_length) :
+        0;
+    return cmp < 0 || (cmp == 0 && a_length < b_length);
+  });
+
+  args.GetReturnValue().Set(Uint32Array::New(ab, 0, count));
+}
+
+
 // Computes the offset for starting an indexOf or lastIndexOf search.
 // Returns either a valid offset in [0...<length - 1>], ie inside the Buffer,
 // or -1 to signal that there is no possible match.
@@ -1161,8 +1303,10 @@ void Initialize(Local<Object> target,
 
   env->SetMethodNoSideEffect(target, "byteLengthUtf8", ByteLengthUtf8);
   env->SetMethod(target, "copy", Copy);
+  env->SetMethod(target, "concat", Concat);
   env->SetMethodNoSideEffect(target, "compare", Compare);
   env->SetMethodNoSideEffect(target, "compareOffset", CompareOffset);
+  env->SetMethodNoSideEffect(target, "sortKeys", SortKeys);
   env->SetMethod(target, "fill", Fill);
   env->SetMethodNoSideEffect(target, "indexOfBuffer", IndexOfBuffer);
   env->SetMethodNoSideEffect(target, "indexOfNumber", IndexOfNumber);
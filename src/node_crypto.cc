@@ -25,6 +25,7 @@
 #include "node_crypto_common.h"
 #include "node_crypto_clienthello-inl.h"
 #include "node_crypto_groups.h"
+#include "node_crypto_session_cache.h"
 #include "node_errors.h"
 #include "node_mutex.h"
 #include "node_process.h"
@@ -479,6 +480,7 @@ void SecureContext::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethod(t, "setOptions", SetOptions);
   env->SetProtoMethod(t, "setSessionIdContext", SetSessionIdContext);
   env->SetProtoMethod(t, "setSessionTimeout", SetSessionTimeout);
+  env->SetProtoMethod(t, "setSessionCache", SetSessionCache);
   env->SetProtoMethod(t, "close", Close);
   env->SetProtoMethod(t, "loadPKCS12", LoadPKCS12);
 #ifndef OPENSSL_NO_ENGINE
@@ -533,6 +535,8 @@ inline void SecureContext::Reset() {
   ctx_.reset();
   cert_.reset();
   issuer_.reset();
+  session_cache_.reset();
+  shared_ticket_keys_ = false;
 }
 
 SecureContext::~SecureContext() {
@@ -1367,6 +1371,29 @@ void SecureContext::SetSessionTimeout(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void SecureContext::SetSessionCache(const FunctionCallbackInfo<Value>& args) {
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
+  Environment* env = sc->env();
+
+  CHECK_EQ(args.Length(), 3);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsUint32());
+
+  const node::Utf8Value name(env->isolate(), args[0]);
+  uint32_t max_size = args[1].As<Uint32>()->Value();
+  uint64_t ticket_key_rotation =
+      static_cast<uint64_t>(args[2].As<Uint32>()->Value()) * 1000000000;
+  CHECK_GT(max_size, 0);
+
+  sc->session_cache_ =
+      SharedSessionCache::Get(*name, max_size, ticket_key_rotation);
+  SSL_CTX_set_tlsext_ticket_key_cb(sc->ctx_.get(), SharedTicketKeyCallback);
+  sc->shared_ticket_keys_ = true;
+}
+
+
 void SecureContext::Close(const FunctionCallbackInfo<Value>& args) {
   SecureContext* sc;
   ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
@@ -1499,6 +1526,12 @@ void SecureContext::GetTicketKeys(const FunctionCallbackInfo<Value>& args) {
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
 
   Local<Object> buff = Buffer::New(wrap->env(), 48).ToLocalChecked();
+  if (wrap->shared_ticket_keys_) {
+    unsigned char* data = reinterpret_cast<unsigned char*>(Buffer::Data(buff));
+    if (!wrap->session_cache_->GetTicketKeys(data))
+      return wrap->env()->ThrowError("Error generating ticket keys");
+    return args.GetReturnValue().Set(buff);
+  }
   memcpy(Buffer::Data(buff), wrap->ticket_key_name_, 16);
   memcpy(Buffer::Data(buff) + 16, wrap->ticket_key_hmac_, 16);
   memcpy(Buffer::Data(buff) + 32, wrap->ticket_key_aes_, 16);
@@ -1531,6 +1564,13 @@ void SecureContext::SetTicketKeys(const FunctionCallbackInfo<Value>& args) {
   memcpy(wrap->ticket_key_hmac_, buf.data() + 16, 16);
   memcpy(wrap->ticket_key_aes_, buf.data() + 32, 16);
 
+  // Explicit keys take precedence over the ones of a shared session cache.
+  if (wrap->shared_ticket_keys_) {
+    SSL_CTX_set_tlsext_ticket_key_cb(wrap->ctx_.get(),
+                                     TicketCompatibilityCallback);
+    wrap->shared_ticket_keys_ = false;
+  }
+
   args.GetReturnValue().Set(true);
 #endif  // !def(OPENSSL_NO_TLSEXT) && def(SSL_CTX_get_tlsext_ticket_keys)
 }
@@ -1675,6 +1715,24 @@ int SecureContext::TicketCompatibilityCallback(SSL* ssl,
 }
 
 
+int SecureContext::SharedTicketKeyCallback(SSL* ssl,
+                                           unsigned char* name,
+                                           unsigned char* iv,
+                                           EVP_CIPHER_CTX* ectx,
+                                           HMAC_CTX* hctx,
+                                           int enc) {
+  SecureContext* sc = static_cast<SecureContext*>(
+      SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+
+  // The context may have been switched to one without a shared cache
+  // through SNI.
+  if (!sc->session_cache_)
+    return TicketCompatibilityCallback(ssl, name, iv, ectx, hctx, enc);
+
+  return sc->session_cache_->TicketKeyCallback(name, iv, ectx, hctx, enc);
+}
+
+
 void SecureContext::CtxGetter(const FunctionCallbackInfo<Value>& info) {
   SecureContext* sc;
   ASSIGN_OR_RETURN_UNWRAP(&sc, info.This());
@@ -1761,7 +1819,10 @@ SSL_SESSION* SSLWrap<Base>::GetSessionCallback(SSL* s,
   Base* w = static_cast<Base*>(SSL_get_app_data(s));
 
   *copy = 0;
-  return w->next_sess_.release();
+  SSL_SESSION* sess = w->next_sess_.release();
+  if (sess == nullptr && w->session_cache_)
+    sess = w->session_cache_->Lookup(key, len);
+  return sess;
 }
 
 
@@ -1772,6 +1833,13 @@ int SSLWrap<Base>::NewSessionCallback(SSL* s, SSL_SESSION* sess) {
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
+  // Stateless TLS 1.3 tickets are never looked up by session ID.
+  if (w->session_cache_ &&
+      (SSL_version(s) != TLS1_3_VERSION ||
+       (SSL_get_options(s) & SSL_OP_NO_TICKET) != 0)) {
+    w->session_cache_->Add(sess);
+  }
+
   if (!w->session_callbacks_)
     return 0;
 
@@ -2106,9 +2174,10 @@ void SSLWrap<Base>::SetMaxSendFragment(
   Base* w;
   ASSIGN_OR_RETURN_UNWRAP(&w, args.Holder());
 
-  int rv = SSL_set_max_send_fragment(
-      w->ssl_.get(),
-      args[0]->Int32Value(w->ssl_env()->context()).FromJust());
+  int32_t size = args[0]->Int32Value(w->ssl_env()->context()).FromJust();
+  int rv = SSL_set_max_send_fragment(w->ssl_.get(), size);
+  if (rv == 1)
+    w->max_send_fragment_ = size;
   args.GetReturnValue().Set(rv);
 }
 #endif  // SSL_set_max_send_fragment
@@ -84,6 +84,8 @@ extern void UseExtraCaCerts(const std::string& file);
 
 void InitCryptoOnce();
 
+class SharedSessionCache;
+
 class SecureContext final : public BaseObject {
  public:
   ~SecureContext() override;
@@ -118,6 +120,11 @@ class SecureContext final : public BaseObject {
   unsigned char ticket_key_aes_[16];
   unsigned char ticket_key_hmac_[16];
 
+  // Set if sessions and ticket keys are shared with other SecureContexts.
+  std::shared_ptr<SharedSessionCache> session_cache_;
+  // False once ticket keys were set explicitly.
+  bool shared_ticket_keys_ = false;
+
  protected:
   // OpenSSL structures are opaque. This is sizeof(SSL_CTX) for OpenSSL 1.1.1b:
   static const int64_t kExternalSize = 1024;
@@ -142,6 +149,8 @@ class SecureContext final : public BaseObject {
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetSessionTimeout(
       const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetSessionCache(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetMinProto(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetMaxProto(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetMinProto(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -177,6 +186,13 @@ class SecureContext final : public BaseObject {
                                          HMAC_CTX* hctx,
                                          int enc);
 
+  static int SharedTicketKeyCallback(SSL* ssl,
+                                     unsigned char* name,
+                                     unsigned char* iv,
+                                     EVP_CIPHER_CTX* ectx,
+                                     HMAC_CTX* hctx,
+                                     int enc);
+
   SecureContext(Environment* env, v8::Local<v8::Object> wrap);
   void Reset();
 };
@@ -200,6 +216,8 @@ class SSLWrap {
         cert_cb_(nullptr),
         cert_cb_arg_(nullptr),
         cert_cb_running_(false) {
+    if (kind == kServer)
+      session_cache_ = sc->session_cache_;
     ssl_.reset(SSL_new(sc->ctx_.get()));
     CHECK(ssl_);
     env_->isolate()->AdjustAmountOfExternalAllocatedMemory(kExternalSize);
@@ -292,9 +310,13 @@ class SSLWrap {
   Environment* const env_;
   Kind kind_;
   SSLSessionPointer next_sess_;
+  // Server side cache of the SecureContext this was created with.
+  std::shared_ptr<SharedSessionCache> session_cache_;
   SSLPointer ssl_;
   bool session_callbacks_;
   bool awaiting_new_session_;
+  // Last value accepted by setMaxSendFragment().
+  unsigned int max_send_fragment_ = SSL3_RT_MAX_PLAIN_LENGTH;
 
   // SSL_set_cert_cb
   CertCb cert_cb_;
@@ -0,0 +1,198 @@
+#include "node_crypto_session_cache.h"
+#include "util-inl.h"
+#include "uv.h"
+
+#include <openssl/rand.h>
+
+#include <cstring>
+#include <ctime>
+
+namespace node {
+namespace crypto {
+
+namespace {
+
+// All caches that are in use, by name.
+Mutex cache_registry_mutex;
+std::unordered_map<std::string, std::weak_ptr<SharedSessionCache>>
+    cache_registry;
+
+}  // anonymous namespace
+
+std::shared_ptr<SharedSessionCache> SharedSessionCache::Get(
+    const std::string& name,
+    size_t max_size,
+    uint64_t ticket_key_rotation) {
+  Mutex::ScopedLock lock(cache_registry_mutex);
+  std::weak_ptr<SharedSessionCache>& entry = cache_registry[name];
+  std::shared_ptr<SharedSessionCache> cache = entry.lock();
+  if (!cache) {
+    cache.reset(new SharedSessionCache(name, max_size, ticket_key_rotation));
+    entry = cache;
+  }
+  return cache;
+}
+
+
+SharedSessionCache::SharedSessionCache(const std::string& name,
+                                       size_t max_size,
+                                       uint64_t ticket_key_rotation)
+    : name_(name),
+      max_size_(max_size),
+      ticket_key_rotation_(ticket_key_rotation) {
+  CHECK_GT(max_size, 0);
+}
+
+
+SharedSessionCache::~SharedSessionCache() {
+  OPENSSL_cleanse(&ticket_key_, sizeof(ticket_key_));
+  OPENSSL_cleanse(&previous_ticket_key_, sizeof(previous_ticket_key_));
+
+  // A new cache with the same name may have been registered in the meantime.
+  Mutex::ScopedLock lock(cache_registry_mutex);
+  auto it = cache_registry.find(name_);
+  if (it != cache_registry.end() && it->second.expired())
+    cache_registry.erase(it);
+}
+
+
+void SharedSessionCache::Add(SSL_SESSION* session) {
+  unsigned int length;
+  const unsigned char* id = SSL_SESSION_get_id(session, &length);
+  if (length == 0)
+    return;
+
+  std::string key(reinterpret_cast<const char*>(id), length);
+  SSL_SESSION_up_ref(session);
+  SSLSessionPointer reference(session);
+
+  Mutex::ScopedLock lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    sessions_.erase(it->second);
+    index_.erase(it);
+  }
+  sessions_.emplace_front(key, std::move(reference));
+  index_[key] = sessions_.begin();
+
+  while (sessions_.size() > max_size_) {
+    index_.erase(sessions_.back().first);
+    sessions_.pop_back();
+  }
+}
+
+
+SSL_SESSION* SharedSessionCache::Lookup(const unsigned char* id, int length) {
+  std::string key(reinterpret_cast<const char*>(id), length);
+
+  Mutex::ScopedLock lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end())
+    return nullptr;
+
+  std::list<Entry>::iterator entry = it->second;
+  SSL_SESSION* session = entry->second.get();
+  if (SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session) <
+      time(nullptr)) {
+    sessions_.erase(entry);
+    index_.erase(it);
+    return nullptr;
+  }
+
+  sessions_.splice(sessions_.begin(), sessions_, entry);
+  SSL_SESSION_up_ref(session);
+  return session;
+}
+
+
+size_t SharedSessionCache::size() {
+  Mutex::ScopedLock lock(mutex_);
+  return sessions_.size();
+}
+
+
+bool SharedSessionCache::MaybeRotateTicketKeys() {
+  uint64_t now = uv_hrtime();
+  if (has_ticket_key_ &&
+      (ticket_key_rotation_ == 0 ||
+       now - ticket_key_.created < ticket_key_rotation_)) {
+    return true;
+  }
+
+  TicketKey key;
+  if (RAND_bytes(key.name, sizeof(key.name)) <= 0 ||
+      RAND_bytes(key.hmac, sizeof(key.hmac)) <= 0 ||
+      RAND_bytes(key.aes, sizeof(key.aes)) <= 0) {
+    return false;
+  }
+  key.created = now;
+
+  if (has_ticket_key_) {
+    previous_ticket_key_ = ticket_key_;
+    has_previous_ticket_key_ = true;
+  }
+  ticket_key_ = key;
+  has_ticket_key_ = true;
+  OPENSSL_cleanse(&key, sizeof(key));
+  return true;
+}
+
+
+int SharedSessionCache::TicketKeyCallback(unsigned char* name,
+                                          unsigned char* iv,
+                                          EVP_CIPHER_CTX* ectx,
+                                          HMAC_CTX* hctx,
+                                          int enc) {
+  Mutex::ScopedLock lock(mutex_);
+  if (!MaybeRotateTicketKeys())
+    return -1;
+
+  if (enc) {
+    memcpy(name, ticket_key_.name, sizeof(ticket_key_.name));
+    if (RAND_bytes(iv, 16) <= 0 ||
+        EVP_EncryptInit_ex(ectx, EVP_aes_128_cbc(), nullptr,
+                           ticket_key_.aes, iv) <= 0 ||
+        HMAC_Init_ex(hctx, ticket_key_.hmac, sizeof(ticket_key_.hmac),
+                     EVP_sha256(), nullptr) <= 0) {
+      return -1;
+    }
+    return 1;
+  }
+
+  const TicketKey* key;
+  int ret;
+  if (memcmp(name, ticket_key_.name, sizeof(ticket_key_.name)) == 0) {
+    key = &ticket_key_;
+    ret = 1;
+  } else if (has_previous_ticket_key_ &&
+             memcmp(name, previous_ticket_key_.name,
+                    sizeof(previous_ticket_key_.name)) == 0) {
+    // Accept the ticket, but issue a new one with the current key.
+    key = &previous_ticket_key_;
+    ret = 2;
+  } else {
+    // The ticket key name does not match. Discard the ticket.
+    return 0;
+  }
+
+  if (EVP_DecryptInit_ex(ectx, EVP_aes_128_cbc(), nullptr, key->aes, iv) <= 0 ||
+      HMAC_Init_ex(hctx, key->hmac, sizeof(key->hmac),
+                   EVP_sha256(), nullptr) <= 0) {
+    return -1;
+  }
+  return ret;
+}
+
+
+bool SharedSessionCache::GetTicketKeys(unsigned char out[48]) {
+  Mutex::ScopedLock lock(mutex_);
+  if (!has_ticket_key_ && !MaybeRotateTicketKeys())
+    return false;
+  memcpy(out, ticket_key_.name, 16);
+  memcpy(out + 16, ticket_key_.hmac, 16);
+  memcpy(out + 32, ticket_key_.aes, 16);
+  return true;
+}
+
+}  // namespace crypto
+}  // namespace node
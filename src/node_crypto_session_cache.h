@@ -0,0 +1,99 @@
+#ifndef SRC_NODE_CRYPTO_SESSION_CACHE_H_
+#define SRC_NODE_CRYPTO_SESSION_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "node_crypto.h"  // SSLSessionPointer
+#include "node_mutex.h"
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/ssl.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace node {
+namespace crypto {
+
+// Server side TLS session state that can be shared by SecureContexts in
+// different threads of the same process: a cache of sessions for resumption
+// by session ID, with a maximum number of entries beyond which the least
+// recently used one is dropped, and the keys for encrypting session tickets.
+//
+// Caches are looked up by name. The first SecureContext to use a name decides
+// on its size and ticket key rotation, and the cache is freed once no
+// SecureContext uses it anymore.
+class SharedSessionCache {
+ public:
+  static std::shared_ptr<SharedSessionCache> Get(const std::string& name,
+                                                 size_t max_size,
+                                                 uint64_t ticket_key_rotation);
+
+  ~SharedSessionCache();
+
+  SharedSessionCache(const SharedSessionCache&) = delete;
+  SharedSessionCache& operator=(const SharedSessionCache&) = delete;
+
+  // Adds a reference to `session` to the cache.
+  void Add(SSL_SESSION* session);
+  // Returns a new reference to the session with the given ID, or nullptr.
+  SSL_SESSION* Lookup(const unsigned char* id, int length);
+  size_t size();
+
+  // Has the same contract as the callback for
+  // SSL_CTX_set_tlsext_ticket_key_cb(), and encrypts tickets the same way as
+  // SecureContext::TicketCompatibilityCallback(). Tickets encrypted with the
+  // key before the current one are accepted, but renewed.
+  int TicketKeyCallback(unsigned char* name,
+                        unsigned char* iv,
+                        EVP_CIPHER_CTX* ectx,
+                        HMAC_CTX* hctx,
+                        int enc);
+  // Copies the name, HMAC secret and AES key of the current ticket key to
+  // `out`, in the format of SecureContext::GetTicketKeys(). This does not
+  // rotate the key, that only happens when tickets are used.
+  bool GetTicketKeys(unsigned char out[48]);
+
+ private:
+  struct TicketKey {
+    unsigned char name[16];
+    unsigned char hmac[16];
+    unsigned char aes[16];
+    uint64_t created;
+  };
+
+  using Entry = std::pair<std::string, SSLSessionPointer>;
+
+  SharedSessionCache(const std::string& name,
+                     size_t max_size,
+                     uint64_t ticket_key_rotation);
+
+  // Replaces the current ticket key if it is due. Requires mutex_ to be held.
+  bool MaybeRotateTicketKeys();
+
+  const std::string name_;
+  const size_t max_size_;
+  // In nanoseconds, 0 if the ticket key never changes.
+  const uint64_t ticket_key_rotation_;
+
+  Mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> sessions_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  TicketKey ticket_key_;
+  TicketKey previous_ticket_key_;
+  bool has_ticket_key_ = false;
+  bool has_previous_ticket_key_ = false;
+};
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_CRYPTO_SESSION_CACHE_H_
@@ -49,6 +49,12 @@ namespace {
 
 const char zero_bytes_256[256] = {};
 
+// DATA frame payload chunks up to this size are copied into the session's
+// outgoing storage, where they end up in a single buffer together with the
+// surrounding frame headers. Larger chunks are written from the stream's
+// own buffers.
+constexpr size_t kMaxCopiedDataChunkSize = 1024;
+
 inline Http2Stream* GetStream(Http2Session* session,
                               int32_t id,
                               nghttp2_data_source* source) {
@@ -60,6 +66,51 @@ inline Http2Stream* GetStream(Http2Session* session,
   return stream;
 }
 
+// Stream weights used by the urgency scheduler, indexed by the RFC 9218
+// urgency, from 0 (most urgent) to 7. Requests without a priority header
+// get the default urgency of 3.
+constexpr int32_t kUrgencyWeights[] = { 256, 128, 64, 32, 16, 8, 4, 1 };
+constexpr size_t kDefaultUrgency = 3;
+
+// Returns the urgency in the value of a priority header field, which is a
+// structured field dictionary such as "u=1, i".
+size_t GetUrgency(const std::string& value) {
+  size_t pos = 0;
+  while (pos < value.size()) {
+    size_t end = value.find(',', pos);
+    if (end == std::string::npos)
+      end = value.size();
+    size_t start = pos;
+    while (start < end && (value[start] == ' ' || value[start] == '\t'))
+      start++;
+    size_t last = end;
+    while (last > start && (value[last - 1] == ' ' || value[last - 1] == '\t'))
+      last--;
+    if (last - start == 3 &&
+        value[start] == 'u' &&
+        value[start + 1] == '=' &&
+        value[start + 2] >= '0' &&
+        value[start + 2] <= '7') {
+      return value[start + 2] - '0';
+    }
+    pos = end + 1;
+  }
+  return kDefaultUrgency;
+}
+
+// Returns the weight used by the small-first scheduler for a response of
+// the given length: the maximum weight up to 16 KiB, halved for every four
+// times as much data.
+int32_t GetSmallFirstWeight(uint64_t length) {
+  int32_t weight = NGHTTP2_MAX_WEIGHT;
+  for (uint64_t limit = 16384;
+       length > limit && weight > NGHTTP2_MIN_WEIGHT;
+       limit *= 4) {
+    weight /= 2;
+  }
+  return weight;
+}
+
 }  // anonymous namespace
 
 // These configure the callbacks required by nghttp2 itself. There are
@@ -212,6 +263,14 @@ Http2Options::Http2Options(Environment* env, nghttp2_session_type type) {
   if (flags & (1 << IDX_OPTIONS_MAX_SESSION_MEMORY)) {
     SetMaxSessionMemory(buffer[IDX_OPTIONS_MAX_SESSION_MEMORY] * 1e6);
   }
+
+  // The stream scheduler decides how the priority tree is shaped, and with
+  // it how DATA frames of concurrent streams share the connection.
+  if (flags & (1 << IDX_OPTIONS_STREAM_SCHEDULER)) {
+    uint32_t scheduler = buffer[IDX_OPTIONS_STREAM_SCHEDULER];
+    CHECK_LE(scheduler, STREAM_SCHEDULER_SMALL_FIRST);
+    SetStreamScheduler(static_cast<stream_scheduler_type>(scheduler));
+  }
 }
 
 void Http2Session::Http2Settings::Init() {
@@ -496,6 +555,7 @@ Http2Session::Http2Session(Environment* env,
   max_outstanding_settings_ = opts.GetMaxOutstandingSettings();
 
   padding_strategy_ = opts.GetPaddingStrategy();
+  stream_scheduler_ = opts.GetStreamScheduler();
 
   bool hasGetPaddingCallback =
       padding_strategy_ != PADDING_STRATEGY_NONE;
@@ -960,6 +1020,15 @@ int Http2Session::OnFrameSent(nghttp2_session* handle,
                               void* user_data) {
   Http2Session* session = static_cast<Http2Session*>(user_data);
   session->statistics_.frame_sent += 1;
+  // The promised stream only enters the priority tree once the PUSH_PROMISE
+  // frame is on its way, below the stream it is associated with.
+  if (frame->hd.type == NGHTTP2_PUSH_PROMISE &&
+      session->stream_scheduler_ != STREAM_SCHEDULER_DEFAULT) {
+    Http2Stream* stream =
+        session->FindStream(frame->push_promise.promised_stream_id);
+    if (stream != nullptr)
+      session->RescheduleStream(stream);
+  }
   return 0;
 }
 
@@ -1208,13 +1277,31 @@ void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
   // this way for performance reasons (it's faster to generate and pass an
   // array than it is to generate and pass the object).
 
+  // The urgency scheduler looks for the priority header of new requests
+  // while the headers are transferred.
+  bool find_urgency =
+      stream_scheduler_ == STREAM_SCHEDULER_URGENCY &&
+      stream->headers_category() == NGHTTP2_HCAT_REQUEST;
+  size_t urgency = kDefaultUrgency;
+
   std::vector<Local<Value>> headers_v(stream->headers_count() * 2);
   stream->TransferHeaders([&](const Http2Header& header, size_t i) {
     headers_v[i * 2] = header.GetName(this).ToLocalChecked();
     headers_v[i * 2 + 1] = header.GetValue(this).ToLocalChecked();
+    if (find_urgency && header.name() == "priority") {
+      urgency = GetUrgency(header.value());
+      find_urgency = false;
+    }
   });
   CHECK_EQ(stream->headers_count(), 0);
 
+  if (stream_scheduler_ != STREAM_SCHEDULER_DEFAULT &&
+      stream->headers_category() == NGHTTP2_HCAT_REQUEST) {
+    if (stream_scheduler_ == STREAM_SCHEDULER_URGENCY)
+      stream->scheduled_weight_ = kUrgencyWeights[urgency];
+    RescheduleStream(stream);
+  }
+
   DecrementCurrentSessionMemory(stream->current_headers_length_);
   stream->current_headers_length_ = 0;
 
@@ -1231,9 +1318,15 @@ void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
 
 // Called by OnFrameReceived when a complete PRIORITY frame has been
 // received. Notifies JS land about the priority change. Note that priorities
-// are considered advisory only, so this has no real effect other than to
-// simply let user code know that the priority has changed.
+// are considered advisory only. nghttp2 applies them to the priority tree,
+// unless a stream scheduler other than the default one is in use, in which
+// case the stream is put back where the scheduler wants it.
 void Http2Session::HandlePriorityFrame(const nghttp2_frame* frame) {
+  if (stream_scheduler_ != STREAM_SCHEDULER_DEFAULT) {
+    Http2Stream* stream = FindStream(GetFrameID(frame));
+    if (stream != nullptr)
+      RescheduleStream(stream);
+  }
   if (js_fields_->priority_listener_count == 0) return;
   Isolate* isolate = env()->isolate();
   HandleScope scope(isolate);
@@ -1554,6 +1647,15 @@ void Http2Session::CopyDataIntoOutgoing(const uint8_t* src, size_t src_length) {
   outgoing_storage_.resize(offset + src_length);
   memcpy(&outgoing_storage_[offset], src, src_length);
 
+  // Copies that directly follow each other are adjacent in
+  // outgoing_storage_, so they are sent as one buffer.
+  if (!outgoing_buffers_.empty() &&
+      outgoing_buffers_.back().buf.base == nullptr) {
+    outgoing_buffers_.back().buf.len += src_length;
+    outgoing_length_ += src_length;
+    return;
+  }
+
   // Store with a base of `nullptr` initially, since future resizes
   // of the outgoing_buffers_ vector may invalidate the pointer.
   // The correct base pointers will be set later, before writing to the
@@ -1622,6 +1724,9 @@ uint8_t Http2Session::SendPendingData() {
   size_t offset = 0;
   size_t i = 0;
   for (const nghttp2_stream_write& write : outgoing_buffers_) {
+    // Skip the entries that only carry the WriteWrap of a copied chunk.
+    if (write.buf.len == 0)
+      continue;
     statistics_.data_sent += write.buf.len;
     if (write.buf.base == nullptr) {
       bufs[i++] = uv_buf_init(
@@ -1633,6 +1738,12 @@ uint8_t Http2Session::SendPendingData() {
     }
   }
 
+  count = i;
+  if (count == 0) {
+    ClearOutgoing(0);
+    return 0;
+  }
+
   chunks_sent_since_last_write_++;
 
   CHECK_EQ(flags_ & SESSION_STATE_WRITE_IN_PROGRESS, 0);
@@ -1681,15 +1792,31 @@ int Http2Session::OnSendData(
     if (write.buf.len <= length) {
       // This write does not suffice by itself, so we can consume it completely.
       length -= write.buf.len;
-      session->PushOutgoingBuffer(std::move(write));
+      if (write.buf.len <= kMaxCopiedDataChunkSize) {
+        session->CopyDataIntoOutgoing(
+            reinterpret_cast<const uint8_t*>(write.buf.base), write.buf.len);
+        // Keep the WriteWrap until the data has been written to the socket.
+        if (write.req_wrap != nullptr) {
+          session->PushOutgoingBuffer(nghttp2_stream_write {
+            write.req_wrap, uv_buf_init(nullptr, 0)
+          });
+        }
+      } else {
+        session->PushOutgoingBuffer(std::move(write));
+      }
       stream->queue_.pop();
       continue;
     }
 
     // Slice off `length` bytes of the first write in the queue.
-    session->PushOutgoingBuffer(nghttp2_stream_write {
-      uv_buf_init(write.buf.base, length)
-    });
+    if (length <= kMaxCopiedDataChunkSize) {
+      session->CopyDataIntoOutgoing(
+          reinterpret_cast<const uint8_t*>(write.buf.base), length);
+    } else {
+      session->PushOutgoingBuffer(nghttp2_stream_write {
+        uv_buf_init(write.buf.base, length)
+      });
+    }
     write.buf.base += length;
     write.buf.len -= length;
     break;
@@ -1697,9 +1824,9 @@ int Http2Session::OnSendData(
 
   if (frame->data.padlen > 0) {
     // Send padding if that was requested.
-    session->PushOutgoingBuffer(nghttp2_stream_write {
-      uv_buf_init(const_cast<char*>(zero_bytes_256), frame->data.padlen - 1)
-    });
+    session->CopyDataIntoOutgoing(
+        reinterpret_cast<const uint8_t*>(zero_bytes_256),
+        frame->data.padlen - 1);
   }
 
   return 0;
@@ -1807,6 +1934,29 @@ bool Http2Session::HasWritesOnSocketForStream(Http2Stream* stream) {
   return false;
 }
 
+void Http2Session::RescheduleStream(Http2Stream* stream) {
+  if (stream_scheduler_ == STREAM_SCHEDULER_DEFAULT || stream->IsDestroyed())
+    return;
+  // nghttp2 only creates the stream once its first frame is sent or
+  // received, e.g. for pushed streams.
+  nghttp2_stream* str = **stream;
+  if (str == nullptr)
+    return;
+  int32_t weight = stream_scheduler_ == STREAM_SCHEDULER_WEIGHTED ?
+      nghttp2_stream_get_weight(str) : stream->scheduled_weight_;
+  nghttp2_stream* parent = nghttp2_stream_get_parent(str);
+  if ((parent == nullptr || nghttp2_stream_get_stream_id(parent) == 0) &&
+      nghttp2_stream_get_weight(str) == weight) {
+    return;
+  }
+  Debug(this, "rescheduling stream %d with weight %d", stream->id(), weight);
+  nghttp2_priority_spec spec;
+  nghttp2_priority_spec_init(&spec, 0, weight, 0);
+  CHECK_NE(nghttp2_session_change_stream_priority(session_, stream->id(),
+                                                  &spec),
+           NGHTTP2_ERR_NOMEM);
+}
+
 // Every Http2Session session is tightly bound to a single i/o StreamBase
 // (typically a net.Socket or tls.TLSSocket). The lifecycle of the two is
 // tightly coupled with all data transfer between the two happening at the
@@ -1982,6 +2132,19 @@ int Http2Stream::SubmitResponse(const Http2Headers& headers, int options) {
   if (!IsWritable())
     options |= STREAM_OPTION_EMPTY_PAYLOAD;
 
+  if (session_->stream_scheduler() == STREAM_SCHEDULER_SMALL_FIRST) {
+    const nghttp2_nv* nva = headers.data();
+    for (size_t n = 0; n < headers.length(); n++) {
+      if (nva[n].namelen == 14 &&
+          memcmp(nva[n].name, "content-length", 14) == 0) {
+        scheduled_weight_ = GetSmallFirstWeight(
+            strtoull(reinterpret_cast<const char*>(nva[n].value), nullptr, 10));
+        session_->RescheduleStream(this);
+        break;
+      }
+    }
+  }
+
   Http2Stream::Provider::Stream prov(this, options);
   int ret = nghttp2_submit_response(
       **session_,
@@ -2106,6 +2269,9 @@ Http2Stream* Http2Stream::SubmitPushPromise(const Http2Headers& headers,
   if (*ret > 0) {
     stream = Http2Stream::New(
         session_.get(), *ret, NGHTTP2_HCAT_HEADERS, options);
+    // Pushed streams start out with the weight of their associated stream.
+    if (stream != nullptr)
+      stream->scheduled_weight_ = scheduled_weight_;
   }
 
   return stream;
@@ -2654,7 +2820,8 @@ void Http2Stream::RefreshState(const FunctionCallbackInfo<Value>& args) {
         buffer[IDX_STREAM_STATE_SUM_DEPENDENCY_WEIGHT] =
         buffer[IDX_STREAM_STATE_LOCAL_CLOSE] =
         buffer[IDX_STREAM_STATE_REMOTE_CLOSE] =
-        buffer[IDX_STREAM_STATE_LOCAL_WINDOW_SIZE] = 0;
+        buffer[IDX_STREAM_STATE_LOCAL_WINDOW_SIZE] =
+        buffer[IDX_STREAM_STATE_REMOTE_WINDOW_SIZE] = 0;
   } else {
     buffer[IDX_STREAM_STATE] =
         nghttp2_stream_get_state(str);
@@ -2668,6 +2835,8 @@ void Http2Stream::RefreshState(const FunctionCallbackInfo<Value>& args) {
         nghttp2_session_get_stream_remote_close(s, stream->id());
     buffer[IDX_STREAM_STATE_LOCAL_WINDOW_SIZE] =
         nghttp2_session_get_stream_local_window_size(s, stream->id());
+    buffer[IDX_STREAM_STATE_REMOTE_WINDOW_SIZE] =
+        nghttp2_session_get_stream_remote_window_size(s, stream->id());
   }
 }
 
@@ -3109,6 +3278,11 @@ void Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, PADDING_STRATEGY_MAX);
   NODE_DEFINE_CONSTANT(constants, PADDING_STRATEGY_CALLBACK);
 
+  NODE_DEFINE_CONSTANT(constants, STREAM_SCHEDULER_DEFAULT);
+  NODE_DEFINE_CONSTANT(constants, STREAM_SCHEDULER_WEIGHTED);
+  NODE_DEFINE_CONSTANT(constants, STREAM_SCHEDULER_URGENCY);
+  NODE_DEFINE_CONSTANT(constants, STREAM_SCHEDULER_SMALL_FIRST);
+
 #define STRING_CONSTANT(NAME, VALUE)                                          \
   NODE_DEFINE_STRING_CONSTANT(constants, "HTTP2_HEADER_" # NAME, VALUE);
 HTTP_KNOWN_HEADERS(STRING_CONSTANT)
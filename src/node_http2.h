@@ -133,6 +133,24 @@ enum padding_strategy_type {
   PADDING_STRATEGY_CALLBACK = PADDING_STRATEGY_ALIGNED
 };
 
+// The Stream Scheduler determines how the DATA frames of concurrent streams
+// share the connection. nghttp2 serves the streams that share a parent in
+// the priority tree by weighted fair queuing, so every scheduler other than
+// the default one keeps all streams directly below the root and only chooses
+// their weights. These are configurable via the options passed in to a
+// Http2Session object.
+enum stream_scheduler_type {
+  // Follow the priorities sent by the peer. This is the default.
+  STREAM_SCHEDULER_DEFAULT,
+  // Keep the weights sent by the peer but ignore stream dependencies.
+  STREAM_SCHEDULER_WEIGHTED,
+  // Derive weights from the urgency in the RFC 9218 priority header.
+  STREAM_SCHEDULER_URGENCY,
+  // Derive weights from the content-length of the response, giving the
+  // largest share to the smallest responses.
+  STREAM_SCHEDULER_SMALL_FIRST
+};
+
 enum session_state_flags {
   SESSION_STATE_NONE = 0x0,
   SESSION_STATE_HAS_SCOPE = 0x1,
@@ -197,6 +215,14 @@ class Http2Options {
     return padding_strategy_;
   }
 
+  void SetStreamScheduler(stream_scheduler_type val) {
+    stream_scheduler_ = val;
+  }
+
+  stream_scheduler_type GetStreamScheduler() const {
+    return stream_scheduler_;
+  }
+
   void SetMaxOutstandingPings(size_t max) {
     max_outstanding_pings_ = max;
   }
@@ -226,6 +252,7 @@ class Http2Options {
   uint64_t max_session_memory_ = DEFAULT_MAX_SESSION_MEMORY;
   uint32_t max_header_pairs_ = DEFAULT_MAX_HEADER_LIST_PAIRS;
   padding_strategy_type padding_strategy_ = PADDING_STRATEGY_NONE;
+  stream_scheduler_type stream_scheduler_ = STREAM_SCHEDULER_DEFAULT;
   size_t max_outstanding_pings_ = DEFAULT_MAX_PINGS;
   size_t max_outstanding_settings_ = DEFAULT_MAX_SETTINGS;
 };
@@ -460,6 +487,9 @@ class Http2Stream : public AsyncWrap,
   std::queue<nghttp2_stream_write> queue_;
   size_t available_outbound_length_ = 0;
 
+  // The weight chosen for this stream by the session's stream scheduler.
+  int32_t scheduled_weight_ = NGHTTP2_DEFAULT_WEIGHT;
+
   Http2StreamListener stream_listener_;
 
   friend class Http2Session;
@@ -577,6 +607,10 @@ class Http2Session : public AsyncWrap,
 
   inline uint32_t GetMaxHeaderPairs() const { return max_header_pairs_; }
 
+  inline stream_scheduler_type stream_scheduler() const {
+    return stream_scheduler_;
+  }
+
   inline const char* TypeName() const;
 
   inline bool IsDestroyed() {
@@ -603,6 +637,10 @@ class Http2Session : public AsyncWrap,
   // Indicates whether there currently exist outgoing buffers for this stream.
   bool HasWritesOnSocketForStream(Http2Stream* stream);
 
+  // Moves the stream below the root of the priority tree with the weight
+  // chosen by the stream scheduler. Does nothing for the default scheduler.
+  void RescheduleStream(Http2Stream* stream);
+
   // Write data from stream_buf_ to the session
   ssize_t ConsumeHTTP2Data();
 
@@ -833,6 +871,7 @@ class Http2Session : public AsyncWrap,
 
   // The StreamBase instance being used for i/o
   padding_strategy_type padding_strategy_ = PADDING_STRATEGY_NONE;
+  stream_scheduler_type stream_scheduler_ = STREAM_SCHEDULER_DEFAULT;
 
   // use this to allow timeout tracking during long-lasting writes
   uint32_t chunks_sent_since_last_write_ = 0;
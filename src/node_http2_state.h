@@ -39,6 +39,7 @@ namespace http2 {
     IDX_STREAM_STATE_LOCAL_CLOSE,
     IDX_STREAM_STATE_REMOTE_CLOSE,
     IDX_STREAM_STATE_LOCAL_WINDOW_SIZE,
+    IDX_STREAM_STATE_REMOTE_WINDOW_SIZE,
     IDX_STREAM_STATE_COUNT
   };
 
@@ -52,6 +53,7 @@ namespace http2 {
     IDX_OPTIONS_MAX_OUTSTANDING_PINGS,
     IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS,
     IDX_OPTIONS_MAX_SESSION_MEMORY,
+    IDX_OPTIONS_STREAM_SCHEDULER,
     IDX_OPTIONS_FLAGS
   };
 
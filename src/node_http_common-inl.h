@@ -144,7 +144,7 @@ v8::MaybeLocal<v8::String> NgHeader<T>::GetName(
   // a statically defined name. We can safely internalize it here.
   if (header_name != nullptr) {
     auto& static_str_map = env_->isolate_data()->http_static_strs;
-    v8::Eternal<v8::String> eternal = static_str_map[header_name];
+    v8::Eternal<v8::String>& eternal = static_str_map[header_name];
     if (eternal.IsEmpty()) {
       v8::Local<v8::String> str = OneByteString(env_->isolate(), header_name);
       eternal.Set(env_->isolate(), str);
@@ -434,6 +434,19 @@ class NgRcBufPointer : public MemoryRetainer {
         return ret;
       }
 
+      // Copying short values is cheaper than creating an external string,
+      // which needs its own allocation and a finalizer, and it releases the
+      // buffer right away.
+      if (len <= kMaxCopiedLength) {
+        v8::MaybeLocal<v8::String> ret = v8::String::NewFromOneByte(
+            env->isolate(),
+            ptr.data(),
+            v8::NewStringType::kNormal,
+            len);
+        ptr.reset();
+        return ret;
+      }
+
       allocator->StopTrackingMemory(ptr.get());
       External* h_str = new External(std::move(ptr));
       v8::MaybeLocal<v8::String> str =
@@ -445,6 +458,8 @@ class NgRcBufPointer : public MemoryRetainer {
     }
 
    private:
+    static constexpr size_t kMaxCopiedLength = 256;
+
     NgRcBufPointer<T> ptr_;
   };
 
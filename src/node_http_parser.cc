@@ -26,12 +26,20 @@
 #include "async_wrap-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
+#include "node_errors.h"
+#include "node_http_common.h"
 #include "stream_base-inl.h"
+#include "string_bytes.h"
 #include "v8.h"
 #include "llhttp.h"
 
 #include <cstdlib>  // free()
 #include <cstring>  // strdup(), strchr()
+#include <ctime>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 
 // This is a binding to llhttp (https://github.com/nodejs/llhttp)
@@ -62,6 +70,7 @@ using v8::Int32;
 using v8::Integer;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::Name;
 using v8::Number;
 using v8::Object;
 using v8::String;
@@ -74,13 +83,30 @@ const uint32_t kOnHeadersComplete = 1;
 const uint32_t kOnBody = 2;
 const uint32_t kOnMessageComplete = 3;
 const uint32_t kOnExecute = 4;
+const uint32_t kOnRequest = 5;
+const uint32_t kOnWriteComplete = 6;
 // Any more fields than this will be flushed into JS
 const size_t kMaxHeaderFieldsCount = 32;
+// Fast servers stop reading while this many requests wait for a response, or
+// while this many bytes of responses wait to be written.
+const uint32_t kMaxPendingRequests = 32;
+const size_t kMaxPendingResponseBytes = 64 * 1024;
 
 inline bool IsOWS(char c) {
   return c == ' ' || c == '\t';
 }
 
+inline bool EqualsLowerCase(const char* data, size_t length,
+                            const char* lower, size_t lower_length) {
+  if (length != lower_length)
+    return false;
+  for (size_t i = 0; i < length; i++) {
+    if (ToLower(data[i]) != lower[i])
+      return false;
+  }
+  return true;
+}
+
 // helper class for the Parser
 struct StringPtr {
   StringPtr() {
@@ -161,6 +187,276 @@ struct StringPtr {
   size_t size_;
 };
 
+// Header fields and values copied out of the parser's input, for parsers
+// that deliver headers lazily. Values are stored without trailing OWS.
+class HeaderStore {
+ public:
+  void Add(const StringPtr& field, const StringPtr& value) {
+    size_t value_size = value.size_;
+    while (value_size > 0 && IsOWS(value.str_[value_size - 1]))
+      value_size--;
+    Entry entry;
+    entry.field_offset = data_.size();
+    entry.field_size = field.size_;
+    data_.append(field.str_, field.size_);
+    entry.value_offset = data_.size();
+    entry.value_size = value_size;
+    data_.append(value.str_, value_size);
+    entries_.push_back(entry);
+  }
+
+  void Clear() {
+    data_.clear();
+    entries_.clear();
+  }
+
+  size_t size() const { return entries_.size(); }
+  size_t memory_size() const {
+    return data_.capacity() + entries_.capacity() * sizeof(Entry);
+  }
+
+  const char* field(size_t index) const {
+    return data_.data() + entries_[index].field_offset;
+  }
+  size_t field_size(size_t index) const {
+    return entries_[index].field_size;
+  }
+  const char* value(size_t index) const {
+    return data_.data() + entries_[index].value_offset;
+  }
+  size_t value_size(size_t index) const {
+    return entries_[index].value_size;
+  }
+
+ private:
+  struct Entry {
+    size_t field_offset;
+    size_t field_size;
+    size_t value_offset;
+    size_t value_size;
+  };
+
+  std::string data_;
+  std::vector<Entry> entries_;
+};
+
+// Common header names, which are turned into internalized strings that are
+// shared by all messages of an isolate. A name is only shared if a message
+// spells it exactly like this, either in lower case or in the usual mixed
+// case, e.g. "content-type" or "Content-Type".
+class KnownHeaderNames {
+ public:
+  static const KnownHeaderNames& Get() {
+    static const KnownHeaderNames names;
+    return names;
+  }
+
+  // Returns the known spelling of the given name, or nullptr.
+  const char* Find(const char* name, size_t size) const {
+    for (const std::string& known : names_) {
+      if (known.size() == size && memcmp(known.data(), name, size) == 0)
+        return known.c_str();
+    }
+    return nullptr;
+  }
+
+ private:
+  KnownHeaderNames() {
+    static const char* const lower_case[] = {
+#define V(name, value) value,
+      HTTP_REGULAR_HEADERS(V)
+      HTTP_ADDITIONAL_HEADERS(V)
+#undef V
+    };
+    for (const char* name : lower_case) {
+      std::string mixed_case = name;
+      for (size_t i = 0; i < mixed_case.size(); i++) {
+        if (i == 0 || mixed_case[i - 1] == '-')
+          mixed_case[i] = ToUpper(mixed_case[i]);
+      }
+      names_.emplace_back(name);
+      names_.push_back(std::move(mixed_case));
+    }
+  }
+
+  std::vector<std::string> names_;
+};
+
+// The JS view of a HeaderStore. Strings are only created for the fields and
+// values that JS asks for.
+class HeaderList : public BaseObject {
+ public:
+  HeaderList(Environment* env, Local<Object> wrap, HeaderStore&& store)
+      : BaseObject(env, wrap), store_(std::move(store)) {
+    MakeWeak();
+  }
+
+  static MaybeLocal<Object> New(Environment* env, HeaderStore&& store) {
+    Local<Object> obj;
+    if (!env->http_header_list_constructor_template()
+             ->NewInstance(env->context())
+             .ToLocal(&obj)) {
+      return MaybeLocal<Object>();
+    }
+    new HeaderList(env, obj, std::move(store));
+    return obj;
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("store", store_.memory_size());
+  }
+
+  SET_MEMORY_INFO_NAME(HeaderList)
+  SET_SELF_SIZE(HeaderList)
+
+  Local<String> FieldString(size_t index) const {
+    const char* name =
+        KnownHeaderNames::Get().Find(store_.field(index),
+                                     store_.field_size(index));
+    if (name == nullptr) {
+      return OneByteString(env()->isolate(),
+                           store_.field(index),
+                           store_.field_size(index));
+    }
+    auto& static_str_map = env()->isolate_data()->http_static_strs;
+    v8::Eternal<String>& eternal = static_str_map[name];
+    if (eternal.IsEmpty()) {
+      Local<String> str =
+          String::NewFromOneByte(env()->isolate(),
+                                 reinterpret_cast<const uint8_t*>(name),
+                                 v8::NewStringType::kInternalized)
+              .ToLocalChecked();
+      eternal.Set(env()->isolate(), str);
+      return str;
+    }
+    return eternal.Get(env()->isolate());
+  }
+
+  Local<String> ValueString(size_t index) const {
+    return OneByteString(env()->isolate(),
+                         store_.value(index),
+                         store_.value_size(index));
+  }
+
+  // list.count()
+  static void Count(const FunctionCallbackInfo<Value>& args) {
+    HeaderList* list;
+    ASSIGN_OR_RETURN_UNWRAP(&list, args.Holder());
+    args.GetReturnValue().Set(static_cast<double>(list->store_.size()));
+  }
+
+  // list.field(index)
+  static void FieldAt(const FunctionCallbackInfo<Value>& args) {
+    HeaderList* list;
+    ASSIGN_OR_RETURN_UNWRAP(&list, args.Holder());
+    CHECK(args[0]->IsUint32());
+    uint32_t index = args[0].As<Uint32>()->Value();
+    CHECK_LT(index, list->store_.size());
+    args.GetReturnValue().Set(list->FieldString(index));
+  }
+
+  // list.value(index)
+  static void ValueAt(const FunctionCallbackInfo<Value>& args) {
+    HeaderList* list;
+    ASSIGN_OR_RETURN_UNWRAP(&list, args.Holder());
+    CHECK(args[0]->IsUint32());
+    uint32_t index = args[0].As<Uint32>()->Value();
+    CHECK_LT(index, list->store_.size());
+    args.GetReturnValue().Set(list->ValueString(index));
+  }
+
+  // list.find(name, start) returns the index of the first header at or after
+  // `start` whose field matches `name` case-insensitively, or -1.
+  static void Find(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    HeaderList* list;
+    ASSIGN_OR_RETURN_UNWRAP(&list, args.Holder());
+    CHECK(args[0]->IsString());
+    CHECK(args[1]->IsUint32());
+    Utf8Value name(env->isolate(), args[0]);
+    const HeaderStore& store = list->store_;
+    for (size_t i = args[1].As<Uint32>()->Value(); i < store.size(); i++) {
+      if (store.field_size(i) == name.length() &&
+          StringEqualNoCaseN(store.field(i), *name, name.length())) {
+        return args.GetReturnValue().Set(static_cast<double>(i));
+      }
+    }
+    args.GetReturnValue().Set(-1);
+  }
+
+  // list.toArray() returns the headers in the same form as the parser does
+  // without lazy headers, i.e. [field, value, field, value, ...].
+  static void ToArray(const FunctionCallbackInfo<Value>& args) {
+    HeaderList* list;
+    ASSIGN_OR_RETURN_UNWRAP(&list, args.Holder());
+    size_t count = list->store_.size();
+    MaybeStackBuffer<Local<Value>, kMaxHeaderFieldsCount * 2> headers_v(
+        count * 2);
+    for (size_t i = 0; i < count; i++) {
+      headers_v[i * 2] = list->FieldString(i);
+      headers_v[i * 2 + 1] = list->ValueString(i);
+    }
+    args.GetReturnValue().Set(
+        Array::New(list->env()->isolate(), headers_v.out(), count * 2));
+  }
+
+ private:
+  HeaderStore store_;
+};
+
+// Bits that SerializeHeaders() sets for the headers that _storeHeader() in
+// lib/_http_outgoing.js needs to know about.
+enum HeaderFlags : uint32_t {
+  kHeaderConnection = 1 << 0,
+  kHeaderConnectionClose = 1 << 1,
+  kHeaderConnectionKeepAlive = 1 << 2,
+  kHeaderTransferEncoding = 1 << 3,
+  kHeaderChunked = 1 << 4,
+  kHeaderContentLength = 1 << 5,
+  kHeaderDate = 1 << 6,
+  kHeaderExpect = 1 << 7,
+  kHeaderTrailer = 1 << 8
+};
+
+// Appends `str` to `out` as Latin-1.
+void AppendLatin1(Environment* env, std::string* out, Local<String> str) {
+  size_t offset = out->size();
+  out->resize(offset + str->Length());
+  str->WriteOneByte(env->isolate(),
+                    reinterpret_cast<uint8_t*>(&(*out)[offset]),
+                    0, str->Length(), String::NO_NULL_TERMINATION);
+}
+
+// Returns the current time in the format of the Date header, e.g.
+// "Sun, 06 Nov 1994 08:49:37 GMT". The result changes once per second.
+const char* HttpDate() {
+  static const char* const kDays[] = {
+    "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
+  };
+  static const char* const kMonths[] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+  };
+  thread_local time_t cached_time = -1;
+  thread_local char cached_date[32];
+
+  time_t now = time(nullptr);
+  if (now != cached_time) {
+    struct tm t;
+#ifdef _WIN32
+    gmtime_s(&t, &now);
+#else
+    gmtime_r(&now, &t);
+#endif
+    snprintf(cached_date, sizeof(cached_date),
+             "%s, %02d %s %04d %02d:%02d:%02d GMT",
+             kDays[t.tm_wday], t.tm_mday, kMonths[t.tm_mon],
+             t.tm_year + 1900, t.tm_hour, t.tm_min, t.tm_sec);
+    cached_time = now;
+  }
+  return cached_date;
+}
+
 class Parser : public AsyncWrap, public StreamListener {
  public:
   Parser(Environment* env, Local<Object> wrap)
@@ -172,6 +468,10 @@ class Parser : public AsyncWrap, public StreamListener {
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     tracker->TrackField("current_buffer", current_buffer_);
+    tracker->TrackFieldWithSize("pending_headers",
+                                pending_headers_.memory_size());
+    tracker->TrackFieldWithSize("body", body_.capacity());
+    tracker->TrackFieldWithSize("paused_input", paused_input_.capacity());
   }
 
   SET_MEMORY_INFO_NAME(Parser)
@@ -179,6 +479,8 @@ class Parser : public AsyncWrap, public StreamListener {
 
   int on_message_begin() {
     num_fields_ = num_values_ = 0;
+    headers_complete_ = false;
+    pending_headers_.Clear();
     url_.Reset();
     status_message_.Reset();
     return 0;
@@ -217,8 +519,12 @@ class Parser : public AsyncWrap, public StreamListener {
       // start of new field name
       num_fields_++;
       if (num_fields_ == kMaxHeaderFieldsCount) {
-        // ran out of space - flush to javascript land
-        Flush();
+        // ran out of space - flush to javascript land, or keep the headers
+        // natively if they are delivered lazily
+        if (lazy_headers_ && !headers_complete_)
+          StashHeaders();
+        else
+          Flush();
         num_fields_ = 1;
         num_values_ = 0;
       }
@@ -257,6 +563,26 @@ class Parser : public AsyncWrap, public StreamListener {
 
   int on_headers_complete() {
     header_nread_ = 0;
+    headers_complete_ = true;
+
+    if (fast_) {
+      // Fast servers do not support Upgrade and CONNECT requests.
+      if (parser_.upgrade)
+        return -1;
+      StashHeaders();
+      num_fields_ = 0;
+      num_values_ = 0;
+      uint32_t reject_status = CheckExpectation();
+      if (reject_status == 0)
+        return 0;
+      // Answer right away instead of waiting for a body that the client
+      // does not send, and do not read anything after this request.
+      rejected_ = true;
+      PauseFast();
+      if (DeliverRequest(reject_status) != 0)
+        return -1;
+      return HPE_PAUSED;
+    }
 
     // Arguments for the on-headers-complete javascript callback. This
     // list needs to be kept in sync with the actual argument list for
@@ -289,6 +615,19 @@ class Parser : public AsyncWrap, public StreamListener {
     if (have_flushed_) {
       // Slow case, flush remaining headers.
       Flush();
+    } else if (lazy_headers_) {
+      // Pass a HeaderList instead of strings.
+      StashHeaders();
+      Local<Object> headers;
+      if (!HeaderList::New(env(), std::move(pending_headers_))
+               .ToLocal(&headers)) {
+        got_exception_ = true;
+        return -1;
+      }
+      pending_headers_.Clear();
+      argv[A_HEADERS] = headers;
+      if (parser_.type == HTTP_REQUEST)
+        argv[A_URL] = url_.ToString(env());
     } else {
       // Fast case, pass headers and URL to JS land.
       argv[A_HEADERS] = CreateHeaders();
@@ -347,6 +686,15 @@ class Parser : public AsyncWrap, public StreamListener {
 
 
   int on_body(const char* at, size_t length) {
+    if (fast_) {
+      if (body_.size() + length > max_body_size_) {
+        llhttp_set_error_reason(&parser_, "HPE_BODY_OVERFLOW:Body overflow");
+        return HPE_USER;
+      }
+      body_.append(at, length);
+      return 0;
+    }
+
     EscapableHandleScope scope(env()->isolate());
 
     Local<Object> obj = object();
@@ -387,6 +735,17 @@ class Parser : public AsyncWrap, public StreamListener {
   int on_message_complete() {
     HandleScope scope(env()->isolate());
 
+    if (fast_) {
+      // Trailers are ignored.
+      if (DeliverRequest(0) != 0)
+        return -1;
+      if (!ShouldPauseFast())
+        return 0;
+      // Keep the rest of the input until the responses have caught up.
+      PauseFast();
+      return HPE_PAUSED;
+    }
+
     if (num_fields_)
       Flush();  // Flush trailing HTTP headers.
 
@@ -502,6 +861,7 @@ class Parser : public AsyncWrap, public StreamListener {
   static void Initialize(const FunctionCallbackInfo<Value>& args) {
     Environment* env = Environment::GetCurrent(args);
     bool lenient = args[3]->IsTrue();
+    bool lazy_headers = args[4]->IsTrue();
 
     uint64_t max_http_header_size = 0;
 
@@ -532,7 +892,7 @@ class Parser : public AsyncWrap, public StreamListener {
 
     parser->set_provider_type(provider);
     parser->AsyncReset(args[1].As<Object>());
-    parser->Init(type, max_http_header_size, lenient);
+    parser->Init(type, max_http_header_size, lenient, lazy_headers);
   }
 
   template <bool should_pause>
@@ -578,6 +938,112 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  static void EnableFastMode(const FunctionCallbackInfo<Value>& args) {
+    Parser* parser;
+    ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
+    CHECK(args[0]->IsNumber());
+    parser->fast_ = true;
+    parser->lazy_headers_ = true;
+    parser->max_body_size_ = args[0].As<Number>()->Value();
+  }
+
+
+  // parser.respond(id, statusCode, statusMessage, headerLines, headerFlags,
+  //                body, keepAlive, isHead) writes the response to the
+  // request with the given id. Responses are written in the order of their
+  // requests. Returns the number of responses that have been written so far.
+  // Write errors are reported through kOnWriteComplete.
+  static void Respond(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    Parser* parser;
+    ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
+    CHECK(parser->fast_);
+    CHECK(args[0]->IsUint32());
+    CHECK(args[1]->IsUint32());
+    CHECK(args[2]->IsString());
+    CHECK(args[4]->IsUint32());
+    // serializeHeaders() returns undefined for headers it cannot serialize.
+    if (!args[3]->IsString()) {
+      return THROW_ERR_INVALID_ARG_VALUE(
+          env, "The response headers cannot be serialized");
+    }
+
+    uint32_t id = args[0].As<Uint32>()->Value();
+    uint32_t status = args[1].As<Uint32>()->Value();
+    uint32_t flags = args[4].As<Uint32>()->Value();
+    bool keep_alive = args[6]->IsTrue();
+    bool is_head = args[7]->IsTrue();
+    CHECK_GE(id, parser->next_response_id_);
+    CHECK_LT(id, parser->next_request_id_);
+
+    const char* body_data = nullptr;
+    size_t body_size = 0;
+    ArrayBufferViewContents<char> body_view;
+    MaybeStackBuffer<char> body_string;
+    if (args[5]->IsArrayBufferView()) {
+      body_view.Read(args[5].As<v8::ArrayBufferView>());
+      body_data = body_view.data();
+      body_size = body_view.length();
+    } else if (args[5]->IsString()) {
+      Local<String> str = args[5].As<String>();
+      body_string.AllocateSufficientStorage(
+          StringBytes::StorageSize(env->isolate(), str, UTF8).FromJust());
+      body_size = StringBytes::Write(env->isolate(), *body_string,
+                                     body_string.length(), str, UTF8);
+      body_data = *body_string;
+    }
+
+    // 1xx, 204 and 304 responses never have a body.
+    bool no_body = status < 200 || status == 204 || status == 304;
+
+    std::string head = "HTTP/1.1 " + std::to_string(status) + " ";
+    AppendLatin1(env, &head, args[2].As<String>());
+    head += "\r\n";
+    AppendLatin1(env, &head, args[3].As<String>());
+    if (!(flags & kHeaderDate)) {
+      head += "Date: ";
+      head += HttpDate();
+      head += "\r\n";
+    }
+    if (!(flags & kHeaderConnection)) {
+      if (keep_alive)
+        head += "Connection: keep-alive\r\n";
+      else
+        head += "Connection: close\r\n";
+    }
+    if (!no_body && !(flags & kHeaderContentLength))
+      head += "Content-Length: " + std::to_string(body_size) + "\r\n";
+    head += "\r\n";
+
+    if (no_body || is_head)
+      body_size = 0;
+    AllocatedBuffer response = env->AllocateManaged(head.size() + body_size);
+    memcpy(response.data(), head.data(), head.size());
+    if (body_size > 0)
+      memcpy(response.data() + head.size(), body_data, body_size);
+
+    if (id != parser->next_response_id_) {
+      // Wait for the responses to the earlier requests. There are at most
+      // kMaxPendingRequests of them, see ShouldPauseFast().
+      parser->early_responses_.emplace(id, std::move(response));
+      return args.GetReturnValue().Set(parser->next_response_id_);
+    }
+
+    parser->WriteResponse(std::move(response));
+    auto it = parser->early_responses_.begin();
+    while (it != parser->early_responses_.end() &&
+           it->first == parser->next_response_id_) {
+      parser->WriteResponse(std::move(it->second));
+      it = parser->early_responses_.erase(it);
+    }
+    if (parser->ShouldPauseFast())
+      parser->PauseFast();
+    else
+      parser->MaybeResumeFast();
+    args.GetReturnValue().Set(parser->next_response_id_);
+  }
+
+
   static void GetCurrentBuffer(const FunctionCallbackInfo<Value>& args) {
     Parser* parser;
     ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
@@ -630,6 +1096,15 @@ class Parser : public AsyncWrap, public StreamListener {
       return;
 
     current_buffer_.Clear();
+
+    if (fast_) {
+      if (fast_paused_)
+        paused_input_.append(buf.base, nread);
+      else
+        ExecuteFast(buf.base, nread);
+      return;
+    }
+
     Local<Value> ret = Execute(buf.base, nread);
 
     // Exception
@@ -653,6 +1128,17 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  void OnStreamAfterWrite(WriteWrap* w, int status) override {
+    auto it = pending_writes_.find(w);
+    if (it != pending_writes_.end()) {
+      pending_write_bytes_ -= it->second;
+      pending_writes_.erase(it);
+      MaybeResumeFast();
+    }
+    StreamListener::OnStreamAfterWrite(w, status);
+  }
+
+
   Local<Value> Execute(const char* data, size_t len) {
     EscapableHandleScope scope(env()->isolate());
 
@@ -684,6 +1170,13 @@ class Parser : public AsyncWrap, public StreamListener {
         err = HPE_OK;
         llhttp_resume_after_upgrade(&parser_);
       }
+
+      // A fast server stopped reading, see PauseFast(). Its parser stays
+      // paused until MaybeResumeFast() parses the rest of the input.
+      if (err == HPE_PAUSED && fast_paused_) {
+        err = HPE_OK;
+        paused_input_.append(data + nread, len - nread);
+      }
     }
 
     // Apply pending pause
@@ -752,6 +1245,229 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  // Hands a complete request to JS in fast mode. If `reject_status` is not 0,
+  // the request is answered with that status code instead of being passed to
+  // the server's 'request' listeners.
+  int DeliverRequest(uint32_t reject_status) {
+    num_fields_ = 0;
+    num_values_ = 0;
+
+    Local<Value> cb = object()->Get(env()->context(),
+                                    kOnRequest).ToLocalChecked();
+    if (!cb->IsFunction())
+      return 0;
+
+    Local<Object> headers;
+    if (!HeaderList::New(env(), std::move(pending_headers_))
+             .ToLocal(&headers)) {
+      got_exception_ = true;
+      return -1;
+    }
+    pending_headers_.Clear();
+
+    Local<Value> body = Undefined(env()->isolate());
+    if (!body_.empty()) {
+      Local<Object> buffer;
+      if (!Buffer::Copy(env(), body_.data(), body_.size()).ToLocal(&buffer)) {
+        got_exception_ = true;
+        return -1;
+      }
+      body = buffer;
+      body_.clear();
+    }
+
+    // Keep in sync with onRequest() in lib/internal/http/fast_server.js.
+    Local<Value> argv[] = {
+      Integer::NewFromUnsigned(env()->isolate(), next_request_id_++),
+      Uint32::NewFromUnsigned(env()->isolate(), parser_.method),
+      url_.ToString(env()),
+      headers,
+      body,
+      Integer::New(env()->isolate(), parser_.http_major),
+      Integer::New(env()->isolate(), parser_.http_minor),
+      Boolean::New(env()->isolate(), llhttp_should_keep_alive(&parser_)),
+      Integer::NewFromUnsigned(env()->isolate(), reject_status)
+    };
+
+    MaybeLocal<Value> r;
+    {
+      InternalCallbackScope callback_scope(
+          this, InternalCallbackScope::kSkipTaskQueues);
+      r = cb.As<Function>()->Call(
+          env()->context(), object(), arraysize(argv), argv);
+      if (r.IsEmpty()) callback_scope.MarkAsFailed();
+    }
+
+    if (r.IsEmpty()) {
+      got_exception_ = true;
+      return -1;
+    }
+
+    return 0;
+  }
+
+
+  void WriteResponse(AllocatedBuffer&& response) {
+    next_response_id_++;
+    WriteToStream(std::move(response));
+    MaybeWriteContinue();
+  }
+
+
+  // Writes `data` to the stream. The result is reported to kOnWriteComplete,
+  // including synchronous failures.
+  void WriteToStream(AllocatedBuffer&& data) {
+    Local<Value> cb = object()->Get(env()->context(),
+                                    kOnWriteComplete).ToLocalChecked();
+    int err = UV_EBADF;
+    Local<Object> req_wrap_obj;
+    if (stream_ != nullptr &&
+        env()->write_wrap_template()
+            ->NewInstance(env()->context())
+            .ToLocal(&req_wrap_obj)) {
+      StreamReq::ResetObject(req_wrap_obj);
+      if (cb->IsFunction()) {
+        req_wrap_obj->Set(env()->context(),
+                          env()->oncomplete_string(),
+                          cb).Check();
+      }
+
+      size_t size = data.size();
+      uv_buf_t buf = uv_buf_init(data.data(), size);
+      StreamWriteResult res = static_cast<StreamBase*>(stream_)->Write(
+          &buf, 1, nullptr, req_wrap_obj);
+      err = res.err;
+      if (res.async) {
+        res.wrap->SetAllocatedStorage(std::move(data));
+        pending_writes_.emplace(res.wrap, size);
+        pending_write_bytes_ += size;
+      }
+    }
+
+    if (err != 0 && cb->IsFunction()) {
+      Local<Value> argv[] = { Integer::New(env()->isolate(), err) };
+      MakeCallback(cb.As<Function>(), arraysize(argv), argv);
+    }
+  }
+
+
+  // Returns the status code that a request to a fast server is rejected with
+  // because of its Expect header, or 0. A request that expects 100-continue
+  // gets the interim response once the responses to the earlier requests
+  // have been written. HTTP/1.0 requests can not have expectations.
+  uint32_t CheckExpectation() {
+    if (parser_.http_major == 1 && parser_.http_minor == 0)
+      return 0;
+    for (size_t i = 0; i < pending_headers_.size(); i++) {
+      if (!EqualsLowerCase(pending_headers_.field(i),
+                           pending_headers_.field_size(i),
+                           "expect", 6)) {
+        continue;
+      }
+      if (!EqualsLowerCase(pending_headers_.value(i),
+                           pending_headers_.value_size(i),
+                           "100-continue", 12)) {
+        return 417;
+      }
+      if (parser_.content_length > max_body_size_)
+        return 413;
+      continue_id_ = next_request_id_;
+      send_continue_ = true;
+      MaybeWriteContinue();
+      return 0;
+    }
+    return 0;
+  }
+
+
+  void MaybeWriteContinue() {
+    if (!send_continue_ || continue_id_ != next_response_id_)
+      return;
+    send_continue_ = false;
+    static const char kContinue[] = "HTTP/1.1 100 Continue\r\n\r\n";
+    AllocatedBuffer data = env()->AllocateManaged(sizeof(kContinue) - 1);
+    memcpy(data.data(), kContinue, sizeof(kContinue) - 1);
+    WriteToStream(std::move(data));
+  }
+
+
+  bool ShouldPauseFast() const {
+    return next_request_id_ - next_response_id_ >= kMaxPendingRequests ||
+           pending_write_bytes_ >= kMaxPendingResponseBytes;
+  }
+
+
+  // Stops reading requests. When called while parsing, the parser has to be
+  // paused as well; Execute() then keeps the rest of the input.
+  void PauseFast() {
+    if (fast_paused_)
+      return;
+    fast_paused_ = true;
+    if (stream_ != nullptr)
+      stream_->ReadStop();
+  }
+
+
+  void MaybeResumeFast() {
+    if (!fast_paused_ || rejected_ || resume_scheduled_ || ShouldPauseFast())
+      return;
+    resume_scheduled_ = true;
+
+    // Parse the kept input outside of the current call, which may come from
+    // a 'request' listener.
+    StreamResource* stream = stream_;
+    BaseObjectPtr<Parser> strong_ref{this};
+    env()->SetImmediate([this, strong_ref, stream](Environment* env) {
+      resume_scheduled_ = false;
+      // The parser may have been freed and reused for another connection.
+      if (!fast_paused_ || stream == nullptr || stream_ != stream ||
+          ShouldPauseFast()) {
+        return;
+      }
+      HandleScope handle_scope(env->isolate());
+      Context::Scope context_scope(env->context());
+      fast_paused_ = false;
+      if (llhttp_get_errno(&parser_) == HPE_PAUSED)
+        llhttp_resume(&parser_);
+      std::string input = std::move(paused_input_);
+      paused_input_.clear();
+      if (!input.empty())
+        ExecuteFast(input.data(), input.size());
+      if (!fast_paused_ && stream_ != nullptr)
+        stream_->ReadStart();
+    });
+  }
+
+
+  // Parses input of a fast server, which is only told about parse errors.
+  void ExecuteFast(const char* data, size_t len) {
+    Local<Value> ret = Execute(data, len);
+    if (ret.IsEmpty() || !ret->IsObject())
+      return;
+
+    Local<Value> cb =
+        object()->Get(env()->context(), kOnExecute).ToLocalChecked();
+    if (!cb->IsFunction())
+      return;
+
+    // Hooks for GetCurrentBuffer
+    current_buffer_len_ = len;
+    current_buffer_data_ = data;
+
+    MakeCallback(cb.As<Function>(), 1, &ret);
+
+    current_buffer_len_ = 0;
+    current_buffer_data_ = nullptr;
+  }
+
+
+  // Copy the headers that have been parsed so far into pending_headers_.
+  void StashHeaders() {
+    for (size_t i = 0; i < num_values_; ++i)
+      pending_headers_.Add(fields_[i], values_[i]);
+  }
+
+
   // spill headers and request path to JS land
   void Flush() {
     HandleScope scope(env()->isolate());
@@ -779,7 +1495,10 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
-  void Init(llhttp_type_t type, uint64_t max_http_header_size, bool lenient) {
+  void Init(llhttp_type_t type,
+            uint64_t max_http_header_size,
+            bool lenient,
+            bool lazy_headers) {
     llhttp_init(&parser_, type, &settings);
     llhttp_set_lenient(&parser_, lenient);
     header_nread_ = 0;
@@ -790,6 +1509,22 @@ class Parser : public AsyncWrap, public StreamListener {
     have_flushed_ = false;
     got_exception_ = false;
     max_http_header_size_ = max_http_header_size;
+    lazy_headers_ = lazy_headers;
+    headers_complete_ = false;
+    pending_headers_.Clear();
+    fast_ = false;
+    max_body_size_ = 0;
+    body_.clear();
+    next_request_id_ = 0;
+    next_response_id_ = 0;
+    early_responses_.clear();
+    pending_writes_.clear();
+    pending_write_bytes_ = 0;
+    fast_paused_ = false;
+    rejected_ = false;
+    paused_input_.clear();
+    send_continue_ = false;
+    continue_id_ = 0;
   }
 
 
@@ -823,6 +1558,27 @@ class Parser : public AsyncWrap, public StreamListener {
   size_t num_fields_;
   size_t num_values_;
   bool have_flushed_;
+  bool lazy_headers_ = false;
+  bool headers_complete_ = false;
+  HeaderStore pending_headers_;
+  // State of fast servers, see EnableFastMode().
+  bool fast_ = false;
+  uint64_t max_body_size_ = 0;
+  std::string body_;
+  uint32_t next_request_id_ = 0;
+  uint32_t next_response_id_ = 0;
+  std::map<uint32_t, AllocatedBuffer> early_responses_;
+  // Responses that are being written, and their sizes.
+  std::unordered_map<WriteWrap*, size_t> pending_writes_;
+  size_t pending_write_bytes_ = 0;
+  bool fast_paused_ = false;
+  bool resume_scheduled_ = false;
+  // Set once a request has been rejected; nothing after it is read.
+  bool rejected_ = false;
+  std::string paused_input_;
+  // The request that waits for a 100 Continue response.
+  bool send_continue_ = false;
+  uint32_t continue_id_ = 0;
   bool got_exception_;
   Local<Object> current_buffer_;
   size_t current_buffer_len_;
@@ -867,6 +1623,339 @@ const llhttp_settings_t Parser::settings = {
 };
 
 
+// The shapes of header collections that _storeHeader() accepts.
+enum HeaderSource : int32_t {
+  kHeaderSourceOutHeaders,  // Object of [name, value], already validated.
+  kHeaderSourceEntries,     // Array of [name, value].
+  kHeaderSourceObject       // Own properties of a plain object.
+};
+
+// Same as checkIsHttpToken() in lib/_http_common.js.
+inline bool IsHttpTokenChar(uint8_t c) {
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+      (c >= '0' && c <= '9')) {
+    return true;
+  }
+  switch (c) {
+    case '!': case '#': case '$': case '%': case '&': case '\'':
+    case '*': case '+': case '-': case '.': case '^': case '_':
+    case '`': case '|': case '~':
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Same as checkInvalidHeaderChar() in lib/_http_common.js, inverted.
+inline bool IsHeaderValueChar(uint8_t c) {
+  return c == '\t' || (c >= 0x20 && c != 0x7f);
+}
+
+inline bool IsWordChar(uint8_t c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_';
+}
+
+// Same as /(?:^|\W)<word>(?:$|\W)/i.test(value).
+bool ContainsWord(const char* data, size_t length,
+                  const char* word, size_t word_length) {
+  for (size_t i = 0; i + word_length <= length; i++) {
+    if (i > 0 && IsWordChar(data[i - 1]))
+      continue;
+    if (i + word_length < length && IsWordChar(data[i + word_length]))
+      continue;
+    if (EqualsLowerCase(data + i, word_length, word, word_length))
+      return true;
+  }
+  return false;
+}
+
+// True if reading `key` from `object` could run JS, because the property is
+// an accessor. Proxies have to be ruled out by the caller.
+bool HasAccessor(Local<Context> context, Local<Object> object,
+                 Local<Name> key) {
+  return object->HasRealNamedCallbackProperty(context, key).FromMaybe(true);
+}
+
+bool HasAccessor(Local<Context> context, Local<Array> array, uint32_t index) {
+  Local<String> key;
+  return !Uint32::NewFromUnsigned(context->GetIsolate(), index)
+              ->ToString(context).ToLocal(&key) ||
+         HasAccessor(context, array, key);
+}
+
+// Builds the "name: value\r\n" lines of an outgoing message head. Anything
+// that the JS implementation would reject or coerce in a user-visible way
+// makes Add() fail, so that the caller can fall back to JS and throw the
+// same errors. So does anything that would run JS code, i.e. proxies and
+// accessors, so that it does not run a second time in the fallback.
+class HeaderSerializer {
+ public:
+  HeaderSerializer(Environment* env, bool validate)
+      : env_(env), validate_(validate) {
+    head_.reserve(512);
+  }
+
+  bool Add(Local<Value> name, Local<Value> value) {
+    if (!name->IsString())
+      return false;
+    Local<String> name_string = name.As<String>();
+    if (!value->IsArray())
+      return AddLine(name_string, value);
+
+    Local<Array> values = value.As<Array>();
+    uint32_t length = values->Length();
+    // Nothing is sent for an empty array, but JS still validates the name.
+    if (length == 0)
+      return false;
+    if (length >= 2 && IsCookie(name_string)) {
+      // Cookies are joined into a single line, as with values.join('; ').
+      return AddCookieLine(name_string, values);
+    }
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> item;
+      if (HasAccessor(env_->context(), values, i) ||
+          !values->Get(env_->context(), i).ToLocal(&item) ||
+          !AddLine(name_string, item)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const std::string& head() const { return head_; }
+  uint32_t flags() const { return flags_; }
+
+ private:
+  bool IsCookie(Local<String> name) {
+    char buf[6];
+    if (name->Length() != sizeof(buf) || !name->ContainsOnlyOneByte())
+      return false;
+    name->WriteOneByte(env_->isolate(), reinterpret_cast<uint8_t*>(buf),
+                       0, sizeof(buf), String::NO_NULL_TERMINATION);
+    return EqualsLowerCase(buf, sizeof(buf), "cookie", 6);
+  }
+
+  // Appends `str` to the head as Latin-1 and returns its offset.
+  bool Append(Local<String> str, size_t* offset) {
+    if (!str->ContainsOnlyOneByte())
+      return false;
+    *offset = head_.size();
+    size_t length = str->Length();
+    head_.resize(*offset + length);
+    str->WriteOneByte(env_->isolate(),
+                      reinterpret_cast<uint8_t*>(&head_[*offset]),
+                      0, length, String::NO_NULL_TERMINATION);
+    return true;
+  }
+
+  // Only strings and numbers are serialized natively; other values are
+  // left to JS so that their conversion to string happens there.
+  bool ToHeaderString(Local<Value> value, Local<String>* out) {
+    if (value->IsString()) {
+      *out = value.As<String>();
+      return true;
+    }
+    if (value->IsNumber())
+      return value->ToString(env_->context()).ToLocal(out);
+    return false;
+  }
+
+  bool AppendName(Local<String> name, size_t* offset, size_t* length) {
+    if (!Append(name, offset))
+      return false;
+    *length = head_.size() - *offset;
+    if (validate_) {
+      if (*length == 0)
+        return false;
+      for (size_t i = *offset; i < head_.size(); i++) {
+        if (!IsHttpTokenChar(head_[i]))
+          return false;
+      }
+    }
+    head_ += ": ";
+    return true;
+  }
+
+  bool ValidateValue(size_t offset) {
+    if (!validate_)
+      return true;
+    for (size_t i = offset; i < head_.size(); i++) {
+      if (!IsHeaderValueChar(head_[i]))
+        return false;
+    }
+    return true;
+  }
+
+  bool AddLine(Local<String> name, Local<Value> value) {
+    Local<String> value_string;
+    size_t name_offset, name_length, value_offset;
+    if (!ToHeaderString(value, &value_string) ||
+        !AppendName(name, &name_offset, &name_length) ||
+        !Append(value_string, &value_offset) ||
+        !ValidateValue(value_offset)) {
+      return false;
+    }
+    Match(name_offset, name_length, value_offset);
+    head_ += "\r\n";
+    return true;
+  }
+
+  bool AddCookieLine(Local<String> name, Local<Array> values) {
+    size_t name_offset, name_length, value_offset;
+    if (!AppendName(name, &name_offset, &name_length))
+      return false;
+    value_offset = head_.size();
+    for (uint32_t i = 0; i < values->Length(); i++) {
+      Local<Value> item;
+      if (HasAccessor(env_->context(), values, i) ||
+          !values->Get(env_->context(), i).ToLocal(&item)) {
+        return false;
+      }
+      if (i > 0)
+        head_ += "; ";
+      // Array.prototype.join() turns null and undefined into ''.
+      if (item->IsNullOrUndefined())
+        continue;
+      Local<String> item_string;
+      size_t offset;
+      if (!ToHeaderString(item, &item_string) ||
+          !Append(item_string, &offset)) {
+        return false;
+      }
+    }
+    if (!ValidateValue(value_offset))
+      return false;
+    Match(name_offset, name_length, value_offset);
+    head_ += "\r\n";
+    return true;
+  }
+
+  // Same as matchHeader() in lib/_http_outgoing.js.
+  void Match(size_t name_offset, size_t name_length, size_t value_offset) {
+    if (name_length < 4 || name_length > 17)
+      return;
+    const char* name = head_.data() + name_offset;
+    const char* value = head_.data() + value_offset;
+    size_t value_length = head_.size() - value_offset;
+#define MATCHES(lower)                                                        \
+    EqualsLowerCase(name, name_length, lower, sizeof(lower) - 1)
+    if (MATCHES("connection")) {
+      flags_ |= kHeaderConnection;
+      if (ContainsWord(value, value_length, "close", 5))
+        flags_ |= kHeaderConnectionClose;
+      else
+        flags_ |= kHeaderConnectionKeepAlive;
+    } else if (MATCHES("transfer-encoding")) {
+      flags_ |= kHeaderTransferEncoding;
+      if (ContainsWord(value, value_length, "chunked", 7))
+        flags_ |= kHeaderChunked;
+    } else if (MATCHES("content-length")) {
+      flags_ |= kHeaderContentLength;
+    } else if (MATCHES("date")) {
+      flags_ |= kHeaderDate;
+    } else if (MATCHES("expect")) {
+      flags_ |= kHeaderExpect;
+    } else if (MATCHES("trailer")) {
+      flags_ |= kHeaderTrailer;
+    }
+#undef MATCHES
+  }
+
+  Environment* env_;
+  bool validate_;
+  uint32_t flags_ = 0;
+  std::string head_;
+};
+
+// serializeHeaders(headers, source, flags) validates and serializes the
+// header lines of an outgoing message. Returns the lines as a Latin-1 string
+// and stores the HeaderFlags in flags[0], or returns undefined if the JS
+// implementation has to handle the headers instead.
+void SerializeHeaders(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsInt32());
+  CHECK(args[2]->IsUint32Array());
+
+  Local<Object> headers = args[0].As<Object>();
+  HeaderSource source =
+      static_cast<HeaderSource>(args[1].As<Int32>()->Value());
+  HeaderSerializer serializer(env, source != kHeaderSourceOutHeaders);
+
+  // Array.isArray() is also true for a proxy of an array.
+  if (headers->IsProxy())
+    return;
+
+  if (source == kHeaderSourceEntries) {
+    CHECK(headers->IsArray());
+    Local<Array> entries = headers.As<Array>();
+    for (uint32_t i = 0; i < entries->Length(); i++) {
+      Local<Value> entry;
+      Local<Value> name;
+      Local<Value> value;
+      if (HasAccessor(context, entries, i) ||
+          !entries->Get(context, i).ToLocal(&entry) || !entry->IsArray() ||
+          HasAccessor(context, entry.As<Array>(), 0) ||
+          HasAccessor(context, entry.As<Array>(), 1) ||
+          !entry.As<Array>()->Get(context, 0).ToLocal(&name) ||
+          !entry.As<Array>()->Get(context, 1).ToLocal(&value) ||
+          !serializer.Add(name, value)) {
+        return;
+      }
+    }
+  } else {
+    // The same keys that `for...in` with a hasOwnProperty() check visits.
+    Local<Array> keys;
+    if (!headers->GetPropertyNames(context,
+                                   v8::KeyCollectionMode::kOwnOnly,
+                                   static_cast<v8::PropertyFilter>(
+                                       v8::ONLY_ENUMERABLE |
+                                       v8::SKIP_SYMBOLS),
+                                   v8::IndexFilter::kIncludeIndices,
+                                   v8::KeyConversionMode::kConvertToString)
+             .ToLocal(&keys)) {
+      return;
+    }
+    for (uint32_t i = 0; i < keys->Length(); i++) {
+      Local<Value> key;
+      Local<Value> value;
+      if (!keys->Get(context, i).ToLocal(&key) ||
+          HasAccessor(context, headers, key.As<Name>()) ||
+          !headers->Get(context, key).ToLocal(&value)) {
+        return;
+      }
+      if (source == kHeaderSourceOutHeaders) {
+        Local<Value> name;
+        if (!value->IsArray() ||
+            !value.As<Array>()->Get(context, 0).ToLocal(&name) ||
+            !value.As<Array>()->Get(context, 1).ToLocal(&value)) {
+          return;
+        }
+        key = name;
+      }
+      if (!serializer.Add(key, value))
+        return;
+    }
+  }
+
+  Local<v8::Uint32Array> flags = args[2].As<v8::Uint32Array>();
+  CHECK_GE(flags->Length(), 1);
+  static_cast<uint32_t*>(flags->Buffer()->GetBackingStore()->Data())[
+      flags->ByteOffset() / sizeof(uint32_t)] = serializer.flags();
+
+  const std::string& head = serializer.head();
+  Local<String> result;
+  if (String::NewFromOneByte(env->isolate(),
+                             reinterpret_cast<const uint8_t*>(head.data()),
+                             v8::NewStringType::kNormal,
+                             head.size()).ToLocal(&result)) {
+    args.GetReturnValue().Set(result);
+  }
+}
+
+
 void InitializeHttpParser(Local<Object> target,
                           Local<Value> unused,
                           Local<Context> context,
@@ -890,6 +1979,10 @@ void InitializeHttpParser(Local<Object> target,
          Integer::NewFromUnsigned(env->isolate(), kOnMessageComplete));
   t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnExecute"),
          Integer::NewFromUnsigned(env->isolate(), kOnExecute));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnRequest"),
+         Integer::NewFromUnsigned(env->isolate(), kOnRequest));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnWriteComplete"),
+         Integer::NewFromUnsigned(env->isolate(), kOnWriteComplete));
 
   Local<Array> methods = Array::New(env->isolate());
 #define V(num, name, string)                                                  \
@@ -901,6 +1994,31 @@ void InitializeHttpParser(Local<Object> target,
               FIXED_ONE_BYTE_STRING(env->isolate(), "methods"),
               methods).Check();
 
+  env->SetMethod(target, "serializeHeaders", SerializeHeaders);
+  NODE_DEFINE_CONSTANT(target, kHeaderSourceOutHeaders);
+  NODE_DEFINE_CONSTANT(target, kHeaderSourceEntries);
+  NODE_DEFINE_CONSTANT(target, kHeaderSourceObject);
+  NODE_DEFINE_CONSTANT(target, kHeaderConnection);
+  NODE_DEFINE_CONSTANT(target, kHeaderConnectionClose);
+  NODE_DEFINE_CONSTANT(target, kHeaderConnectionKeepAlive);
+  NODE_DEFINE_CONSTANT(target, kHeaderTransferEncoding);
+  NODE_DEFINE_CONSTANT(target, kHeaderChunked);
+  NODE_DEFINE_CONSTANT(target, kHeaderContentLength);
+  NODE_DEFINE_CONSTANT(target, kHeaderDate);
+  NODE_DEFINE_CONSTANT(target, kHeaderExpect);
+  NODE_DEFINE_CONSTANT(target, kHeaderTrailer);
+
+  Local<FunctionTemplate> list = FunctionTemplate::New(env->isolate());
+  list->SetClassName(FIXED_ONE_BYTE_STRING(env->isolate(), "HeaderList"));
+  list->InstanceTemplate()->SetInternalFieldCount(
+      HeaderList::kInternalFieldCount);
+  env->SetProtoMethodNoSideEffect(list, "count", HeaderList::Count);
+  env->SetProtoMethodNoSideEffect(list, "field", HeaderList::FieldAt);
+  env->SetProtoMethodNoSideEffect(list, "value", HeaderList::ValueAt);
+  env->SetProtoMethodNoSideEffect(list, "find", HeaderList::Find);
+  env->SetProtoMethodNoSideEffect(list, "toArray", HeaderList::ToArray);
+  env->set_http_header_list_constructor_template(list->InstanceTemplate());
+
   t->Inherit(AsyncWrap::GetConstructorTemplate(env));
   env->SetProtoMethod(t, "close", Parser::Close);
   env->SetProtoMethod(t, "free", Parser::Free);
@@ -912,6 +2030,8 @@ void InitializeHttpParser(Local<Object> target,
   env->SetProtoMethod(t, "consume", Parser::Consume);
   env->SetProtoMethod(t, "unconsume", Parser::Unconsume);
   env->SetProtoMethod(t, "getCurrentBuffer", Parser::GetCurrentBuffer);
+  env->SetProtoMethod(t, "enableFastMode", Parser::EnableFastMode);
+  env->SetProtoMethod(t, "respond", Parser::Respond);
 
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "HTTPParser"),
@@ -301,6 +301,219 @@ class ConverterObject : public BaseObject, Converter {
   bool bomSeen_ = false;     // True if the BOM has been seen
 };
 
+// Streaming converter between two arbitrary encodings. Input chunks are
+// converted directly into output chunks, so that large streams do not need
+// to be materialized as JS strings or held in memory as a whole.
+class TranscoderObject : public BaseObject {
+ public:
+  enum TranscoderFlags {
+    TRANSCODER_FLAGS_FLUSH = 0x1,
+    TRANSCODER_FLAGS_FATAL = 0x2
+  };
+
+  ~TranscoderObject() override {
+    ucnv_close(from_);
+    ucnv_close(to_);
+  }
+
+  // transcoder = getTranscoder(from, to, flags)
+  // Returns either the transcoder or an ICU error code.
+  static void Create(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    HandleScope scope(env->isolate());
+
+    Local<ObjectTemplate> t = ObjectTemplate::New(env->isolate());
+    t->SetInternalFieldCount(TranscoderObject::kInternalFieldCount);
+    Local<Object> obj;
+    if (!t->NewInstance(env->context()).ToLocal(&obj)) return;
+
+    CHECK_GE(args.Length(), 3);
+    Utf8Value from_label(env->isolate(), args[0]);
+    Utf8Value to_label(env->isolate(), args[1]);
+    int flags = args[2]->Uint32Value(env->context()).ToChecked();
+    bool fatal = (flags & TRANSCODER_FLAGS_FATAL) == TRANSCODER_FLAGS_FATAL;
+
+    UErrorCode status = U_ZERO_ERROR;
+    UConverter* from = ucnv_open(*from_label, &status);
+    if (U_FAILURE(status))
+      return args.GetReturnValue().Set(status);
+    UConverter* to = ucnv_open(*to_label, &status);
+    if (U_FAILURE(status)) {
+      ucnv_close(from);
+      return args.GetReturnValue().Set(status);
+    }
+
+    if (fatal) {
+      ucnv_setToUCallBack(from, UCNV_TO_U_CALLBACK_STOP,
+                          nullptr, nullptr, nullptr, &status);
+      ucnv_setFromUCallBack(to, UCNV_FROM_U_CALLBACK_STOP,
+                            nullptr, nullptr, nullptr, &status);
+    } else {
+      // Same substitution character as the one-shot transcode().
+      ucnv_setSubstChars(to, "?", 1, &status);
+    }
+    if (U_FAILURE(status)) {
+      ucnv_close(from);
+      ucnv_close(to);
+      return args.GetReturnValue().Set(status);
+    }
+
+    new TranscoderObject(env, obj, from, to);
+    args.GetReturnValue().Set(obj);
+  }
+
+  // result = transcodeChunk(transcoder, input, flags)
+  // Returns either a Buffer with the converted chunk or an ICU error code.
+  static void Transcode(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+
+    CHECK_GE(args.Length(), 3);  // Transcoder, Buffer, Flags
+
+    TranscoderObject* transcoder;
+    ASSIGN_OR_RETURN_UNWRAP(&transcoder, args[0].As<Object>());
+    ArrayBufferViewContents<char> input(args[1]);
+    int flags = args[2]->Uint32Value(env->context()).ToChecked();
+    bool flush = (flags & TRANSCODER_FLAGS_FLUSH) == TRANSCODER_FLAGS_FLUSH;
+
+    AllocatedBuffer result;
+    UErrorCode status = U_ZERO_ERROR;
+    switch (transcoder->fast_path_) {
+      case kLatin1ToUtf8:
+        result = Latin1ToUtf8(env, input.data(), input.length());
+        break;
+      case kLatin1ToUtf16le:
+        result = Latin1ToUtf16le(env, input.data(), input.length());
+        break;
+      case kNone:
+        result = transcoder->Convert(input.data(), input.length(), flush,
+                                     &status);
+        break;
+    }
+
+    if (U_FAILURE(status)) {
+      // Leave the converters in a usable state.
+      transcoder->reset_ = true;
+      return args.GetReturnValue().Set(status);
+    }
+
+    if (flush)
+      transcoder->reset_ = true;
+
+    Local<Object> buffer;
+    if (result.ToBuffer().ToLocal(&buffer))
+      args.GetReturnValue().Set(buffer);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(TranscoderObject)
+  SET_SELF_SIZE(TranscoderObject)
+
+ private:
+  // Conversions that are stateless and common enough to warrant skipping
+  // the round trip through UTF-16 that ICU performs.
+  enum FastPath {
+    kNone,
+    kLatin1ToUtf8,
+    kLatin1ToUtf16le
+  };
+
+  static constexpr size_t kPivotSize = 1024;
+
+  TranscoderObject(Environment* env,
+                   Local<Object> wrap,
+                   UConverter* from,
+                   UConverter* to)
+      : BaseObject(env, wrap), from_(from), to_(to) {
+    MakeWeak();
+
+    if (ucnv_getType(from) == UCNV_LATIN_1) {
+      switch (ucnv_getType(to)) {
+        case UCNV_UTF8:
+          fast_path_ = kLatin1ToUtf8;
+          break;
+        case UCNV_UTF16_LittleEndian:
+          fast_path_ = kLatin1ToUtf16le;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  AllocatedBuffer Convert(const char* source,
+                          size_t source_length,
+                          bool flush,
+                          UErrorCode* status) {
+    // Every input byte results in at most one UTF-16 code unit, plus whatever
+    // is still held in the pivot buffer from the previous chunk. The result is
+    // grown on demand in case the estimate turns out to be too small.
+    size_t capacity =
+        (source_length + (pivot_target_ - pivot_source_) + 1) *
+        ucnv_getMaxCharSize(to_);
+    AllocatedBuffer result = env()->AllocateManaged(capacity);
+    char* target = result.data();
+    const char* source_end = source + source_length;
+
+    for (;;) {
+      *status = U_ZERO_ERROR;
+      ucnv_convertEx(to_, from_,
+                     &target, result.data() + capacity,
+                     &source, source_end,
+                     pivot_, &pivot_source_, &pivot_target_,
+                     pivot_ + kPivotSize,
+                     reset_, flush, status);
+      reset_ = false;
+      if (*status != U_BUFFER_OVERFLOW_ERROR)
+        break;
+      const size_t written = target - result.data();
+      capacity *= 2;
+      result.Resize(capacity);
+      target = result.data() + written;
+    }
+
+    result.Resize(target - result.data());
+    return result;
+  }
+
+  static AllocatedBuffer Latin1ToUtf8(Environment* env,
+                                      const char* source,
+                                      size_t source_length) {
+    AllocatedBuffer result = env->AllocateManaged(source_length * 2);
+    uint8_t* target = reinterpret_cast<uint8_t*>(result.data());
+    for (size_t i = 0; i < source_length; i++) {
+      const uint8_t c = source[i];
+      if (c < 0x80) {
+        *target++ = c;
+      } else {
+        *target++ = 0xc0 | (c >> 6);
+        *target++ = 0x80 | (c & 0x3f);
+      }
+    }
+    result.Resize(target - reinterpret_cast<uint8_t*>(result.data()));
+    return result;
+  }
+
+  static AllocatedBuffer Latin1ToUtf16le(Environment* env,
+                                         const char* source,
+                                         size_t source_length) {
+    AllocatedBuffer result = env->AllocateManaged(source_length * 2);
+    uint8_t* target = reinterpret_cast<uint8_t*>(result.data());
+    for (size_t i = 0; i < source_length; i++) {
+      target[2 * i] = source[i];
+      target[2 * i + 1] = 0;
+    }
+    return result;
+  }
+
+  UConverter* from_;
+  UConverter* to_;
+  FastPath fast_path_ = kNone;
+  bool reset_ = true;  // True if the next conversion starts a new stream
+  UChar pivot_[kPivotSize];
+  UChar* pivot_source_ = pivot_;
+  UChar* pivot_target_ = pivot_;
+};
+
 // One-Shot Converters
 
 void CopySourceBuffer(MaybeStackBuffer<UChar>* dest,
@@ -824,6 +1037,10 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "getConverter", ConverterObject::Create);
   env->SetMethod(target, "decode", ConverterObject::Decode);
   env->SetMethod(target, "hasConverter", ConverterObject::Has);
+
+  // TranscoderObject
+  env->SetMethod(target, "getTranscoder", TranscoderObject::Create);
+  env->SetMethod(target, "transcodeChunk", TranscoderObject::Transcode);
 }
 
 }  // namespace i18n
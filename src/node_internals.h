@@ -25,6 +25,7 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "env.h"
+#include "memory_tracker.h"
 #include "node.h"
 #include "node_binding.h"
 #include "node_mutex.h"
@@ -69,6 +70,17 @@ v8::Local<v8::Object> AddressToJS(
     const sockaddr* addr,
     v8::Local<v8::Object> info = v8::Local<v8::Object>());
 
+// Bind flag understood by TCPWrap and UDPWrap in addition to libuv's own
+// flags. It is stripped before the flags are passed on to libuv.
+constexpr unsigned int kBindReusePort = 1 << 16;
+
+// Creates a socket with SO_REUSEPORT (or, where the platform has it, the load
+// balancing SO_REUSEPORT_LB) set, so that sockets in several processes or
+// threads can be bound to the same address and port and the kernel spreads
+// incoming connections or datagrams over them. The caller passes the socket
+// to uv_tcp_open() or uv_udp_open(). Returns 0 or a libuv error code.
+int NewReusePortSocket(int family, int type, uv_os_sock_t* sock);
+
 template <typename T, int (*F)(const typename T::HandleType*, sockaddr*, int*)>
 void GetSockOrPeerName(const v8::FunctionCallbackInfo<v8::Value>& args) {
   T* wrap;
@@ -105,6 +117,70 @@ namespace task_queue {
 void PromiseRejectCallback(v8::PromiseRejectMessage message);
 }  // namespace task_queue
 
+// A per-thread, size-classed cache of recently freed ArrayBuffer backing
+// stores. Small Buffers tend to be created and released at a high rate (one
+// or more per read, per request, per crypto operation), so instead of
+// returning them to malloc() right away we keep a bounded number of blocks
+// of each power-of-two size class around for reuse.
+//
+// Blocks in the cache are regular malloc() allocations whose capacity is the
+// rounded-up size of their class, so they remain compatible with free() and
+// realloc(). Since V8 may release backing stores on background threads,
+// every thread gets its own cache and no locking is required.
+class SmallBufferPool : public MemoryRetainer {
+ public:
+  static constexpr size_t kMinSizeLog2 = 6;   // 64 bytes
+  static constexpr size_t kMaxSizeLog2 = 16;  // 64 KiB
+  static constexpr size_t kSizeClassCount = kMaxSizeLog2 - kMinSizeLog2 + 1;
+  static constexpr size_t kMaxBlocksPerClass = 32;
+
+  SmallBufferPool() = default;
+  ~SmallBufferPool() override;
+  SmallBufferPool(const SmallBufferPool&) = delete;
+  SmallBufferPool& operator=(const SmallBufferPool&) = delete;
+
+  static inline bool IsPooledSize(size_t size) {
+    return size > 0 && size <= (size_t{1} << kMaxSizeLog2);
+  }
+
+  // Returns the capacity of the size class that |size| belongs to.
+  static inline size_t RoundUp(size_t size) {
+    size_t capacity = size_t{1} << kMinSizeLog2;
+    while (capacity < size) capacity <<= 1;
+    return capacity;
+  }
+
+  // Returns nullptr if the pool is not available on the current thread,
+  // e.g. because the thread is shutting down.
+  static SmallBufferPool* ForCurrentThread();
+
+  // Returns a block of at least |size| bytes, or nullptr if the size class
+  // for |size| is empty.
+  void* Get(size_t size);
+  // Takes ownership of |data| if there is space left in its size class.
+  // |data| needs to have been allocated with a capacity of RoundUp(size).
+  bool Put(void* data, size_t size);
+  // Releases all cached blocks back to the system.
+  void Clear();
+
+  inline size_t cached_bytes() const { return cached_bytes_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SmallBufferPool)
+  SET_SELF_SIZE(SmallBufferPool)
+
+ private:
+  static inline size_t SizeClass(size_t size) {
+    size_t index = 0;
+    while ((size_t{1} << (kMinSizeLog2 + index)) < size) index++;
+    return index;
+  }
+
+  void* blocks_[kSizeClassCount][kMaxBlocksPerClass];
+  size_t block_count_[kSizeClassCount] = {};
+  size_t cached_bytes_ = 0;
+};
+
 class NodeArrayBufferAllocator : public ArrayBufferAllocator {
  public:
   inline uint32_t* zero_fill_field() { return &zero_fill_field_; }
@@ -113,6 +189,8 @@ class NodeArrayBufferAllocator : public ArrayBufferAllocator {
   void* AllocateUninitialized(size_t size) override;
   void Free(void* data, size_t size) override;
   virtual void* Reallocate(void* data, size_t old_size, size_t size);
+  // Pointers in the SmallBufferPool size range need to have been allocated
+  // with a capacity of SmallBufferPool::RoundUp(size).
   virtual void RegisterPointer(void* data, size_t size) {
     total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
   }
@@ -126,6 +204,10 @@ class NodeArrayBufferAllocator : public ArrayBufferAllocator {
   }
 
  private:
+  // Serves allocations in the SmallBufferPool size range. The returned block
+  // always has the full capacity of the size class of |size|.
+  void* AllocatePooled(size_t size);
+
   uint32_t zero_fill_field_ = 1;  // Boolean but exposed as uint32 to JS land.
   std::atomic<size_t> total_mem_usage_ {0};
 };
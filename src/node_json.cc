@@ -0,0 +1,566 @@
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_binding.h"
+#include "node_errors.h"
+#include "util-inl.h"
+#include "v8.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A JSON parser that reads UTF-8 bytes straight out of an ArrayBufferView and
+// builds the resulting V8 values directly, so that callers holding a Buffer
+// do not have to decode the whole input into a JS string first just to hand
+// it to JSON.parse().
+
+namespace node {
+
+using v8::Array;
+using v8::Context;
+using v8::EscapableHandleScope;
+using v8::Exception;
+using v8::False;
+using v8::FunctionCallbackInfo;
+using v8::Global;
+using v8::Isolate;
+using v8::JSON;
+using v8::Local;
+using v8::MaybeLocal;
+using v8::NewStringType;
+using v8::Null;
+using v8::Number;
+using v8::Object;
+using v8::String;
+using v8::True;
+using v8::Value;
+
+namespace json {
+namespace {
+
+// Nesting deeper than this is rejected instead of risking a native stack
+// overflow.
+constexpr size_t kMaxDepth = 2048;
+
+// Object keys up to this length are interned once per parse and reused, which
+// pays off for the common "array of records" shape.
+constexpr size_t kMaxCachedKeyLength = 64;
+constexpr size_t kKeyCacheSize = 128;
+
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+constexpr uint64_t kQuotes = kOnes * '"';
+constexpr uint64_t kBackslashes = kOnes * '\\';
+
+// The following helpers classify eight input bytes at a time. Each returns
+// non-zero iff at least one byte of |w| matches.
+inline uint64_t HasZeroByte(uint64_t w) {
+  return (w - kOnes) & ~w & kHighBits;
+}
+
+inline uint64_t HasByteBelowSpace(uint64_t w) {
+  return (w - kOnes * 0x20) & ~w & kHighBits;
+}
+
+inline bool IsWhitespace(uint8_t c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool IsDigit(uint8_t c) {
+  return c >= '0' && c <= '9';
+}
+
+inline bool IsHexDigit(uint8_t c) {
+  return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// Backing storage for string values that are handed to V8 as external
+// strings instead of being copied one by one. The input is copied once, on
+// the first such string, so that later changes to the source Buffer cannot be
+// observed through the (immutable) strings.
+class ExternalSlice final : public String::ExternalOneByteStringResource {
+ public:
+  ExternalSlice(std::shared_ptr<char> storage, const char* data, size_t length)
+      : storage_(std::move(storage)), data_(data), length_(length) {}
+
+  const char* data() const override { return data_; }
+  size_t length() const override { return length_; }
+
+ private:
+  std::shared_ptr<char> storage_;
+  const char* data_;
+  size_t length_;
+};
+
+struct StringSpan {
+  size_t start;
+  size_t end;
+  bool ascii;
+  bool escaped;
+};
+
+class Parser {
+ public:
+  Parser(Environment* env,
+         const char* data,
+         size_t length,
+         size_t lazy_string_threshold)
+      : env_(env),
+        isolate_(env->isolate()),
+        context_(env->context()),
+        data_(reinterpret_cast<const uint8_t*>(data)),
+        length_(length),
+        lazy_string_threshold_(lazy_string_threshold) {}
+
+  MaybeLocal<Value> Parse();
+
+ private:
+  struct CachedKey {
+    size_t start = 0;
+    size_t length = 0;
+    Global<String> value;
+  };
+
+  bool ParseValue(Local<Value>* out);
+  bool ParseObject(Local<Value>* out);
+  bool ParseArray(Local<Value>* out);
+  bool ParseNumber(Local<Value>* out);
+  bool ParseLiteral(const char* literal, size_t length);
+  bool ScanString(StringSpan* span);
+  MaybeLocal<String> MakeString(const StringSpan& span);
+  MaybeLocal<String> MakeKey(const StringSpan& span);
+
+  inline void SkipWhitespace() {
+    while (pos_ < length_ && IsWhitespace(data_[pos_])) pos_++;
+  }
+
+  bool Unexpected(size_t pos);
+
+  Environment* env_;
+  Isolate* isolate_;
+  Local<Context> context_;
+  const uint8_t* data_;
+  size_t length_;
+  size_t pos_ = 0;
+  size_t depth_ = 0;
+  size_t lazy_string_threshold_;
+  std::shared_ptr<char> external_copy_;
+  CachedKey key_cache_[kKeyCacheSize];
+};
+
+bool Parser::Unexpected(size_t pos) {
+  std::string message;
+  if (pos >= length_) {
+    message = "Unexpected end of JSON input";
+  } else if (data_[pos] >= 0x20 && data_[pos] < 0x7f) {
+    message = SPrintF("Unexpected token %s in JSON at position %u",
+                      static_cast<char>(data_[pos]), pos);
+  } else {
+    char hex[3];
+    snprintf(hex, sizeof(hex), "%02x", data_[pos]);
+    message = SPrintF("Unexpected byte 0x%s in JSON at position %u",
+                      hex, pos);
+  }
+  isolate_->ThrowException(Exception::SyntaxError(
+      OneByteString(isolate_, message.c_str(), message.size())));
+  return false;
+}
+
+MaybeLocal<Value> Parser::Parse() {
+  EscapableHandleScope scope(isolate_);
+  Local<Value> result;
+  SkipWhitespace();
+  if (!ParseValue(&result))
+    return MaybeLocal<Value>();
+  SkipWhitespace();
+  if (pos_ != length_) {
+    Unexpected(pos_);
+    return MaybeLocal<Value>();
+  }
+  return scope.Escape(result);
+}
+
+bool Parser::ParseValue(Local<Value>* out) {
+  if (pos_ >= length_)
+    return Unexpected(pos_);
+
+  switch (data_[pos_]) {
+    case '{':
+      return ParseObject(out);
+    case '[':
+      return ParseArray(out);
+    case '"': {
+      StringSpan span;
+      Local<String> str;
+      if (!ScanString(&span) || !MakeString(span).ToLocal(&str))
+        return false;
+      *out = str;
+      return true;
+    }
+    case 't':
+      *out = True(isolate_);
+      return ParseLiteral("true", 4);
+    case 'f':
+      *out = False(isolate_);
+      return ParseLiteral("false", 5);
+    case 'n':
+      *out = Null(isolate_);
+      return ParseLiteral("null", 4);
+    default:
+      return ParseNumber(out);
+  }
+}
+
+bool Parser::ParseLiteral(const char* literal, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    if (pos_ + i >= length_ || data_[pos_ + i] != literal[i])
+      return Unexpected(pos_ + i);
+  }
+  pos_ += length;
+  return true;
+}
+
+bool Parser::ParseObject(Local<Value>* out) {
+  if (++depth_ > kMaxDepth) {
+    THROW_ERR_OUT_OF_RANGE(env_, "JSON input is nested too deeply");
+    return false;
+  }
+
+  EscapableHandleScope scope(isolate_);
+  Local<Object> object = Object::New(isolate_);
+  pos_++;  // '{'
+  SkipWhitespace();
+  if (pos_ < length_ && data_[pos_] == '}') {
+    pos_++;
+  } else {
+    for (;;) {
+      if (pos_ >= length_ || data_[pos_] != '"')
+        return Unexpected(pos_);
+      StringSpan span;
+      Local<String> key;
+      if (!ScanString(&span) || !MakeKey(span).ToLocal(&key))
+        return false;
+      SkipWhitespace();
+      if (pos_ >= length_ || data_[pos_] != ':')
+        return Unexpected(pos_);
+      pos_++;
+      SkipWhitespace();
+      Local<Value> value;
+      if (!ParseValue(&value) ||
+          object->CreateDataProperty(context_, key, value).IsNothing()) {
+        return false;
+      }
+      SkipWhitespace();
+      if (pos_ >= length_)
+        return Unexpected(pos_);
+      if (data_[pos_] == '}') {
+        pos_++;
+        break;
+      }
+      if (data_[pos_] != ',')
+        return Unexpected(pos_);
+      pos_++;
+      SkipWhitespace();
+    }
+  }
+
+  depth_--;
+  *out = scope.Escape(object);
+  return true;
+}
+
+bool Parser::ParseArray(Local<Value>* out) {
+  if (++depth_ > kMaxDepth) {
+    THROW_ERR_OUT_OF_RANGE(env_, "JSON input is nested too deeply");
+    return false;
+  }
+
+  EscapableHandleScope scope(isolate_);
+  std::vector<Local<Value>> elements;
+  pos_++;  // '['
+  SkipWhitespace();
+  if (pos_ < length_ && data_[pos_] == ']') {
+    pos_++;
+  } else {
+    for (;;) {
+      Local<Value> value;
+      if (!ParseValue(&value))
+        return false;
+      elements.push_back(value);
+      SkipWhitespace();
+      if (pos_ >= length_)
+        return Unexpected(pos_);
+      if (data_[pos_] == ']') {
+        pos_++;
+        break;
+      }
+      if (data_[pos_] != ',')
+        return Unexpected(pos_);
+      pos_++;
+      SkipWhitespace();
+    }
+  }
+
+  depth_--;
+  *out = scope.Escape(Array::New(isolate_, elements.data(), elements.size()));
+  return true;
+}
+
+bool Parser::ParseNumber(Local<Value>* out) {
+  // Exact powers of ten; a decimal with at most 15 significant digits and an
+  // exponent in this range is correctly rounded by a single multiplication or
+  // division (Clinger's fast path). Anything else is handed to V8.
+  static constexpr double kPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  constexpr int kMaxFastDigits = 15;
+  constexpr int kMaxFastExponent = 22;
+
+  const size_t start = pos_;
+  bool negative = false;
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+
+  if (data_[pos_] == '-') {
+    negative = true;
+    pos_++;
+  }
+  if (pos_ >= length_ || !IsDigit(data_[pos_]))
+    return Unexpected(pos_);
+
+  if (data_[pos_] == '0') {
+    pos_++;
+  } else {
+    while (pos_ < length_ && IsDigit(data_[pos_])) {
+      if (digits < kMaxFastDigits)
+        mantissa = mantissa * 10 + (data_[pos_] - '0');
+      digits++;
+      pos_++;
+    }
+  }
+
+  if (pos_ < length_ && data_[pos_] == '.') {
+    pos_++;
+    if (pos_ >= length_ || !IsDigit(data_[pos_]))
+      return Unexpected(pos_);
+    while (pos_ < length_ && IsDigit(data_[pos_])) {
+      if (digits < kMaxFastDigits) {
+        mantissa = mantissa * 10 + (data_[pos_] - '0');
+        exponent--;
+      }
+      // Leading zeroes of the fraction are not significant.
+      if (mantissa != 0) digits++;
+      pos_++;
+    }
+  }
+
+  bool has_exponent = false;
+  if (pos_ < length_ && (data_[pos_] == 'e' || data_[pos_] == 'E')) {
+    has_exponent = true;
+    pos_++;
+    if (pos_ < length_ && (data_[pos_] == '+' || data_[pos_] == '-'))
+      pos_++;
+    if (pos_ >= length_ || !IsDigit(data_[pos_]))
+      return Unexpected(pos_);
+    while (pos_ < length_ && IsDigit(data_[pos_])) pos_++;
+  }
+
+  if (!has_exponent && digits <= kMaxFastDigits &&
+      exponent >= -kMaxFastExponent) {
+    double value = static_cast<double>(mantissa);
+    if (exponent < 0) value /= kPowersOfTen[-exponent];
+    *out = Number::New(isolate_, negative ? -value : value);
+    return true;
+  }
+
+  Local<String> literal;
+  double value;
+  if (!String::NewFromOneByte(isolate_,
+                              data_ + start,
+                              NewStringType::kNormal,
+                              static_cast<int>(pos_ - start))
+           .ToLocal(&literal) ||
+      !literal->NumberValue(context_).To(&value)) {
+    return false;
+  }
+  *out = Number::New(isolate_, value);
+  return true;
+}
+
+bool Parser::ScanString(StringSpan* span) {
+  pos_++;  // '"'
+  span->start = pos_;
+  span->ascii = true;
+  span->escaped = false;
+
+  uint64_t high_bits = kHighBits;
+  for (;;) {
+    // Skip over runs of plain characters a word at a time; only a quote, a
+    // backslash, a control character or (until one has been seen) a
+    // non-ASCII byte needs to be looked at individually.
+    while (pos_ + sizeof(uint64_t) <= length_) {
+      uint64_t word;
+      memcpy(&word, data_ + pos_, sizeof(word));
+      if ((HasZeroByte(word ^ kQuotes) |
+           HasZeroByte(word ^ kBackslashes) |
+           HasByteBelowSpace(word) |
+           (word & high_bits)) != 0) {
+        break;
+      }
+      pos_ += sizeof(word);
+    }
+
+    if (pos_ >= length_)
+      return Unexpected(pos_);
+
+    const uint8_t c = data_[pos_];
+    if (c == '"') {
+      span->end = pos_++;
+      return true;
+    }
+    if (c == '\\') {
+      span->escaped = true;
+      if (++pos_ >= length_)
+        return Unexpected(pos_);
+      switch (data_[pos_]) {
+        case '"': case '\\': case '/': case 'b':
+        case 'f': case 'n': case 'r': case 't':
+          pos_++;
+          break;
+        case 'u':
+          for (int i = 1; i <= 4; i++) {
+            if (pos_ + i >= length_ || !IsHexDigit(data_[pos_ + i]))
+              return Unexpected(pos_ + i);
+          }
+          pos_ += 5;
+          break;
+        default:
+          return Unexpected(pos_);
+      }
+      continue;
+    }
+    if (c < 0x20)
+      return Unexpected(pos_);
+    if (c >= 0x80) {
+      span->ascii = false;
+      high_bits = 0;
+    }
+    pos_++;
+  }
+}
+
+MaybeLocal<String> Parser::MakeString(const StringSpan& span) {
+  const size_t length = span.end - span.start;
+  if (length > static_cast<size_t>(String::kMaxLength)) {
+    isolate_->ThrowException(ERR_STRING_TOO_LONG(isolate_));
+    return MaybeLocal<String>();
+  }
+
+  if (span.escaped) {
+    // Escapes are rare enough that decoding them (including lone surrogates)
+    // is left to V8: re-parse just this literal, quotes included.
+    Local<String> literal;
+    Local<Value> value;
+    if (!String::NewFromUtf8(isolate_,
+                             reinterpret_cast<const char*>(data_) +
+                                 span.start - 1,
+                             NewStringType::kNormal,
+                             static_cast<int>(length + 2))
+             .ToLocal(&literal) ||
+        !JSON::Parse(context_, literal).ToLocal(&value)) {
+      return MaybeLocal<String>();
+    }
+    return value.As<String>();
+  }
+
+  if (!span.ascii) {
+    return String::NewFromUtf8(isolate_,
+                               reinterpret_cast<const char*>(data_) +
+                                   span.start,
+                               NewStringType::kNormal,
+                               static_cast<int>(length));
+  }
+
+  if (length >= lazy_string_threshold_) {
+    if (!external_copy_) {
+      char* copy = new char[length_];
+      memcpy(copy, data_, length_);
+      external_copy_.reset(copy, std::default_delete<char[]>());
+    }
+    ExternalSlice* resource = new ExternalSlice(
+        external_copy_, external_copy_.get() + span.start, length);
+    return String::NewExternalOneByte(isolate_, resource);
+  }
+
+  return String::NewFromOneByte(isolate_,
+                                data_ + span.start,
+                                NewStringType::kNormal,
+                                static_cast<int>(length));
+}
+
+MaybeLocal<String> Parser::MakeKey(const StringSpan& span) {
+  const size_t length = span.end - span.start;
+  if (span.escaped || !span.ascii || length > kMaxCachedKeyLength)
+    return MakeString(span);
+
+  uint32_t hash = static_cast<uint32_t>(length);
+  for (size_t i = span.start; i < span.end; i++)
+    hash = hash * 31 + data_[i];
+  CachedKey* entry = &key_cache_[hash % kKeyCacheSize];
+
+  if (!entry->value.IsEmpty() && entry->length == length &&
+      memcmp(data_ + entry->start, data_ + span.start, length) == 0) {
+    return entry->value.Get(isolate_);
+  }
+
+  Local<String> key;
+  if (!String::NewFromOneByte(isolate_,
+                              data_ + span.start,
+                              NewStringType::kInternalized,
+                              static_cast<int>(length))
+           .ToLocal(&key)) {
+    return MaybeLocal<String>();
+  }
+  entry->start = span.start;
+  entry->length = length;
+  entry->value.Reset(isolate_, key);
+  return key;
+}
+
+// parse(view[, lazyStringThreshold])
+void Parse(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsArrayBufferView());
+
+  size_t lazy_string_threshold = static_cast<size_t>(-1);
+  if (args[1]->IsNumber()) {
+    const double threshold = args[1].As<Number>()->Value();
+    CHECK_GE(threshold, 0);
+    if (threshold < static_cast<double>(lazy_string_threshold))
+      lazy_string_threshold = static_cast<size_t>(threshold);
+  }
+
+  ArrayBufferViewContents<char> input(args[0]);
+  Parser parser(env, input.data(), input.length(), lazy_string_threshold);
+  Local<Value> result;
+  if (parser.Parse().ToLocal(&result))
+    args.GetReturnValue().Set(result);
+}
+
+void Initialize(Local<Object> target,
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+  env->SetMethodNoSideEffect(target, "parse", Parse);
+}
+
+}  // anonymous namespace
+}  // namespace json
+}  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(json, node::json::Initialize)
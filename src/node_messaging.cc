@@ -7,8 +7,16 @@
 #include "node_buffer.h"
 #include "node_errors.h"
 #include "node_process.h"
+#include "pipe_wrap.h"
+#include "stream_wrap.h"
+#include "tcp_wrap.h"
 #include "util-inl.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 using node::contextify::ContextifyContext;
 using v8::Array;
 using v8::ArrayBuffer;
@@ -28,6 +36,7 @@ using v8::Local;
 using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Nothing;
+using v8::Null;
 using v8::Object;
 using v8::SharedArrayBuffer;
 using v8::String;
@@ -49,6 +58,13 @@ bool Message::IsCloseMessage() const {
 
 namespace {
 
+// Host objects are written as their type followed by their index in the
+// message's list of objects of that type.
+enum HostObjectType : uint32_t {
+  kMessagePortObject,
+  kNetHandleObject
+};
+
 // This is used to tell V8 how to read transferred host objects, like other
 // `MessagePort`s and `SharedArrayBuffer`s, and make new JS objects out of them.
 class DeserializerDelegate : public ValueDeserializer::Delegate {
@@ -57,19 +73,25 @@ class DeserializerDelegate : public ValueDeserializer::Delegate {
       Message* m,
       Environment* env,
       const std::vector<MessagePort*>& message_ports,
+      const std::vector<Local<Object>>& handles,
       const std::vector<Local<SharedArrayBuffer>>& shared_array_buffers,
       const std::vector<CompiledWasmModule>& wasm_modules)
       : message_ports_(message_ports),
+        handles_(handles),
         shared_array_buffers_(shared_array_buffers),
         wasm_modules_(wasm_modules) {}
 
   MaybeLocal<Object> ReadHostObject(Isolate* isolate) override {
-    // Currently, only MessagePort hosts objects are supported, so identifying
-    // by the index in the message's MessagePort array is sufficient.
+    uint32_t type;
     uint32_t id;
-    if (!deserializer->ReadUint32(&id))
+    if (!deserializer->ReadUint32(&type) || !deserializer->ReadUint32(&id))
       return MaybeLocal<Object>();
-    CHECK_LE(id, message_ports_.size());
+    if (type == kNetHandleObject) {
+      CHECK_LT(id, handles_.size());
+      return handles_[id];
+    }
+    CHECK_EQ(type, kMessagePortObject);
+    CHECK_LT(id, message_ports_.size());
     return message_ports_[id]->object(isolate);
   }
 
@@ -90,6 +112,7 @@ class DeserializerDelegate : public ValueDeserializer::Delegate {
 
  private:
   const std::vector<MessagePort*>& message_ports_;
+  const std::vector<Local<Object>>& handles_;
   const std::vector<Local<SharedArrayBuffer>>& shared_array_buffers_;
   const std::vector<CompiledWasmModule>& wasm_modules_;
 };
@@ -97,7 +120,8 @@ class DeserializerDelegate : public ValueDeserializer::Delegate {
 }  // anonymous namespace
 
 MaybeLocal<Value> Message::Deserialize(Environment* env,
-                                       Local<Context> context) {
+                                       Local<Context> context,
+                                       AsyncWrap* parent) {
   CHECK(!IsCloseMessage());
 
   EscapableHandleScope handle_scope(env->isolate());
@@ -120,6 +144,21 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
   }
   message_ports_.clear();
 
+  // Open new TCP and pipe handles for all transferred sockets.
+  std::vector<Local<Object>> handles(handles_.size());
+  for (uint32_t i = 0; i < handles_.size(); ++i) {
+    if (!handles_[i]->Open(env, parent).ToLocal(&handles[i])) {
+      for (Local<Object> handle : handles) {
+        if (!handle.IsEmpty())
+          LibuvStreamWrap::From(env, handle)->Close();
+      }
+      for (MessagePort* port : ports)
+        port->Close();
+      return MaybeLocal<Value>();
+    }
+  }
+  handles_.clear();
+
   std::vector<Local<SharedArrayBuffer>> shared_array_buffers;
   // Attach all transferred SharedArrayBuffers to their new Isolate.
   for (uint32_t i = 0; i < shared_array_buffers_.size(); ++i) {
@@ -131,7 +170,7 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
   shared_array_buffers_.clear();
 
   DeserializerDelegate delegate(
-      this, env, ports, shared_array_buffers, wasm_modules_);
+      this, env, ports, handles, shared_array_buffers, wasm_modules_);
   ValueDeserializer deserializer(
       env->isolate(),
       reinterpret_cast<const uint8_t*>(main_message_buf_.data),
@@ -167,6 +206,160 @@ uint32_t Message::AddWASMModule(CompiledWasmModule&& mod) {
   return wasm_modules_.size() - 1;
 }
 
+uint32_t Message::AddHandle(std::unique_ptr<TransferredHandle>&& handle) {
+  handles_.emplace_back(std::move(handle));
+  return handles_.size() - 1;
+}
+
+TransferredHandle::TransferredHandle(Type type,
+                                     int fd,
+                                     std::string&& pipe_name)
+    : type_(type), fd_(fd), pipe_name_(std::move(pipe_name)) {}
+
+TransferredHandle::~TransferredHandle() {
+#ifndef _WIN32
+  if (fd_ != -1)
+    close(fd_);
+#endif
+}
+
+int TransferredHandle::Duplicate(LibuvStreamWrap* wrap,
+                                 std::unique_ptr<TransferredHandle>* out) {
+#ifdef _WIN32
+  // Sockets would have to be duplicated into the same process with
+  // WSADuplicateSocket(), which libuv handles cannot adopt.
+  return UV_ENOTSUP;
+#else
+  Type type;
+  switch (wrap->provider_type()) {
+    case AsyncWrap::PROVIDER_TCPWRAP:
+      type = kTCPSocket;
+      break;
+    case AsyncWrap::PROVIDER_TCPSERVERWRAP:
+      type = kTCPServer;
+      break;
+    case AsyncWrap::PROVIDER_PIPEWRAP:
+      type = kPipeSocket;
+      break;
+    case AsyncWrap::PROVIDER_PIPESERVERWRAP:
+      type = kPipeServer;
+      break;
+    default:
+      return UV_EINVAL;
+  }
+  if (wrap->is_named_pipe_ipc())
+    return UV_EINVAL;
+
+  // Requests that are in flight would be cancelled when the original handle
+  // is closed, so refuse to transfer rather than lose data.
+  uv_stream_t* stream = wrap->stream();
+  if (stream->write_queue_size != 0 ||
+      stream->connect_req != nullptr ||
+      stream->shutdown_req != nullptr) {
+    return UV_EBUSY;
+  }
+
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(stream), &fd);
+  if (err != 0)
+    return err;
+  int dup_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (dup_fd == -1)
+    return uv_translate_sys_error(errno);
+
+  std::string pipe_name;
+  if (type == kPipeServer) {
+    const char* name = reinterpret_cast<uv_pipe_t*>(stream)->pipe_fname;
+    if (name != nullptr)
+      pipe_name = name;
+  }
+
+  out->reset(new TransferredHandle(type, dup_fd, std::move(pipe_name)));
+  return 0;
+#endif
+}
+
+void TransferredHandle::Detach(LibuvStreamWrap* wrap) {
+  Environment* env = wrap->env();
+#ifndef _WIN32
+  if (wrap->provider_type() == AsyncWrap::PROVIDER_PIPESERVERWRAP) {
+    // The path now belongs to the receiving handle, so closing this one must
+    // not unlink it. libuv allocated it with the default malloc().
+    uv_pipe_t* pipe = reinterpret_cast<uv_pipe_t*>(wrap->stream());
+    free(const_cast<char*>(pipe->pipe_fname));
+    pipe->pipe_fname = nullptr;
+  }
+#endif
+  Local<Value> ontransfer;
+  if (!wrap->object()->Get(env->context(), env->ontransfer_string())
+          .ToLocal(&ontransfer)) {
+    ontransfer = Local<Value>();
+  }
+  wrap->Close(ontransfer);
+}
+
+MaybeLocal<Object> TransferredHandle::Open(Environment* env,
+                                           AsyncWrap* parent) {
+  Isolate* isolate = env->isolate();
+  const bool is_tcp = type_ == kTCPSocket || type_ == kTCPServer;
+
+  // Handles can only be created once their binding has been loaded, which
+  // the receiving thread may not have done yet.
+  Local<FunctionTemplate> tmpl = is_tcp ? env->tcp_constructor_template()
+                                        : env->pipe_constructor_template();
+  if (tmpl.IsEmpty()) {
+    Local<Value> name = is_tcp ? FIXED_ONE_BYTE_STRING(isolate, "tcp_wrap")
+                               : FIXED_ONE_BYTE_STRING(isolate, "pipe_wrap");
+    if (env->internal_binding_loader()
+            ->Call(env->context(), Null(isolate), 1, &name).IsEmpty()) {
+      return MaybeLocal<Object>();
+    }
+  }
+
+  MaybeLocal<Object> maybe_object;
+  switch (type_) {
+    case kTCPSocket:
+      maybe_object = TCPWrap::Instantiate(env, parent, TCPWrap::SOCKET);
+      break;
+    case kTCPServer:
+      maybe_object = TCPWrap::Instantiate(env, parent, TCPWrap::SERVER);
+      break;
+    case kPipeSocket:
+      maybe_object = PipeWrap::Instantiate(env, parent, PipeWrap::SOCKET);
+      break;
+    case kPipeServer:
+      maybe_object = PipeWrap::Instantiate(env, parent, PipeWrap::SERVER);
+      break;
+  }
+  Local<Object> object;
+  if (!maybe_object.ToLocal(&object))
+    return MaybeLocal<Object>();
+
+  LibuvStreamWrap* wrap = LibuvStreamWrap::From(env, object);
+  int err;
+  if (is_tcp) {
+    err = uv_tcp_open(reinterpret_cast<uv_tcp_t*>(wrap->stream()), fd_);
+  } else {
+    err = uv_pipe_open(reinterpret_cast<uv_pipe_t*>(wrap->stream()), fd_);
+  }
+  if (err != 0) {
+    wrap->Close();
+    isolate->ThrowException(
+        UVException(isolate, err, is_tcp ? "uv_tcp_open" : "uv_pipe_open"));
+    return MaybeLocal<Object>();
+  }
+  fd_ = -1;
+
+#ifndef _WIN32
+  if (!pipe_name_.empty()) {
+    reinterpret_cast<uv_pipe_t*>(wrap->stream())->pipe_fname =
+        strdup(pipe_name_.c_str());
+  }
+#endif
+
+  return object;
+}
+
 namespace {
 
 MaybeLocal<Function> GetEmitMessageFunction(Local<Context> context) {
@@ -198,6 +391,13 @@ MaybeLocal<Function> GetDOMException(Local<Context> context) {
   return domexception_ctor;
 }
 
+bool IsNetHandle(Environment* env, Local<Value> value) {
+  Local<FunctionTemplate> tcp = env->tcp_constructor_template();
+  Local<FunctionTemplate> pipe = env->pipe_constructor_template();
+  return (!tcp.IsEmpty() && tcp->HasInstance(value)) ||
+         (!pipe.IsEmpty() && pipe->HasInstance(value));
+}
+
 void ThrowDataCloneException(Local<Context> context, Local<String> message) {
   Isolate* isolate = context->GetIsolate();
   Local<Value> argv[] = {message,
@@ -228,6 +428,9 @@ class SerializerDelegate : public ValueSerializer::Delegate {
     if (env_->message_port_constructor_template()->HasInstance(object)) {
       return WriteMessagePort(Unwrap<MessagePort>(object));
     }
+    if (IsNetHandle(env_, object)) {
+      return WriteHandle(Unwrap<LibuvStreamWrap>(object));
+    }
 
     ThrowDataCloneError(env_->clone_unsupported_type_str());
     return Nothing<bool>();
@@ -262,6 +465,9 @@ class SerializerDelegate : public ValueSerializer::Delegate {
       port->Close();
       msg_->AddMessagePort(port->Detach());
     }
+    // The sockets have already been duplicated into the message.
+    for (LibuvStreamWrap* handle : handles_)
+      TransferredHandle::Detach(handle);
   }
 
   ValueSerializer* serializer = nullptr;
@@ -270,6 +476,7 @@ class SerializerDelegate : public ValueSerializer::Delegate {
   Maybe<bool> WriteMessagePort(MessagePort* port) {
     for (uint32_t i = 0; i < ports_.size(); i++) {
       if (ports_[i] == port) {
+        serializer->WriteUint32(kMessagePortObject);
         serializer->WriteUint32(i);
         return Just(true);
       }
@@ -279,11 +486,26 @@ class SerializerDelegate : public ValueSerializer::Delegate {
     return Nothing<bool>();
   }
 
+  Maybe<bool> WriteHandle(LibuvStreamWrap* handle) {
+    for (uint32_t i = 0; i < handles_.size(); i++) {
+      if (handles_[i] == handle) {
+        serializer->WriteUint32(kNetHandleObject);
+        serializer->WriteUint32(i);
+        return Just(true);
+      }
+    }
+
+    ThrowDataCloneError(FIXED_ONE_BYTE_STRING(
+        env_->isolate(), "Network handle must be listed in the transfer list"));
+    return Nothing<bool>();
+  }
+
   Environment* env_;
   Local<Context> context_;
   Message* msg_;
   std::vector<Global<SharedArrayBuffer>> seen_shared_array_buffers_;
   std::vector<MessagePort*> ports_;
+  std::vector<LibuvStreamWrap*> handles_;
 
   friend class worker::Message;
 };
@@ -375,6 +597,41 @@ Maybe<bool> Message::Serialize(Environment* env,
       }
       delegate.ports_.push_back(port);
       continue;
+    } else if (IsNetHandle(env, entry)) {
+      LibuvStreamWrap* handle = Unwrap<LibuvStreamWrap>(entry.As<Object>());
+      if (handle == nullptr || !handle->IsAlive() || handle->IsClosing()) {
+        ThrowDataCloneException(
+            context,
+            FIXED_ONE_BYTE_STRING(
+                env->isolate(),
+                "Network handle in transfer list is already closed"));
+        return Nothing<bool>();
+      }
+      if (std::find(delegate.handles_.begin(), delegate.handles_.end(),
+                    handle) != delegate.handles_.end()) {
+        ThrowDataCloneException(
+            context,
+            FIXED_ONE_BYTE_STRING(
+                env->isolate(),
+                "Transfer list contains duplicate network handle"));
+        return Nothing<bool>();
+      }
+      // The socket is duplicated right away so that failures can still be
+      // reported while the original handle is intact. If serialization fails
+      // later on, the duplicate is closed along with this message.
+      std::unique_ptr<TransferredHandle> transferred;
+      int err = TransferredHandle::Duplicate(handle, &transferred);
+      if (err != 0) {
+        std::string message =
+            SPrintF("Cannot transfer network handle: %s", uv_strerror(err));
+        ThrowDataCloneException(
+            context,
+            OneByteString(env->isolate(), message.c_str(), message.size()));
+        return Nothing<bool>();
+      }
+      AddHandle(std::move(transferred));
+      delegate.handles_.push_back(handle);
+      continue;
     }
 
     THROW_ERR_INVALID_TRANSFER_OBJECT(env);
@@ -408,6 +665,7 @@ void Message::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("array_buffers_", array_buffers_);
   tracker->TrackField("shared_array_buffers", shared_array_buffers_);
   tracker->TrackField("message_ports", message_ports_);
+  tracker->TrackField("handles", handles_);
 }
 
 MessagePortData::MessagePortData(MessagePort* owner) : owner_(owner) { }
@@ -604,7 +862,7 @@ MaybeLocal<Value> MessagePort::ReceiveMessage(Local<Context> context,
 
   if (!env()->can_call_into_js()) return MaybeLocal<Value>();
 
-  return received.Deserialize(env(), context);
+  return received.Deserialize(env(), context, this);
 }
 
 void MessagePort::OnMessage() {
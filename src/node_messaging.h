@@ -6,12 +6,17 @@
 #include "env.h"
 #include "node_mutex.h"
 #include <list>
+#include <string>
 
 namespace node {
+
+class LibuvStreamWrap;
+
 namespace worker {
 
 class MessagePortData;
 class MessagePort;
+class TransferredHandle;
 
 typedef MaybeStackBuffer<v8::Local<v8::Value>, 8> TransferList;
 
@@ -34,8 +39,11 @@ class Message : public MemoryRetainer {
 
   // Deserialize the contained JS value. May only be called once, and only
   // after Serialize() has been called (e.g. by another thread).
+  // `parent` is used as the trigger for the async resources of any network
+  // handles that are created for transferred sockets.
   v8::MaybeLocal<v8::Value> Deserialize(Environment* env,
-                                        v8::Local<v8::Context> context);
+                                        v8::Local<v8::Context> context,
+                                        AsyncWrap* parent);
 
   // Serialize a JS value, and optionally transfer objects, into this message.
   // The Message object retains ownership of all transferred objects until
@@ -58,6 +66,9 @@ class Message : public MemoryRetainer {
   // Internal method of Message that is called when a new WebAssembly.Module
   // object is encountered in the incoming value's structure.
   uint32_t AddWASMModule(v8::CompiledWasmModule&& mod);
+  // Internal method of Message that is called when a TCP or pipe handle is
+  // found in the transfer list. Returns the ID of the handle in this message.
+  uint32_t AddHandle(std::unique_ptr<TransferredHandle>&& handle);
 
   // The MessagePorts that will be transferred, as recorded by Serialize().
   // Used for warning user about posting the target MessagePort to itself,
@@ -77,10 +88,53 @@ class Message : public MemoryRetainer {
   std::vector<std::shared_ptr<v8::BackingStore>> shared_array_buffers_;
   std::vector<std::unique_ptr<MessagePortData>> message_ports_;
   std::vector<v8::CompiledWasmModule> wasm_modules_;
+  std::vector<std::unique_ptr<TransferredHandle>> handles_;
 
   friend class MessagePort;
 };
 
+// The socket of a TCPWrap or PipeWrap that is being moved to another event
+// loop. The file descriptor is owned by this object until the receiving side
+// opens a new handle for it, and is closed if the message is never received.
+class TransferredHandle : public MemoryRetainer {
+ public:
+  enum Type : uint8_t { kTCPSocket, kTCPServer, kPipeSocket, kPipeServer };
+
+  ~TransferredHandle() override;
+
+  TransferredHandle(TransferredHandle&& other) = delete;
+  TransferredHandle& operator=(TransferredHandle&& other) = delete;
+  TransferredHandle(const TransferredHandle& other) = delete;
+  TransferredHandle& operator=(const TransferredHandle& other) = delete;
+
+  // Duplicates the socket underlying `wrap`, which is left untouched.
+  // Returns a libuv error code if the handle cannot be transferred.
+  static int Duplicate(LibuvStreamWrap* wrap,
+                       std::unique_ptr<TransferredHandle>* out);
+
+  // Closes `wrap` once its socket has been duplicated and the message it is
+  // part of has been serialized. The JS `ontransfer` callback of the handle,
+  // if any, is called once the handle is closed.
+  static void Detach(LibuvStreamWrap* wrap);
+
+  // Creates a new TCP or Pipe handle object for the socket on the event loop
+  // of `env`.
+  v8::MaybeLocal<v8::Object> Open(Environment* env, AsyncWrap* parent);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(TransferredHandle)
+  SET_SELF_SIZE(TransferredHandle)
+
+ private:
+  TransferredHandle(Type type, int fd, std::string&& pipe_name);
+
+  Type type_;
+  int fd_;
+  // The path of a transferred pipe server, so that the receiving handle
+  // unlinks it on close just like the original handle would have.
+  std::string pipe_name_;
+};
+
 // This contains all data for a `MessagePort` instance that is not tied to
 // a specific Environment/Isolate/event loop, for easier transfer between those.
 class MessagePortData : public MemoryRetainer {
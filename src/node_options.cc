@@ -314,6 +314,10 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "experimental await keyword support in REPL",
             &EnvironmentOptions::experimental_repl_await,
             kAllowedInEnvironment);
+  AddOption("--experimental-timer-wheel",
+            "use a native timer wheel for the idle timeouts of sockets",
+            &EnvironmentOptions::experimental_timer_wheel,
+            kAllowedInEnvironment);
   AddOption("--experimental-vm-modules",
             "experimental ES Module support in vm module",
             &EnvironmentOptions::experimental_vm_modules,
@@ -112,6 +112,7 @@ class EnvironmentOptions : public Options {
   std::string experimental_policy_integrity;
   bool has_policy_integrity_string;
   bool experimental_repl_await = false;
+  bool experimental_timer_wheel = false;
   bool experimental_vm_modules = false;
   bool expose_internals = false;
   bool frozen_intrinsics = false;
@@ -477,6 +477,27 @@ static void ELDHistogramNew(const FunctionCallbackInfo<Value>& args) {
   CHECK_GT(resolution, 0);
   new ELDHistogram(env, args.This(), resolution);
 }
+
+// Creates a histogram that is recorded into from JS, e.g. for the connection
+// metrics of http.PoolAgent.
+static void CreateHistogram(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsNumber());
+  CHECK(args[1]->IsNumber());
+  int64_t lowest = args[0]->IntegerValue(env->context()).FromJust();
+  int64_t highest = args[1]->IntegerValue(env->context()).FromJust();
+  CHECK_GE(lowest, 1);
+  CHECK_GE(highest, 2 * lowest);
+
+  HistogramBase::Initialize(env);
+  Local<Object> obj;
+  if (!env->histogram_instance_template()
+          ->NewInstance(env->context()).ToLocal(&obj)) {
+    return;
+  }
+  new HistogramBase(env, obj, lowest, highest);
+  args.GetReturnValue().Set(obj);
+}
 }  // namespace
 
 ELDHistogram::ELDHistogram(
@@ -584,6 +605,7 @@ void Initialize(Local<Object> target,
                  "removeGarbageCollectionTracking",
                  RemoveGarbageCollectionTracking);
   env->SetMethod(target, "notify", Notify);
+  env->SetMethod(target, "createHistogram", CreateHistogram);
 
   Local<Object> constants = Object::New(isolate);
 
@@ -80,6 +80,8 @@ void PipeWrap::Initialize(Local<Object> target,
 
   env->SetProtoMethod(t, "bind", Bind);
   env->SetProtoMethod(t, "listen", Listen);
+  env->SetProtoMethod(t, "setAcceptBatching", SetAcceptBatching);
+  env->SetProtoMethod(t, "enableAcceptMetrics", EnableAcceptMetrics);
   env->SetProtoMethod(t, "connect", Connect);
   env->SetProtoMethod(t, "open", Open);
 
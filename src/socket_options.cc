@@ -0,0 +1,190 @@
+#include "socket_options.h"
+#include "util-inl.h"
+
+#ifndef _WIN32
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <cerrno>
+#endif
+
+// Older C library headers may lack the definitions of options that the
+// running kernel supports.
+#ifdef __linux__
+#ifndef TCP_USER_TIMEOUT
+#define TCP_USER_TIMEOUT 18
+#endif
+#ifndef TCP_NOTSENT_LOWAT
+#define TCP_NOTSENT_LOWAT 25
+#endif
+#ifndef TCP_FASTOPEN_CONNECT
+#define TCP_FASTOPEN_CONNECT 30
+#endif
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL 46
+#endif
+#endif  // __linux__
+
+namespace node {
+namespace socket_options {
+
+using v8::Context;
+using v8::Integer;
+using v8::Local;
+using v8::Object;
+
+namespace {
+
+#ifndef _WIN32
+// Looks up the level and name of `option` for setsockopt() and
+// getsockopt(). Returns false if the platform does not support it.
+bool Lookup(Option option, int* level, int* name) {
+  switch (option) {
+#ifdef TCP_NOTSENT_LOWAT
+    case kOptionTCP_NOTSENT_LOWAT:
+      *level = IPPROTO_TCP;
+      *name = TCP_NOTSENT_LOWAT;
+      return true;
+#endif
+#ifdef TCP_USER_TIMEOUT
+    case kOptionTCP_USER_TIMEOUT:
+      *level = IPPROTO_TCP;
+      *name = TCP_USER_TIMEOUT;
+      return true;
+#endif
+#ifdef TCP_QUICKACK
+    case kOptionTCP_QUICKACK:
+      *level = IPPROTO_TCP;
+      *name = TCP_QUICKACK;
+      return true;
+#endif
+#ifdef SO_BUSY_POLL
+    case kOptionSO_BUSY_POLL:
+      *level = SOL_SOCKET;
+      *name = SO_BUSY_POLL;
+      return true;
+#endif
+#ifdef TCP_FASTOPEN
+    case kOptionTCP_FASTOPEN:
+      *level = IPPROTO_TCP;
+      *name = TCP_FASTOPEN;
+      return true;
+#endif
+#ifdef TCP_FASTOPEN_CONNECT
+    case kOptionTCP_FASTOPEN_CONNECT:
+      *level = IPPROTO_TCP;
+      *name = TCP_FASTOPEN_CONNECT;
+      return true;
+#endif
+#ifdef TCP_DEFER_ACCEPT
+    case kOptionTCP_DEFER_ACCEPT:
+      *level = IPPROTO_TCP;
+      *name = TCP_DEFER_ACCEPT;
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+bool IsBoolean(Option option) {
+  return option == kOptionTCP_QUICKACK ||
+         option == kOptionTCP_FASTOPEN_CONNECT;
+}
+#endif  // _WIN32
+
+}  // anonymous namespace
+
+int SetOption(const uv_handle_t* handle, Option option, int value) {
+#ifdef _WIN32
+  return UV_ENOTSUP;
+#else
+  int level;
+  int name;
+  if (!Lookup(option, &level, &name))
+    return UV_ENOTSUP;
+
+  uv_os_fd_t fd;
+  int err = uv_fileno(handle, &fd);
+  if (err != 0)
+    return err;
+
+  if (IsBoolean(option))
+    value = value != 0;
+  if (setsockopt(fd, level, name, &value, sizeof(value)) == -1)
+    return uv_translate_sys_error(errno);
+  return 0;
+#endif
+}
+
+int GetOption(const uv_handle_t* handle, Option option, int* value) {
+#ifdef _WIN32
+  return UV_ENOTSUP;
+#else
+  int level;
+  int name;
+  if (!Lookup(option, &level, &name))
+    return UV_ENOTSUP;
+
+  uv_os_fd_t fd;
+  int err = uv_fileno(handle, &fd);
+  if (err != 0)
+    return err;
+
+  socklen_t len = sizeof(*value);
+  if (getsockopt(fd, level, name, value, &len) == -1)
+    return uv_translate_sys_error(errno);
+  if (IsBoolean(option))
+    *value = *value != 0;
+  return 0;
+#endif
+}
+
+int GetTCPInfo(const uv_handle_t* handle, double* fields) {
+#if defined(__linux__) && defined(TCP_INFO)
+  uv_os_fd_t fd;
+  int err = uv_fileno(handle, &fd);
+  if (err != 0)
+    return err;
+
+  // Older kernels fill in a shorter struct and set `len` accordingly; the
+  // fields they do not know about stay zero.
+  tcp_info info {};
+  socklen_t len = sizeof(info);
+  if (getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &len) == -1)
+    return uv_translate_sys_error(errno);
+  CHECK_LE(len, sizeof(info));
+
+  fields[kTCPInfoSTATE] = info.tcpi_state;
+  fields[kTCPInfoRTT] = info.tcpi_rtt;
+  fields[kTCPInfoRTT_VARIANCE] = info.tcpi_rttvar;
+  fields[kTCPInfoRTO] = info.tcpi_rto;
+  fields[kTCPInfoRETRANSMITS] = info.tcpi_retransmits;
+  fields[kTCPInfoTOTAL_RETRANSMITS] = info.tcpi_total_retrans;
+  fields[kTCPInfoCONGESTION_WINDOW] = info.tcpi_snd_cwnd;
+  fields[kTCPInfoSLOW_START_THRESHOLD] = info.tcpi_snd_ssthresh;
+  fields[kTCPInfoMSS] = info.tcpi_snd_mss;
+  fields[kTCPInfoUNACKED] = info.tcpi_unacked;
+  fields[kTCPInfoLOST] = info.tcpi_lost;
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+void DefineConstants(Local<Context> context, Local<Object> target) {
+  v8::Isolate* isolate = context->GetIsolate();
+  Local<Object> options = Object::New(isolate);
+#define V(name)                                                               \
+  options->Set(context,                                                       \
+               FIXED_ONE_BYTE_STRING(isolate, #name),                         \
+               Integer::New(isolate, kOption##name)).Check();
+  SOCKET_OPTIONS(V)
+#undef V
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "socketOptions"),
+              options).Check();
+}
+
+}  // namespace socket_options
+}  // namespace node
@@ -0,0 +1,69 @@
+#ifndef SRC_SOCKET_OPTIONS_H_
+#define SRC_SOCKET_OPTIONS_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "uv.h"
+#include "v8.h"
+
+namespace node {
+namespace socket_options {
+
+// Socket options that can be set on TCP and UDP handles with
+// `setSocketOption()`. The ids are exposed to JS as constants of the
+// `tcp_wrap` and `udp_wrap` bindings; options that are not supported by the
+// platform fail with UV_ENOTSUP.
+#define SOCKET_OPTIONS(V)                                                     \
+  V(TCP_NOTSENT_LOWAT)                                                        \
+  V(TCP_USER_TIMEOUT)                                                         \
+  V(TCP_QUICKACK)                                                             \
+  V(SO_BUSY_POLL)                                                             \
+  V(TCP_FASTOPEN)                                                             \
+  V(TCP_FASTOPEN_CONNECT)                                                     \
+  V(TCP_DEFER_ACCEPT)
+
+enum Option {
+#define V(name) kOption##name,
+  SOCKET_OPTIONS(V)
+#undef V
+  kOptionCount
+};
+
+// The fields written by GetTCPInfo(). Times are in microseconds. Keep this in
+// sync with `tcpInfoFields` in lib/internal/net.js.
+#define TCP_INFO_FIELDS(V)                                                    \
+  V(STATE)                                                                    \
+  V(RTT)                                                                      \
+  V(RTT_VARIANCE)                                                             \
+  V(RTO)                                                                      \
+  V(RETRANSMITS)                                                              \
+  V(TOTAL_RETRANSMITS)                                                        \
+  V(CONGESTION_WINDOW)                                                        \
+  V(SLOW_START_THRESHOLD)                                                     \
+  V(MSS)                                                                      \
+  V(UNACKED)                                                                  \
+  V(LOST)
+
+enum TCPInfoField {
+#define V(name) kTCPInfo##name,
+  TCP_INFO_FIELDS(V)
+#undef V
+  kTCPInfoFieldCount
+};
+
+// These return 0 or a libuv error code. UV_EBADF means that the handle does
+// not have a socket yet, e.g. because it is neither bound nor connected.
+int SetOption(const uv_handle_t* handle, Option option, int value);
+int GetOption(const uv_handle_t* handle, Option option, int* value);
+int GetTCPInfo(const uv_handle_t* handle, double* fields);
+
+// Defines the `socketOptions` object, which maps option names to ids.
+void DefineConstants(v8::Local<v8::Context> context,
+                     v8::Local<v8::Object> target);
+
+}  // namespace socket_options
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_SOCKET_OPTIONS_H_
@@ -519,6 +519,11 @@ void CustomBufferJSListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
   CHECK_NOT_NULL(stream_);
   CHECK_EQ(buf.base, buffer_.base);
 
+  // Nothing was written into the buffer, so it stays in place and there is
+  // no need to ask JS land for the next one.
+  if (nread == 0)
+    return;
+
   StreamBase* stream = static_cast<StreamBase*>(stream_);
   Environment* env = stream->stream_env();
   HandleScope handle_scope(env->isolate());
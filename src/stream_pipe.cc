@@ -10,6 +10,7 @@ using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Integer;
 using v8::Local;
 using v8::Object;
 using v8::String;
@@ -85,8 +86,9 @@ void StreamPipe::Unpipe(bool is_in_deletion) {
     Local<Value> onunpipe;
     if (!object->Get(env->context(), env->onunpipe_string()).ToLocal(&onunpipe))
       return;
+    Local<Value> arg = Integer::New(env->isolate(), error_);
     if (onunpipe->IsFunction() &&
-        MakeCallback(onunpipe.As<Function>(), 0, nullptr).IsEmpty()) {
+        MakeCallback(onunpipe.As<Function>(), 1, &arg).IsEmpty()) {
       return;
     }
 
@@ -129,6 +131,8 @@ void StreamPipe::ReadableListener::OnStreamRead(ssize_t nread,
     // EOF or error; stop reading and pass the error to the previous listener
     // (which might end up in JS).
     pipe->is_eof_ = true;
+    if (nread != UV_EOF && pipe->error_ == 0)
+      pipe->error_ = static_cast<int>(nread);
     // Cache `sink()` here because the previous listener might do things
     // that eventually lead to an `Unpipe()` call.
     StreamBase* sink = pipe->sink();
@@ -152,9 +156,11 @@ void StreamPipe::ProcessData(size_t nread, AllocatedBuffer&& buf) {
   uv_buf_t buffer = uv_buf_init(buf.data(), nread);
   StreamWriteResult res = sink()->Write(&buffer, 1);
   pending_writes_++;
+  bytes_transferred_ += nread;
   if (!res.async) {
     writable_listener_.OnStreamAfterWrite(nullptr, res.err);
   } else {
+    own_writes_.insert(res.wrap);
     is_reading_ = false;
     res.wrap->SetAllocatedStorage(std::move(buf));
     if (source() != nullptr)
@@ -165,7 +171,15 @@ void StreamPipe::ProcessData(size_t nread, AllocatedBuffer&& buf) {
 void StreamPipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
                                                       int status) {
   StreamPipe* pipe = ContainerOf(&StreamPipe::writable_listener_, this);
+  if (w != nullptr && pipe->own_writes_.erase(w) == 0) {
+    // This write was not made by the pipe.
+    CHECK_NOT_NULL(previous_listener_);
+    previous_listener_->OnStreamAfterWrite(w, status);
+    return;
+  }
   pipe->pending_writes_--;
+  if (status != 0 && pipe->error_ == 0)
+    pipe->error_ = status;
   if (pipe->is_closed_) {
     if (pipe->pending_writes_ == 0) {
       Environment* env = pipe->env();
@@ -190,7 +204,9 @@ void StreamPipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
     CHECK_NOT_NULL(previous_listener_);
     StreamListener* prev = previous_listener_;
     pipe->Unpipe();
-    prev->OnStreamAfterWrite(w, status);
+    // Synchronous failures have no write request that could be reported.
+    if (w != nullptr)
+      prev->OnStreamAfterWrite(w, status);
     return;
   }
 
@@ -204,6 +220,8 @@ void StreamPipe::WritableListener::OnStreamAfterShutdown(ShutdownWrap* w,
   StreamPipe* pipe = ContainerOf(&StreamPipe::writable_listener_, this);
   CHECK_NOT_NULL(previous_listener_);
   StreamListener* prev = previous_listener_;
+  if (status != 0 && pipe->error_ == 0)
+    pipe->error_ = status;
   pipe->Unpipe();
   prev->OnStreamAfterShutdown(w, status);
 }
@@ -219,7 +237,10 @@ void StreamPipe::ReadableListener::OnStreamDestroy() {
 void StreamPipe::WritableListener::OnStreamDestroy() {
   StreamPipe* pipe = ContainerOf(&StreamPipe::writable_listener_, this);
   pipe->sink_destroyed_ = true;
+  if (!pipe->is_eof_ && pipe->error_ == 0)
+    pipe->error_ = UV_EPIPE;
   pipe->is_eof_ = true;
+  pipe->own_writes_.clear();
   pipe->pending_writes_ = 0;
   pipe->Unpipe();
 }
@@ -282,6 +303,12 @@ void StreamPipe::PendingWrites(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(pipe->pending_writes_);
 }
 
+void StreamPipe::BytesTransferred(const FunctionCallbackInfo<Value>& args) {
+  StreamPipe* pipe;
+  ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(pipe->bytes_transferred_));
+}
+
 namespace {
 
 void InitializeStreamPipe(Local<Object> target,
@@ -298,6 +325,7 @@ void InitializeStreamPipe(Local<Object> target,
   env->SetProtoMethod(pipe, "start", StreamPipe::Start);
   env->SetProtoMethod(pipe, "isClosed", StreamPipe::IsClosed);
   env->SetProtoMethod(pipe, "pendingWrites", StreamPipe::PendingWrites);
+  env->SetProtoMethod(pipe, "bytesTransferred", StreamPipe::BytesTransferred);
   pipe->Inherit(AsyncWrap::GetConstructorTemplate(env));
   pipe->SetClassName(stream_pipe_string);
   pipe->InstanceTemplate()->SetInternalFieldCount(
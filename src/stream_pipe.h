@@ -5,6 +5,8 @@
 
 #include "stream_base.h"
 
+#include <unordered_set>
+
 namespace node {
 
 class StreamPipe : public AsyncWrap {
@@ -19,6 +21,8 @@ class StreamPipe : public AsyncWrap {
   static void Unpipe(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void IsClosed(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void PendingWrites(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void BytesTransferred(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
 
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(StreamPipe)
@@ -29,6 +33,12 @@ class StreamPipe : public AsyncWrap {
   inline StreamBase* sink();
 
   int pending_writes_ = 0;
+  uint64_t bytes_transferred_ = 0;
+  // The first error that ended the pipe; passed to `onunpipe`.
+  int error_ = 0;
+  // Writes to the sink that were issued by this pipe, so that completions
+  // of writes made by others while piping can be passed on.
+  std::unordered_set<WriteWrap*> own_writes_;
   bool is_reading_ = false;
   bool is_eof_ = false;
   bool is_closed_ = true;
@@ -31,8 +31,10 @@
 #include "udp_wrap.h"
 #include "util-inl.h"
 
+#include <algorithm>
 #include <cstring>  // memcpy()
 #include <climits>  // INT_MAX
+#include <vector>
 
 
 namespace node {
@@ -45,6 +47,7 @@ using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::Number;
 using v8::Object;
 using v8::PropertyAttribute;
 using v8::ReadOnly;
@@ -150,6 +153,29 @@ Local<FunctionTemplate> LibuvStreamWrap::GetConstructorTemplate(
         Local<FunctionTemplate>(),
         static_cast<PropertyAttribute>(ReadOnly | DontDelete));
     env->SetProtoMethod(tmpl, "setBlocking", SetBlocking);
+    env->SetProtoMethod(tmpl, "setIdleTimeout", SetIdleTimeout);
+    env->SetProtoMethod(tmpl, "refreshIdleTimeout", RefreshIdleTimeout);
+    env->SetProtoMethod(tmpl, "setWriteCoalescing", SetWriteCoalescing);
+    Local<FunctionTemplate> get_coalesced_writes =
+        FunctionTemplate::New(env->isolate(),
+                              GetCoalescedWrites,
+                              env->as_callback_data(),
+                              Signature::New(env->isolate(), tmpl));
+    tmpl->PrototypeTemplate()->SetAccessorProperty(
+        FIXED_ONE_BYTE_STRING(env->isolate(), "coalescedWrites"),
+        get_coalesced_writes,
+        Local<FunctionTemplate>(),
+        static_cast<PropertyAttribute>(ReadOnly | DontDelete));
+    Local<FunctionTemplate> get_coalesced_flushes =
+        FunctionTemplate::New(env->isolate(),
+                              GetCoalescedFlushes,
+                              env->as_callback_data(),
+                              Signature::New(env->isolate(), tmpl));
+    tmpl->PrototypeTemplate()->SetAccessorProperty(
+        FIXED_ONE_BYTE_STRING(env->isolate(), "coalescedFlushes"),
+        get_coalesced_flushes,
+        Local<FunctionTemplate>(),
+        static_cast<PropertyAttribute>(ReadOnly | DontDelete));
     StreamBase::AddMethods(env, tmpl);
     env->set_libuv_stream_wrap_ctor_template(tmpl);
   }
@@ -245,6 +271,7 @@ static MaybeLocal<Object> AcceptHandle(Environment* env,
 
 
 void LibuvStreamWrap::OnUvRead(ssize_t nread, const uv_buf_t* buf) {
+  RefreshIdleTimeout();
   HandleScope scope(env()->isolate());
   Context::Scope context_scope(env()->context());
   uv_handle_type type = UV_UNKNOWN_HANDLE;
@@ -295,10 +322,110 @@ void LibuvStreamWrap::GetWriteQueueSize(
   }
 
   uint32_t write_queue_size = wrap->stream()->write_queue_size;
+  // Data that waits to be coalesced has not been passed to libuv yet.
+  if (wrap->coalesced_write_)
+    write_queue_size += wrap->coalesced_write_->length;
   info.GetReturnValue().Set(write_queue_size);
 }
 
 
+void LibuvStreamWrap::GetCoalescedWrites(
+    const FunctionCallbackInfo<Value>& info) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, info.This());
+  // uint64_t -> double. 53bits is enough for all real cases.
+  info.GetReturnValue().Set(static_cast<double>(wrap->coalesced_writes_));
+}
+
+
+void LibuvStreamWrap::GetCoalescedFlushes(
+    const FunctionCallbackInfo<Value>& info) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, info.This());
+  info.GetReturnValue().Set(static_cast<double>(wrap->coalesced_flushes_));
+}
+
+
+void LibuvStreamWrap::SetWriteCoalescing(
+    const FunctionCallbackInfo<Value>& args) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  wrap->SetWriteCoalescing(args[0]->IsTrue());
+}
+
+
+void LibuvStreamWrap::SetWriteCoalescing(bool enable) {
+  coalesce_writes_ = enable;
+  // A failure is reported to the requests of the coalesced writes.
+  if (!enable)
+    FlushCoalescedWrites();
+}
+
+
+int LibuvStreamWrap::FlushCoalescedWrites() {
+  if (!coalesced_write_)
+    return 0;
+
+  std::unique_ptr<CoalescedWrite> write = std::move(coalesced_write_);
+  coalesced_flushes_++;
+  RefreshIdleTimeout();
+  uv_buf_t buf = uv_buf_init(write->storage.data(), write->length);
+  int err = uv_write(&write->req, stream(), &buf, 1, AfterCoalescedWrite);
+  if (err == 0) {
+    // Released in AfterCoalescedWrite().
+    write.release();
+    return 0;
+  }
+
+  // This may be called from within a write or shutdown call, so the waiting
+  // requests are completed from outside of it.
+  BaseObjectPtr<LibuvStreamWrap> strong_ref{this};
+  env()->SetImmediate([this, strong_ref, write = std::move(write), err](
+      Environment* env) {
+    FinishCoalescedWrite(write.get(), err);
+  });
+  return err;
+}
+
+
+void LibuvStreamWrap::ScheduleCoalescedFlush() {
+  if (coalesce_flush_scheduled_)
+    return;
+  coalesce_flush_scheduled_ = true;
+
+  BaseObjectPtr<LibuvStreamWrap> strong_ref{this};
+  env()->SetImmediate([this, strong_ref](Environment* env) {
+    coalesce_flush_scheduled_ = false;
+    if (!coalesced_write_)
+      return;
+    if (!IsAlive() || IsClosing()) {
+      std::unique_ptr<CoalescedWrite> write = std::move(coalesced_write_);
+      FinishCoalescedWrite(write.get(), UV_ECANCELED);
+      return;
+    }
+    FlushCoalescedWrites();
+  });
+}
+
+
+void LibuvStreamWrap::FinishCoalescedWrite(CoalescedWrite* write,
+                                           int status) {
+  HandleScope scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  for (WriteWrap* req_wrap : write->waiting)
+    req_wrap->Done(status);
+}
+
+
+void LibuvStreamWrap::AfterCoalescedWrite(uv_write_t* req, int status) {
+  std::unique_ptr<CoalescedWrite> write {
+      ContainerOf(&CoalescedWrite::req, req) };
+  LibuvStreamWrap* wrap = static_cast<LibuvStreamWrap*>(req->handle->data);
+  wrap->RefreshIdleTimeout();
+  wrap->FinishCoalescedWrite(write.get(), status);
+}
+
+
 void LibuvStreamWrap::SetBlocking(const FunctionCallbackInfo<Value>& args) {
   LibuvStreamWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -325,6 +452,9 @@ WriteWrap* LibuvStreamWrap::CreateWriteWrap(Local<Object> object) {
 
 int LibuvStreamWrap::DoShutdown(ShutdownWrap* req_wrap_) {
   LibuvShutdownWrap* req_wrap = static_cast<LibuvShutdownWrap*>(req_wrap_);
+  int err = FlushCoalescedWrites();
+  if (err != 0)
+    return err;
   return req_wrap->Dispatch(uv_shutdown, stream(), AfterUvShutdown);
 }
 
@@ -333,12 +463,161 @@ void LibuvStreamWrap::AfterUvShutdown(uv_shutdown_t* req, int status) {
   LibuvShutdownWrap* req_wrap = static_cast<LibuvShutdownWrap*>(
       LibuvShutdownWrap::from_req(req));
   CHECK_NOT_NULL(req_wrap);
+  static_cast<LibuvStreamWrap*>(req->handle->data)->RefreshIdleTimeout();
   HandleScope scope(req_wrap->env()->isolate());
   Context::Scope context_scope(req_wrap->env()->context());
   req_wrap->Done(status);
 }
 
 
+void LibuvStreamWrap::SetIdleTimeout(uint64_t timeout) {
+  if (timeout == 0) {
+    if (idle_timeout_ != 0)
+      env()->idle_timeout_tracker()->Remove(this);
+    idle_timeout_ = 0;
+    return;
+  }
+
+  idle_timeout_ = timeout;
+  RefreshIdleTimeout();
+  IdleTimeoutTracker::Get(env())->Add(this);
+}
+
+
+void LibuvStreamWrap::SetIdleTimeout(const FunctionCallbackInfo<Value>& args) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(args[0]->IsNumber());
+  double timeout = args[0].As<Number>()->Value();
+  CHECK_GE(timeout, 0);
+  if (!wrap->IsAlive() || wrap->IsClosing())
+    return;
+  wrap->SetIdleTimeout(static_cast<uint64_t>(timeout));
+}
+
+
+void LibuvStreamWrap::RefreshIdleTimeout(
+    const FunctionCallbackInfo<Value>& args) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  wrap->RefreshIdleTimeout();
+}
+
+
+void LibuvStreamWrap::OnClose() {
+  if (coalesced_write_) {
+    std::unique_ptr<CoalescedWrite> write = std::move(coalesced_write_);
+    FinishCoalescedWrite(write.get(), UV_ECANCELED);
+  }
+
+  if (idle_timeout_ == 0)
+    return;
+  idle_timeout_ = 0;
+  IdleTimeoutTracker* tracker = env()->idle_timeout_tracker();
+  if (tracker != nullptr)
+    tracker->Remove(this);
+}
+
+
+IdleTimeoutTracker::IdleTimeoutTracker(Environment* env) : env_(env) {
+  CHECK_EQ(uv_timer_init(env->event_loop(), &timer_), 0);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&timer_));
+  env->AddCleanupHook(Cleanup, this);
+}
+
+
+IdleTimeoutTracker* IdleTimeoutTracker::Get(Environment* env) {
+  IdleTimeoutTracker* tracker = env->idle_timeout_tracker();
+  if (tracker == nullptr) {
+    tracker = new IdleTimeoutTracker(env);
+    env->set_idle_timeout_tracker(tracker);
+  }
+  return tracker;
+}
+
+
+void IdleTimeoutTracker::Cleanup(void* arg) {
+  IdleTimeoutTracker* tracker = static_cast<IdleTimeoutTracker*>(arg);
+  Environment* env = tracker->env_;
+  env->set_idle_timeout_tracker(nullptr);
+  for (LibuvStreamWrap* stream : tracker->streams_)
+    stream->idle_timeout_ = 0;
+  env->CloseHandle(&tracker->timer_, [](uv_timer_t* handle) {
+    IdleTimeoutTracker* tracker =
+        ContainerOf(&IdleTimeoutTracker::timer_, handle);
+    delete tracker;
+  });
+}
+
+
+void IdleTimeoutTracker::Add(LibuvStreamWrap* stream) {
+  streams_.insert(stream);
+  UpdateInterval(std::max(
+      kMinInterval, std::min(kMaxInterval, stream->idle_timeout_ / 8)));
+}
+
+
+void IdleTimeoutTracker::Remove(LibuvStreamWrap* stream) {
+  streams_.erase(stream);
+  if (streams_.empty()) {
+    uv_timer_stop(&timer_);
+    interval_ = 0;
+  }
+}
+
+
+void IdleTimeoutTracker::UpdateInterval(uint64_t interval) {
+  if (interval_ != 0 && interval >= interval_)
+    return;
+  interval_ = interval;
+  uv_timer_start(&timer_, OnTimer, interval_, interval_);
+}
+
+
+void IdleTimeoutTracker::OnTimer(uv_timer_t* handle) {
+  IdleTimeoutTracker* tracker =
+      ContainerOf(&IdleTimeoutTracker::timer_, handle);
+  tracker->Sweep();
+}
+
+
+void IdleTimeoutTracker::Sweep() {
+  uint64_t now = uv_now(env_->event_loop());
+  uint64_t shortest = UINT64_MAX;
+  std::vector<BaseObjectPtr<LibuvStreamWrap>> expired;
+
+  for (LibuvStreamWrap* stream : streams_) {
+    shortest = std::min(shortest, stream->idle_timeout_);
+    if (stream->idle_timeout_fired_ ||
+        now - stream->last_activity_ < stream->idle_timeout_) {
+      continue;
+    }
+    stream->idle_timeout_fired_ = true;
+    expired.emplace_back(stream);
+  }
+
+  // Let the interval grow again once short timeouts are gone.
+  uint64_t interval =
+      std::max(kMinInterval, std::min(kMaxInterval, shortest / 8));
+  if (!streams_.empty() && interval > interval_) {
+    interval_ = interval;
+    uv_timer_start(&timer_, OnTimer, interval_, interval_);
+  }
+
+  if (expired.empty())
+    return;
+
+  HandleScope handle_scope(env_->isolate());
+  Context::Scope context_scope(env_->context());
+  for (const BaseObjectPtr<LibuvStreamWrap>& stream : expired) {
+    // Earlier callbacks may have closed the stream or changed its timeout.
+    if (!stream->idle_timeout_fired_ || stream->IsClosing())
+      continue;
+    stream->MakeCallback(env_->ontimeout_string(), 0, nullptr);
+  }
+}
+
+
 // NOTE: Call to this function could change both `buf`'s and `count`'s
 // values, shifting their base and decrementing their length. This is
 // required in order to skip the data that was successfully written via
@@ -349,6 +628,19 @@ int LibuvStreamWrap::DoTryWrite(uv_buf_t** bufs, size_t* count) {
   uv_buf_t* vbufs = *bufs;
   size_t vcount = *count;
 
+  // Writes that can be coalesced are left to DoWrite(), and nothing may
+  // overtake data that still waits to be coalesced.
+  if (coalesced_write_)
+    return 0;
+  if (coalesce_writes_) {
+    size_t total = 0;
+    for (size_t i = 0; i < vcount; i++)
+      total += vbufs[i].len;
+    if (total <= kCoalesceMaxWriteSize)
+      return 0;
+  }
+
+  RefreshIdleTimeout();
   err = uv_try_write(stream(), vbufs, vcount);
   if (err == UV_ENOSYS || err == UV_EAGAIN)
     return 0;
@@ -383,6 +675,40 @@ int LibuvStreamWrap::DoWrite(WriteWrap* req_wrap,
                              uv_buf_t* bufs,
                              size_t count,
                              uv_stream_t* send_handle) {
+  size_t total = 0;
+  for (size_t i = 0; i < count; i++)
+    total += bufs[i].len;
+
+  if (coalesce_writes_ &&
+      send_handle == nullptr &&
+      total <= kCoalesceMaxWriteSize) {
+    if (coalesced_write_ &&
+        coalesced_write_->length + total > kCoalesceBufferSize) {
+      int err = FlushCoalescedWrites();
+      if (err != 0)
+        return err;
+    }
+    if (!coalesced_write_) {
+      coalesced_write_ = std::make_unique<CoalescedWrite>();
+      coalesced_write_->storage = env()->AllocateManaged(kCoalesceBufferSize);
+    }
+    CoalescedWrite* write = coalesced_write_.get();
+    for (size_t i = 0; i < count; i++) {
+      memcpy(write->storage.data() + write->length, bufs[i].base, bufs[i].len);
+      write->length += bufs[i].len;
+    }
+    // `req_wrap` is completed along with the other requests in `write`.
+    write->waiting.push_back(req_wrap);
+    coalesced_writes_++;
+    ScheduleCoalescedFlush();
+    return 0;
+  }
+
+  // Anything that is written directly has to go after the coalesced data.
+  int err = FlushCoalescedWrites();
+  if (err != 0)
+    return err;
+
   LibuvWriteWrap* w = static_cast<LibuvWriteWrap*>(req_wrap);
   return w->Dispatch(uv_write2,
                      stream(),
@@ -398,6 +724,7 @@ void LibuvStreamWrap::AfterUvWrite(uv_write_t* req, int status) {
   LibuvWriteWrap* req_wrap = static_cast<LibuvWriteWrap*>(
       LibuvWriteWrap::from_req(req));
   CHECK_NOT_NULL(req_wrap);
+  static_cast<LibuvStreamWrap*>(req->handle->data)->RefreshIdleTimeout();
   HandleScope scope(req_wrap->env()->isolate());
   Context::Scope context_scope(req_wrap->env()->context());
   req_wrap->Done(status);
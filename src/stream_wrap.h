@@ -28,6 +28,10 @@
 #include "handle_wrap.h"
 #include "v8.h"
 
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
 namespace node {
 
 class Environment;
@@ -78,6 +82,25 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
 
   static LibuvStreamWrap* From(Environment* env, v8::Local<v8::Object> object);
 
+  // Sets the idle timeout of the stream in milliseconds, or disables it if
+  // `timeout` is 0. `ontimeout` is called on the JS object once the stream
+  // has been idle for that long; activity is tracked without calling into JS.
+  void SetIdleTimeout(uint64_t timeout);
+  // Counts as activity on the stream.
+  inline void RefreshIdleTimeout();
+
+  // Enables or disables the coalescing of small writes. While enabled, the
+  // data of writes of up to kCoalesceMaxWriteSize bytes is copied into a
+  // per-stream buffer, and their requests stay pending until the buffer has
+  // been written out with a single uv_write(). That happens at the end of the
+  // current event loop iteration, once the buffer would exceed
+  // kCoalesceBufferSize bytes, or before any other write or shutdown, so that
+  // the order of writes is preserved.
+  void SetWriteCoalescing(bool enable);
+
+  static constexpr size_t kCoalesceMaxWriteSize = 4096;
+  static constexpr size_t kCoalesceBufferSize = 64 * 1024;
+
  protected:
   LibuvStreamWrap(Environment* env,
                   v8::Local<v8::Object> object,
@@ -101,6 +124,17 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   static void GetWriteQueueSize(
       const v8::FunctionCallbackInfo<v8::Value>& info);
   static void SetBlocking(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetIdleTimeout(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void RefreshIdleTimeout(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetWriteCoalescing(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetCoalescedWrites(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void GetCoalescedFlushes(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+
+  void OnClose() override;
 
   // Callbacks for libuv
   void OnUvAlloc(size_t suggested_size, uv_buf_t* buf);
@@ -109,8 +143,36 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   static void AfterUvWrite(uv_write_t* req, int status);
   static void AfterUvShutdown(uv_shutdown_t* req, int status);
 
+  // The data of coalesced writes and the requests that wait for it.
+  struct CoalescedWrite {
+    uv_write_t req;
+    AllocatedBuffer storage;
+    size_t length = 0;
+    std::vector<WriteWrap*> waiting;
+  };
+
+  // Writes out the data of the pending coalesced writes. A synchronous
+  // failure is reported to the waiting requests as well as returned.
+  int FlushCoalescedWrites();
+  void ScheduleCoalescedFlush();
+  // Completes the waiting requests of `write` with `status`.
+  void FinishCoalescedWrite(CoalescedWrite* write, int status);
+  static void AfterCoalescedWrite(uv_write_t* req, int status);
+
   uv_stream_t* const stream_;
 
+  uint64_t idle_timeout_ = 0;
+  uint64_t last_activity_ = 0;
+  bool idle_timeout_fired_ = false;
+
+  bool coalesce_writes_ = false;
+  bool coalesce_flush_scheduled_ = false;
+  std::unique_ptr<CoalescedWrite> coalesced_write_;
+  uint64_t coalesced_writes_ = 0;
+  uint64_t coalesced_flushes_ = 0;
+
+  friend class IdleTimeoutTracker;
+
 #ifdef _WIN32
   // We don't always have an FD that we could look up on the stream_
   // object itself on Windows. However, for some cases, we open handles
@@ -122,6 +184,44 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
 #endif
 };
 
+// Checks the idle timeouts of all LibuvStreamWraps of an Environment with a
+// single coarse, unrefed timer, instead of keeping a timer per stream. The
+// timer runs only while there are streams with an idle timeout.
+class IdleTimeoutTracker {
+ public:
+  static IdleTimeoutTracker* Get(Environment* env);
+
+  void Add(LibuvStreamWrap* stream);
+  void Remove(LibuvStreamWrap* stream);
+
+  // The timer fires every eighth of the shortest idle timeout, but not more
+  // often than every kMinInterval and at least every kMaxInterval ms. The
+  // lower bound keeps a few sockets with short timeouts from making every
+  // sweep walk all streams at a high rate; their timeouts fire late instead.
+  static constexpr uint64_t kMinInterval = 100;
+  static constexpr uint64_t kMaxInterval = 1000;
+
+ private:
+  explicit IdleTimeoutTracker(Environment* env);
+
+  static void Cleanup(void* arg);
+  static void OnTimer(uv_timer_t* handle);
+  void Sweep();
+  void UpdateInterval(uint64_t interval);
+
+  Environment* const env_;
+  uv_timer_t timer_;
+  uint64_t interval_ = 0;
+  std::unordered_set<LibuvStreamWrap*> streams_;
+};
+
+inline void LibuvStreamWrap::RefreshIdleTimeout() {
+  if (idle_timeout_ != 0) {
+    last_activity_ = uv_now(stream_->loop);
+    idle_timeout_fired_ = false;
+  }
+}
+
 
 }  // namespace node
 
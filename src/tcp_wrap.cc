@@ -33,12 +33,19 @@
 
 #include <cstdlib>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 
 namespace node {
 
+using v8::ArrayBuffer;
 using v8::Boolean;
 using v8::Context;
 using v8::EscapableHandleScope;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -90,6 +97,8 @@ void TCPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "open", Open);
   env->SetProtoMethod(t, "bind", Bind);
   env->SetProtoMethod(t, "listen", Listen);
+  env->SetProtoMethod(t, "setAcceptBatching", SetAcceptBatching);
+  env->SetProtoMethod(t, "enableAcceptMetrics", EnableAcceptMetrics);
   env->SetProtoMethod(t, "connect", Connect);
   env->SetProtoMethod(t, "bind6", Bind6);
   env->SetProtoMethod(t, "connect6", Connect6);
@@ -99,6 +108,9 @@ void TCPWrap::Initialize(Local<Object> target,
                       GetSockOrPeerName<TCPWrap, uv_tcp_getpeername>);
   env->SetProtoMethod(t, "setNoDelay", SetNoDelay);
   env->SetProtoMethod(t, "setKeepAlive", SetKeepAlive);
+  env->SetProtoMethod(t, "setSocketOption", SetSocketOption);
+  env->SetProtoMethod(t, "getSocketOption", GetSocketOption);
+  env->SetProtoMethod(t, "getTCPInfo", GetTCPInfo);
 
 #ifdef _WIN32
   env->SetProtoMethod(t, "setSimultaneousAccepts", SetSimultaneousAccepts);
@@ -125,6 +137,8 @@ void TCPWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, SOCKET);
   NODE_DEFINE_CONSTANT(constants, SERVER);
   NODE_DEFINE_CONSTANT(constants, UV_TCP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, kBindReusePort);
+  socket_options::DefineConstants(context, constants);
   target->Set(context,
               env->constants_string(),
               constants).Check();
@@ -191,6 +205,109 @@ void TCPWrap::SetKeepAlive(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void TCPWrap::SetSocketOption(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  CHECK(args[0]->IsUint32());
+  CHECK(args[1]->IsInt32());
+  uint32_t id = args[0].As<Uint32>()->Value();
+  CHECK_LT(id, socket_options::kOptionCount);
+  socket_options::Option option = static_cast<socket_options::Option>(id);
+  int value = args[1].As<Int32>()->Value();
+
+  int err = socket_options::SetOption(
+      reinterpret_cast<uv_handle_t*>(&wrap->handle_), option, value);
+  // A socket that has not connected yet may not have a file descriptor.
+  // Remember the option, so that it can be applied before connecting.
+  if (err == UV_EBADF && wrap->provider_type() == PROVIDER_TCPWRAP &&
+      !wrap->IsClosing()) {
+    wrap->pending_socket_options_.emplace_back(option, value);
+    err = 0;
+  }
+  args.GetReturnValue().Set(err);
+}
+
+
+void TCPWrap::GetSocketOption(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(args[0]->IsUint32());
+  uint32_t id = args[0].As<Uint32>()->Value();
+  CHECK_LT(id, socket_options::kOptionCount);
+
+  int value;
+  int err = socket_options::GetOption(
+      reinterpret_cast<uv_handle_t*>(&wrap->handle_),
+      static_cast<socket_options::Option>(id),
+      &value);
+  if (err != 0) {
+    env->CollectUVExceptionInfo(args[1], err, "getsockopt");
+    return args.GetReturnValue().SetUndefined();
+  }
+  args.GetReturnValue().Set(value);
+}
+
+
+void TCPWrap::GetTCPInfo(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->ByteLength(),
+           socket_options::kTCPInfoFieldCount * sizeof(double));
+  Local<ArrayBuffer> ab = array->Buffer();
+  double* fields = reinterpret_cast<double*>(
+      static_cast<char*>(ab->GetBackingStore()->Data()) + array->ByteOffset());
+  int err = socket_options::GetTCPInfo(
+      reinterpret_cast<uv_handle_t*>(&wrap->handle_), fields);
+  args.GetReturnValue().Set(err);
+}
+
+
+int TCPWrap::ApplyPendingSocketOptions(int family) {
+  if (pending_socket_options_.empty())
+    return 0;
+
+  uv_handle_t* handle = reinterpret_cast<uv_handle_t*>(&handle_);
+  uv_os_fd_t fd;
+  if (uv_fileno(handle, &fd) == UV_EBADF) {
+#ifdef _WIN32
+    return UV_ENOTSUP;
+#else
+    int type = SOCK_STREAM;
+#ifdef SOCK_CLOEXEC
+    type |= SOCK_CLOEXEC;
+#endif
+    int sock = socket(family, type, 0);
+    if (sock == -1)
+      return uv_translate_sys_error(errno);
+    // uv_tcp_open() makes the socket non-blocking; uv_tcp_connect() then
+    // uses it instead of creating one of its own.
+    int err = fcntl(sock, F_SETFD, FD_CLOEXEC) == -1 ?
+        uv_translate_sys_error(errno) : uv_tcp_open(&handle_, sock);
+    if (err != 0) {
+      close(sock);
+      return err;
+    }
+#endif
+  }
+
+  std::vector<std::pair<socket_options::Option, int>> options;
+  options.swap(pending_socket_options_);
+  for (const auto& option : options) {
+    int err = socket_options::SetOption(handle, option.first, option.second);
+    if (err != 0)
+      return err;
+  }
+  return 0;
+}
+
+
 #ifdef _WIN32
 void TCPWrap::SetSimultaneousAccepts(const FunctionCallbackInfo<Value>& args) {
   TCPWrap* wrap;
@@ -235,7 +352,7 @@ void TCPWrap::Bind(
   int port;
   unsigned int flags = 0;
   if (!args[1]->Int32Value(env->context()).To(&port)) return;
-  if (family == AF_INET6 &&
+  if (!args[2]->IsUndefined() &&
       !args[2]->Uint32Value(env->context()).To(&flags)) {
     return;
   }
@@ -243,6 +360,22 @@ void TCPWrap::Bind(
   T addr;
   int err = uv_ip_addr(*ip_address, port, &addr);
 
+  if (err == 0 && (flags & kBindReusePort)) {
+    flags &= ~kBindReusePort;
+    uv_os_sock_t sock;
+    err = NewReusePortSocket(family, SOCK_STREAM, &sock);
+    if (err == 0) {
+      err = uv_tcp_open(&wrap->handle_, sock);
+      if (err == 0) {
+        wrap->set_fd(sock);
+      } else {
+#ifndef _WIN32
+        close(sock);
+#endif
+      }
+    }
+  }
+
   if (err == 0) {
     err = uv_tcp_bind(&wrap->handle_,
                       reinterpret_cast<const sockaddr*>(&addr),
@@ -316,6 +449,11 @@ void TCPWrap::Connect(const FunctionCallbackInfo<Value>& args,
   T addr;
   int err = uv_ip_addr(*ip_address, &addr);
 
+  if (err == 0) {
+    err = wrap->ApplyPendingSocketOptions(
+        reinterpret_cast<const sockaddr*>(&addr)->sa_family);
+  }
+
   if (err == 0) {
     AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(wrap);
     ConnectWrap* req_wrap =
@@ -332,6 +470,38 @@ void TCPWrap::Connect(const FunctionCallbackInfo<Value>& args,
 }
 
 
+// also used by udp_wrap.cc
+int NewReusePortSocket(int family, int type, uv_os_sock_t* sock) {
+#if defined(_WIN32) || !defined(SO_REUSEPORT)
+  return UV_ENOTSUP;
+#else
+#ifdef SO_REUSEPORT_LB
+  const int option = SO_REUSEPORT_LB;
+#else
+  const int option = SO_REUSEPORT;
+#endif
+#ifdef SOCK_CLOEXEC
+  type |= SOCK_CLOEXEC;
+#endif
+
+  int fd = socket(family, type, 0);
+  if (fd == -1)
+    return uv_translate_sys_error(errno);
+
+  const int on = 1;
+  if (fcntl(fd, F_SETFD, FD_CLOEXEC) == -1 ||
+      setsockopt(fd, SOL_SOCKET, option, &on, sizeof(on)) == -1) {
+    const int err = uv_translate_sys_error(errno);
+    close(fd);
+    return err;
+  }
+
+  *sock = fd;
+  return 0;
+#endif
+}
+
+
 // also used by udp_wrap.cc
 Local<Object> AddressToJS(Environment* env,
                           const sockaddr* addr,
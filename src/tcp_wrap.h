@@ -26,6 +26,10 @@
 
 #include "async_wrap.h"
 #include "connection_wrap.h"
+#include "socket_options.h"
+
+#include <utility>
+#include <vector>
 
 namespace node {
 
@@ -72,6 +76,9 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetNoDelay(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetKeepAlive(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetSocketOption(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetSocketOption(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetTCPInfo(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Bind(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Bind6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Listen(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -91,6 +98,12 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
   static void SetSimultaneousAccepts(
       const v8::FunctionCallbackInfo<v8::Value>& args);
 #endif
+
+  // Creates the socket of a handle that is about to connect, if needed, and
+  // applies the options that were set while it did not have one yet.
+  int ApplyPendingSocketOptions(int family);
+
+  std::vector<std::pair<socket_options::Option, int>> pending_socket_options_;
 };
 
 
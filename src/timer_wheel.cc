@@ -0,0 +1,298 @@
+#include "timer_wheel.h"
+#include "async_wrap-inl.h"
+#include "base_object-inl.h"
+#include "env-inl.h"
+#include "handle_wrap.h"
+#include "memory_tracker-inl.h"
+#include "util-inl.h"
+
+#include <algorithm>
+
+namespace node {
+
+using v8::Array;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::String;
+using v8::Uint32;
+using v8::Value;
+
+TimerWheel::TimerWheel(Environment* env,
+                       Local<Object> object,
+                       uint32_t resolution)
+    : HandleWrap(env,
+                 object,
+                 reinterpret_cast<uv_handle_t*>(&timer_),
+                 AsyncWrap::PROVIDER_TIMERWHEEL),
+      resolution_(resolution),
+      start_(uv_now(env->event_loop())) {
+  heads_.fill(kNone);
+  CHECK_EQ(uv_timer_init(env->event_loop(), &timer_), 0);
+  // The timeouts in the wheel never keep the event loop alive.
+  uv_unref(reinterpret_cast<uv_handle_t*>(&timer_));
+}
+
+void TimerWheel::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("entries", entries_.capacity() * sizeof(Entry));
+  tracker->TrackFieldWithSize("free_ids",
+                              free_ids_.capacity() * sizeof(uint32_t));
+  tracker->TrackFieldWithSize("expired",
+                              expired_.capacity() * sizeof(uint32_t));
+  tracker->TrackFieldWithSize("removed_ids",
+                              removed_ids_.capacity() * sizeof(uint32_t));
+}
+
+uint64_t TimerWheel::NowTick() const {
+  return (uv_now(env()->event_loop()) - start_) / resolution_;
+}
+
+uint32_t TimerWheel::Add(uint64_t timeout) {
+  uint32_t id;
+  if (!free_ids_.empty()) {
+    id = free_ids_.back();
+    free_ids_.pop_back();
+  } else {
+    id = static_cast<uint32_t>(entries_.size());
+    CHECK_NE(id, kNone);
+    entries_.emplace_back();
+  }
+  Entry& entry = entries_[id];
+  entry.timeout = timeout;
+  entry.slot = kNone;
+  Schedule(id);
+  return id;
+}
+
+void TimerWheel::Refresh(uint32_t id) {
+  CHECK_LT(id, entries_.size());
+  if (entries_[id].slot != kNone)
+    Unlink(id);
+  Schedule(id);
+}
+
+void TimerWheel::Remove(uint32_t id) {
+  CHECK_LT(id, entries_.size());
+  if (entries_[id].slot != kNone)
+    Unlink(id);
+  // While expired ids are being delivered to JS, an id that has not been
+  // looked up yet must not be handed out again for a new timeout.
+  if (delivering_)
+    removed_ids_.push_back(id);
+  else
+    free_ids_.push_back(id);
+}
+
+void TimerWheel::Schedule(uint32_t id) {
+  Entry& entry = entries_[id];
+  // Round up, so that a timeout never expires early.
+  uint64_t elapsed = uv_now(env()->event_loop()) - start_;
+  entry.expiry = std::max(
+      (elapsed + entry.timeout + resolution_ - 1) / resolution_,
+      current_tick_ + 1);
+  Link(id);
+
+  // Wake up when the timeout expires, or when the entry needs to be moved to
+  // a lower level.
+  if (entry.slot < kSlots)
+    MaybeStartTimer(entry.expiry);
+  else
+    MaybeStartTimer(((current_tick_ >> kSlotBits) + 1) << kSlotBits);
+}
+
+void TimerWheel::Link(uint32_t id) {
+  Entry& entry = entries_[id];
+  uint64_t delta = entry.expiry - current_tick_;
+  size_t level = 0;
+  while (level < kLevels - 1 && (delta >> (kSlotBits * (level + 1))) != 0)
+    level++;
+
+  uint64_t index;
+  if ((delta >> (kSlotBits * (level + 1))) != 0) {
+    // Too far out for the wheel; park the entry in the slot of the top level
+    // that comes up last. It is placed again once that slot is cascaded.
+    index = (current_tick_ >> (kSlotBits * level)) - 1;
+  } else {
+    index = entry.expiry >> (kSlotBits * level);
+  }
+  uint32_t slot = level * kSlots + (index & (kSlots - 1));
+
+  entry.slot = slot;
+  entry.prev = kNone;
+  entry.next = heads_[slot];
+  if (entry.next != kNone)
+    entries_[entry.next].prev = id;
+  heads_[slot] = id;
+  level_counts_[level]++;
+  active_++;
+}
+
+void TimerWheel::Unlink(uint32_t id) {
+  Entry& entry = entries_[id];
+  if (entry.prev != kNone)
+    entries_[entry.prev].next = entry.next;
+  else
+    heads_[entry.slot] = entry.next;
+  if (entry.next != kNone)
+    entries_[entry.next].prev = entry.prev;
+  level_counts_[entry.slot / kSlots]--;
+  active_--;
+  entry.slot = kNone;
+}
+
+void TimerWheel::CascadeSlot(uint32_t slot) {
+  while (heads_[slot] != kNone) {
+    uint32_t id = heads_[slot];
+    Unlink(id);
+    if (entries_[id].expiry <= current_tick_)
+      expired_.push_back(id);
+    else
+      Link(id);
+  }
+}
+
+void TimerWheel::Advance(uint64_t tick) {
+  while (current_tick_ < tick) {
+    if (active_ == 0) {
+      current_tick_ = tick;
+      break;
+    }
+    if (level_counts_[0] == 0) {
+      // Nothing can expire before the next slot of level 1 comes up.
+      uint64_t boundary = ((current_tick_ >> kSlotBits) + 1) << kSlotBits;
+      if (boundary > tick) {
+        current_tick_ = tick;
+        break;
+      }
+      current_tick_ = boundary - 1;
+    }
+
+    current_tick_++;
+    size_t level = 1;
+    while (level < kLevels &&
+           (current_tick_ & ((uint64_t{1} << (kSlotBits * level)) - 1)) == 0) {
+      level++;
+    }
+    // Cascade from the top, so that entries can move down more than one level.
+    while (--level > 0) {
+      uint64_t index = current_tick_ >> (kSlotBits * level);
+      CascadeSlot(level * kSlots + (index & (kSlots - 1)));
+    }
+    CascadeSlot(current_tick_ & (kSlots - 1));
+  }
+}
+
+void TimerWheel::MaybeStartTimer(uint64_t tick) {
+  if (tick >= timer_tick_ || IsHandleClosing())
+    return;
+  timer_tick_ = tick;
+  uint64_t due = start_ + tick * resolution_;
+  uint64_t now = uv_now(env()->event_loop());
+  uv_timer_start(&timer_, OnTimeout, due > now ? due - now : 0, 0);
+}
+
+void TimerWheel::OnTimeout(uv_timer_t* handle) {
+  TimerWheel* wheel = ContainerOf(&TimerWheel::timer_, handle);
+  Environment* env = wheel->env();
+  wheel->timer_tick_ = kNever;
+  wheel->Advance(wheel->NowTick());
+
+  if (wheel->active_ > 0) {
+    uint64_t next = kNever;
+    for (uint64_t tick = wheel->current_tick_ + 1;
+         tick <= wheel->current_tick_ + kSlots;
+         tick++) {
+      if (wheel->heads_[tick & (kSlots - 1)] != kNone) {
+        next = tick;
+        break;
+      }
+    }
+    if (next == kNever)
+      next = ((wheel->current_tick_ >> kSlotBits) + 1) << kSlotBits;
+    wheel->MaybeStartTimer(next);
+  }
+
+  if (wheel->expired_.empty())
+    return;
+
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  std::vector<Local<Value>> ids(wheel->expired_.size());
+  for (size_t i = 0; i < ids.size(); i++)
+    ids[i] = Integer::NewFromUnsigned(env->isolate(), wheel->expired_[i]);
+  wheel->expired_.clear();
+
+  Local<Value> arg = Array::New(env->isolate(), ids.data(), ids.size());
+  wheel->delivering_ = true;
+  wheel->MakeCallback(env->ontimeout_string(), 1, &arg);
+  wheel->delivering_ = false;
+  wheel->free_ids_.insert(wheel->free_ids_.end(),
+                          wheel->removed_ids_.begin(),
+                          wheel->removed_ids_.end());
+  wheel->removed_ids_.clear();
+}
+
+void TimerWheel::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsUint32());
+  Environment* env = Environment::GetCurrent(args);
+  uint32_t resolution = args[0].As<Uint32>()->Value();
+  CHECK_GT(resolution, 0);
+  new TimerWheel(env, args.This(), resolution);
+}
+
+void TimerWheel::Add(const FunctionCallbackInfo<Value>& args) {
+  TimerWheel* wheel;
+  ASSIGN_OR_RETURN_UNWRAP(&wheel, args.Holder());
+  CHECK(args[0]->IsNumber());
+  double timeout = args[0].As<Number>()->Value();
+  CHECK_GE(timeout, 0);
+  args.GetReturnValue().Set(wheel->Add(static_cast<uint64_t>(timeout)));
+}
+
+void TimerWheel::Refresh(const FunctionCallbackInfo<Value>& args) {
+  TimerWheel* wheel;
+  ASSIGN_OR_RETURN_UNWRAP(&wheel, args.Holder());
+  CHECK(args[0]->IsUint32());
+  wheel->Refresh(args[0].As<Uint32>()->Value());
+}
+
+void TimerWheel::Remove(const FunctionCallbackInfo<Value>& args) {
+  TimerWheel* wheel;
+  ASSIGN_OR_RETURN_UNWRAP(&wheel, args.Holder());
+  CHECK(args[0]->IsUint32());
+  wheel->Remove(args[0].As<Uint32>()->Value());
+}
+
+void TimerWheel::Active(const FunctionCallbackInfo<Value>& args) {
+  TimerWheel* wheel;
+  ASSIGN_OR_RETURN_UNWRAP(&wheel, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(wheel->active()));
+}
+
+void TimerWheel::Initialize(Environment* env, Local<Object> target) {
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+  Local<String> class_name = FIXED_ONE_BYTE_STRING(env->isolate(),
+                                                   "TimerWheel");
+  t->SetClassName(class_name);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      TimerWheel::kInternalFieldCount);
+  t->Inherit(HandleWrap::GetConstructorTemplate(env));
+
+  env->SetProtoMethod(t, "add", Add);
+  env->SetProtoMethod(t, "refresh", Refresh);
+  env->SetProtoMethod(t, "remove", Remove);
+  env->SetProtoMethod(t, "active", Active);
+
+  target->Set(env->context(),
+              class_name,
+              t->GetFunction(env->context()).ToLocalChecked()).Check();
+}
+
+}  // namespace node
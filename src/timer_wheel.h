@@ -0,0 +1,101 @@
+#ifndef SRC_TIMER_WHEEL_H_
+#define SRC_TIMER_WHEEL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "handle_wrap.h"
+#include "uv.h"
+#include "v8.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace node {
+
+class Environment;
+
+// A hierarchical timing wheel for large numbers of unrefed timeouts, such as
+// the idle timeouts of sockets. Adding, refreshing and removing a timeout are
+// O(1). Time is divided into ticks of `resolution` milliseconds; all timeouts
+// that expire within the same tick are passed to JS in a single call to
+// `ontimeout`, as an array of the ids returned by `add()`.
+//
+// The wheel consists of kLevels levels of kSlots slots each. A timeout that
+// expires within kSlots ticks is kept in a slot of level 0; timeouts that
+// expire later are kept in higher levels and moved down ("cascaded") when
+// the slot of the lower level that they map to comes up.
+class TimerWheel : public HandleWrap {
+ public:
+  static constexpr size_t kLevels = 4;
+  static constexpr size_t kSlotBits = 8;
+  static constexpr size_t kSlots = 1 << kSlotBits;
+
+  TimerWheel(Environment* env,
+             v8::Local<v8::Object> object,
+             uint32_t resolution);
+
+  // Returns the id of a new timeout that expires after `timeout` ms.
+  uint32_t Add(uint64_t timeout);
+  // Restarts a timeout, even if it has expired before.
+  void Refresh(uint32_t id);
+  // Frees a timeout. Its id may be returned by a later Add() call.
+  void Remove(uint32_t id);
+
+  size_t active() const { return active_; }
+
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(TimerWheel)
+  SET_SELF_SIZE(TimerWheel)
+
+ private:
+  static constexpr uint32_t kNone = UINT32_MAX;
+  static constexpr uint64_t kNever = UINT64_MAX;
+
+  struct Entry {
+    uint64_t expiry;  // In ticks.
+    uint64_t timeout;  // In ms.
+    uint32_t prev;
+    uint32_t next;
+    // Index into heads_, or kNone if the entry is not scheduled.
+    uint32_t slot;
+  };
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Add(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Refresh(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Remove(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Active(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void OnTimeout(uv_timer_t* handle);
+
+  uint64_t NowTick() const;
+  void Schedule(uint32_t id);
+  void Link(uint32_t id);
+  void Unlink(uint32_t id);
+  void Advance(uint64_t tick);
+  void CascadeSlot(uint32_t slot);
+  void MaybeStartTimer(uint64_t tick);
+
+  uv_timer_t timer_;
+  const uint32_t resolution_;
+  const uint64_t start_;
+  uint64_t current_tick_ = 0;
+  uint64_t timer_tick_ = kNever;
+  bool delivering_ = false;
+  size_t active_ = 0;
+  std::array<size_t, kLevels> level_counts_ {};
+  std::array<uint32_t, kLevels * kSlots> heads_;
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> free_ids_;
+  std::vector<uint32_t> expired_;
+  // Ids removed while expired ids are delivered, freed once that is done.
+  std::vector<uint32_t> removed_ids_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_TIMER_WHEEL_H_
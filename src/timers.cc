@@ -1,4 +1,5 @@
 #include "env-inl.h"
+#include "timer_wheel.h"
 #include "util-inl.h"
 #include "v8.h"
 
@@ -58,6 +59,8 @@ void Initialize(Local<Object> target,
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "immediateInfo"),
               env->immediate_info()->fields().GetJSArray()).Check();
+
+  TimerWheel::Initialize(env, target);
 }
 
 
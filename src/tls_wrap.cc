@@ -32,6 +32,30 @@
 #include "stream_base-inl.h"
 #include "util-inl.h"
 
+#include <openssl/kdf.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <cerrno>
+// Older kernel and libc headers lack some of what is needed.
+#if defined(TCP_ULP) && defined(TLS_TX) && defined(TLS_SET_RECORD_TYPE) && \
+    defined(TLS_CIPHER_AES_GCM_128) && defined(TLS_CIPHER_AES_GCM_256)
+#define HAVE_KERNEL_TLS 1
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif
+#endif
+#endif
+
+#ifndef HAVE_KERNEL_TLS
+#define HAVE_KERNEL_TLS 0
+#endif
+
 namespace node {
 
 using crypto::SecureContext;
@@ -56,6 +80,95 @@ using v8::Signature;
 using v8::String;
 using v8::Value;
 
+namespace {
+
+#if HAVE_KERNEL_TLS
+// HKDF-Expand-Label() from RFC 8446, section 7.1, with an empty context.
+bool HkdfExpandLabel(const EVP_MD* md,
+                     const unsigned char* secret,
+                     size_t secret_length,
+                     const char* label,
+                     unsigned char* out,
+                     size_t length) {
+  static const char kPrefix[] = "tls13 ";
+  const size_t prefix_length = sizeof(kPrefix) - 1;
+  const size_t label_length = strlen(label);
+  CHECK_LE(prefix_length + label_length, 255);
+
+  unsigned char info[2 + 1 + 255 + 1];
+  size_t info_length = 0;
+  info[info_length++] = length >> 8;
+  info[info_length++] = length & 0xff;
+  info[info_length++] = prefix_length + label_length;
+  memcpy(info + info_length, kPrefix, prefix_length);
+  info_length += prefix_length;
+  memcpy(info + info_length, label, label_length);
+  info_length += label_length;
+  info[info_length++] = 0;
+
+  crypto::EVPKeyCtxPointer ctx(EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr));
+  return ctx &&
+      EVP_PKEY_derive_init(ctx.get()) > 0 &&
+      EVP_PKEY_CTX_hkdf_mode(ctx.get(), EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0 &&
+      EVP_PKEY_CTX_set_hkdf_md(ctx.get(), md) > 0 &&
+      EVP_PKEY_CTX_set1_hkdf_key(ctx.get(), secret, secret_length) > 0 &&
+      EVP_PKEY_CTX_add1_hkdf_info(ctx.get(), info, info_length) > 0 &&
+      EVP_PKEY_derive(ctx.get(), out, &length) > 0;
+}
+
+// The TLS 1.2 key block from RFC 5246, section 6.3.
+bool DeriveKeyBlock(SSL* ssl, const EVP_MD* md,
+                    unsigned char* out, size_t length) {
+  unsigned char master_key[SSL_MAX_MASTER_KEY_LENGTH];
+  size_t master_key_length = SSL_SESSION_get_master_key(
+      SSL_get_session(ssl), master_key, sizeof(master_key));
+  static const char kLabel[] = "key expansion";
+  unsigned char randoms[2 * SSL3_RANDOM_SIZE];
+  SSL_get_server_random(ssl, randoms, SSL3_RANDOM_SIZE);
+  SSL_get_client_random(ssl, randoms + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+
+  crypto::EVPKeyCtxPointer ctx(
+      EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr));
+  bool ok = ctx &&
+      EVP_PKEY_derive_init(ctx.get()) > 0 &&
+      EVP_PKEY_CTX_set_tls1_prf_md(ctx.get(), md) > 0 &&
+      EVP_PKEY_CTX_set1_tls1_prf_secret(
+          ctx.get(), master_key, master_key_length) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(
+          ctx.get(), kLabel, sizeof(kLabel) - 1) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(
+          ctx.get(), randoms, sizeof(randoms)) > 0 &&
+      EVP_PKEY_derive(ctx.get(), out, &length) > 0;
+  OPENSSL_cleanse(master_key, sizeof(master_key));
+  return ok;
+}
+
+// `iv` is the 4 byte implicit part of the nonce followed by the 8 byte
+// explicit part for TLS 1.2, or the full 12 byte IV for TLS 1.3.
+template <typename CryptoInfo>
+bool SetTransmitKey(int fd,
+                    uint16_t version,
+                    uint16_t cipher_type,
+                    const unsigned char* key,
+                    const unsigned char* iv,
+                    uint64_t sequence) {
+  CryptoInfo info;
+  memset(&info, 0, sizeof(info));
+  info.info.version = version;
+  info.info.cipher_type = cipher_type;
+  memcpy(info.key, key, sizeof(info.key));
+  memcpy(info.salt, iv, sizeof(info.salt));
+  memcpy(info.iv, iv + sizeof(info.salt), sizeof(info.iv));
+  for (size_t i = 0; i < sizeof(info.rec_seq); i++)
+    info.rec_seq[sizeof(info.rec_seq) - 1 - i] = (sequence >> (8 * i)) & 0xff;
+  int err = setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info));
+  OPENSSL_cleanse(&info, sizeof(info));
+  return err == 0;
+}
+#endif  // HAVE_KERNEL_TLS
+
+}  // anonymous namespace
+
 TLSWrap::TLSWrap(Environment* env,
                  Local<Object> obj,
                  Kind kind,
@@ -87,6 +200,10 @@ TLSWrap::TLSWrap(Environment* env,
 TLSWrap::~TLSWrap() {
   Debug(this, "~TLSWrap()");
   sc_ = nullptr;
+  if (close_notify_timer_ != nullptr) {
+    env()->CloseHandle(close_notify_timer_,
+                       [](uv_timer_t* handle) { delete handle; });
+  }
 }
 
 
@@ -294,6 +411,20 @@ void TLSWrap::EncOut() {
     return;
   }
 
+  // Once the kernel owns the keys, OpenSSL can't write records anymore. That
+  // happens for renegotiation and for TLS 1.3 KeyUpdate requests.
+  if (kernel_tls_state_ == KernelTLSState::kActive) {
+    if (ssl_ != nullptr && BIO_pending(enc_out_) != 0) {
+      Debug(this, "Discarding encrypted output after kernel TLS offload");
+      crypto::NodeBIO::FromBIO(enc_out_)->Reset();
+      HandleScope handle_scope(env()->isolate());
+      Context::Scope context_scope(env()->context());
+      Local<Value> err = ERR_TLS_KERNEL_OFFLOAD(env()->isolate());
+      MakeCallback(env()->onerror_string(), 1, &err);
+    }
+    return;
+  }
+
   // Split-off queue
   if (established_ && current_write_ != nullptr) {
     Debug(this, "EncOut() setting write_callback_scheduled_");
@@ -379,6 +510,19 @@ void TLSWrap::OnStreamAfterWrite(WriteWrap* req_wrap, int status) {
     status = UV_ECANCELED;
   }
 
+  if (kernel_tls_state_ == KernelTLSState::kActive) {
+    Debug(this, "Finished cleartext write with kernel TLS");
+    // Release data that was held back while the KeyUpdate was written.
+    pending_cleartext_input_ = AllocatedBuffer();
+    if (current_write_ != nullptr) {
+      WriteWrap* w = current_write_;
+      current_write_ = nullptr;
+      w->Done(status);
+    }
+    FinishKernelTLSShutdown();
+    return;
+  }
+
   // Handle error
   if (status) {
     if (shutdown_) {
@@ -394,12 +538,39 @@ void TLSWrap::OnStreamAfterWrite(WriteWrap* req_wrap, int status) {
   // Commit
   crypto::NodeBIO::FromBIO(enc_out_)->Read(nullptr, write_size_);
 
+  // If the KeyUpdate was the last thing OpenSSL wrote, the kernel can take
+  // over with the new traffic secret. Data written in the meantime was held
+  // back in pending_cleartext_input_, and is now written by the kernel too.
+  if (kernel_tls_state_ == KernelTLSState::kKeyUpdate) {
+    write_size_ = 0;
+    if (BIO_pending(enc_out_) == 0)
+      StartKernelTLS();
+    else
+      kernel_tls_state_ = KernelTLSState::kUnavailable;
+
+    if (kernel_tls_state_ == KernelTLSState::kActive) {
+      if (current_write_ == nullptr)
+        return;
+      uv_buf_t buf = uv_buf_init(pending_cleartext_input_.data(),
+                                 pending_cleartext_input_.size());
+      int err = KernelTLSWrite(&buf, 1);
+      if (err != 0) {
+        WriteWrap* w = current_write_;
+        current_write_ = nullptr;
+        w->Done(err);
+      }
+      return;
+    }
+  }
+
   // Ensure that the progress will be made and `InvokeQueued` will be called.
   ClearIn();
 
   // Try writing more data
   write_size_ = 0;
   EncOut();
+
+  MaybeStartKernelTLS();
 }
 
 
@@ -505,36 +676,43 @@ void TLSWrap::ClearOut() {
 
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  char out[kClearOutChunkSize];
   int read;
   for (;;) {
-    read = SSL_read(ssl_.get(), out, sizeof(out));
-    Debug(this, "Read %d bytes of cleartext output", read);
-
+    // Peek first, so that a buffer is only requested from the listener when
+    // there is cleartext to put into it. This also decrypts the next record,
+    // so that SSL_pending() tells how much of it is available.
+    char peek;
+    read = SSL_peek(ssl_.get(), &peek, 1);
     if (read <= 0)
       break;
+    size_t pending = SSL_pending(ssl_.get());
+
+    // Decrypt straight into the buffer of the current listener, which is the
+    // user-supplied one for sockets that were created with `onread`.
+    uv_buf_t buf = EmitAlloc(std::min<size_t>(
+        std::max<size_t>(pending, 1), kClearOutChunkSize));
+    if (buf.len == 0) {
+      EmitRead(0, buf);
+      return;
+    }
+    read = SSL_read(ssl_.get(),
+                    buf.base,
+                    static_cast<int>(std::min<size_t>(buf.len, INT_MAX)));
+    Debug(this, "Read %d bytes of cleartext output", read);
 
-    char* current = out;
-    while (read > 0) {
-      int avail = read;
-
-      uv_buf_t buf = EmitAlloc(avail);
-      if (static_cast<int>(buf.len) < avail)
-        avail = buf.len;
-      memcpy(buf.base, current, avail);
-      EmitRead(avail, buf);
-
-      // Caveat emptor: OnRead() calls into JS land which can result in
-      // the SSL context object being destroyed.  We have to carefully
-      // check that ssl_ != nullptr afterwards.
-      if (ssl_ == nullptr) {
-        Debug(this, "Returning from read loop, ssl_ == nullptr");
-        return;
-      }
+    // Hand the buffer back to the listener even if nothing was read.
+    EmitRead(read > 0 ? read : 0, buf);
 
-      read -= avail;
-      current += avail;
+    // Caveat emptor: OnRead() calls into JS land which can result in
+    // the SSL context object being destroyed.  We have to carefully
+    // check that ssl_ != nullptr afterwards.
+    if (ssl_ == nullptr) {
+      Debug(this, "Returning from read loop, ssl_ == nullptr");
+      return;
     }
+
+    if (read <= 0)
+      break;
   }
 
   int flags = SSL_get_shutdown(ssl_.get());
@@ -559,8 +737,10 @@ void TLSWrap::ClearOut() {
       Debug(this, "Got SSL error (%d), calling onerror", err);
       // When TLS Alert are stored in wbio,
       // it should be flushed to socket before destroyed.
-      if (BIO_pending(enc_out_) != 0)
+      if (BIO_pending(enc_out_) != 0 &&
+          kernel_tls_state_ != KernelTLSState::kActive) {
         EncOut();
+      }
 
       MakeCallback(env()->onerror_string(), 1, &arg);
     }
@@ -586,16 +766,25 @@ void TLSWrap::ClearIn() {
     return;
   }
 
+  // Pending data is written by OnStreamAfterWrite() while kernel TLS is
+  // being started, and by the kernel once it is active.
+  if (kernel_tls_state_ == KernelTLSState::kKeyUpdate ||
+      kernel_tls_state_ == KernelTLSState::kActive) {
+    Debug(this, "Returning from ClearIn(), kernel TLS");
+    return;
+  }
+
   AllocatedBuffer data = std::move(pending_cleartext_input_);
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
   crypto::NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(data.size());
-  int written = SSL_write(ssl_.get(), data.data(), data.size());
-  Debug(this, "Writing %zu bytes, written = %d", data.size(), written);
-  CHECK(written == -1 || written == static_cast<int>(data.size()));
+  size_t written;
+  int ret = WriteCleartext(data.data(), data.size(), &written);
+  Debug(this, "Writing %zu bytes, written = %zu", data.size(), written);
+  CHECK(ret == -1 || written == data.size());
 
   // All written
-  if (written != -1) {
+  if (ret != -1) {
     Debug(this, "Successfully wrote all data to SSL");
     return;
   }
@@ -606,7 +795,7 @@ void TLSWrap::ClearIn() {
 
   int err;
   std::string error_str;
-  Local<Value> arg = GetSSLError(written, &err, &error_str);
+  Local<Value> arg = GetSSLError(ret, &err, &error_str);
   if (!arg.IsEmpty()) {
     Debug(this, "Got SSL error (%d)", err);
     write_callback_scheduled_ = true;
@@ -617,8 +806,213 @@ void TLSWrap::ClearIn() {
     Debug(this, "Pushing data back");
     // Push back the not-yet-written data. This can be skipped in the error
     // case because no further writes would succeed anyway.
-    pending_cleartext_input_ = std::move(data);
+    if (written == 0) {
+      pending_cleartext_input_ = std::move(data);
+    } else {
+      pending_cleartext_input_ = env()->AllocateManaged(data.size() - written);
+      memcpy(pending_cleartext_input_.data(),
+             data.data() + written,
+             data.size() - written);
+    }
+  }
+}
+
+
+int TLSWrap::WriteCleartext(const char* data,
+                            size_t length,
+                            size_t* written) {
+  *written = 0;
+#ifdef SSL_set_max_send_fragment
+  if (dynamic_record_sizing_ && established_) {
+    uint64_t now = uv_now(env()->event_loop());
+    if (now - last_write_time_ > kDynamicRecordIdleTimeout)
+      dynamic_record_bytes_ = 0;
+    last_write_time_ = now;
+
+    // The part of the data up to the threshold goes out in small records, so
+    // that the peer can start decrypting as soon as the first TCP segment
+    // arrives, and the rest in a second SSL_write() with full sized records.
+    if (dynamic_record_bytes_ < kDynamicRecordBoostThreshold) {
+      size_t small_length = std::min(
+          length, kDynamicRecordBoostThreshold - dynamic_record_bytes_);
+      SSL_set_max_send_fragment(
+          ssl_.get(),
+          std::min<unsigned int>(kDynamicRecordSmallSize, max_send_fragment_));
+      int ret = SSL_write(ssl_.get(), data, small_length);
+      SSL_set_max_send_fragment(ssl_.get(), max_send_fragment_);
+      if (ret <= 0)
+        return ret;
+      *written = ret;
+      dynamic_record_bytes_ += ret;
+      if (*written == length)
+        return ret;
+    }
+  }
+#endif  // SSL_set_max_send_fragment
+
+  int ret = SSL_write(ssl_.get(), data + *written, length - *written);
+  if (ret > 0) {
+    *written += ret;
+    dynamic_record_bytes_ += ret;
+  }
+  if (*written > 0)
+    cleartext_written_ = true;
+  return ret;
+}
+
+
+void TLSWrap::MaybeStartKernelTLS() {
+  if (kernel_tls_state_ != KernelTLSState::kRequested)
+    return;
+
+  // Only start when every record OpenSSL has produced so far was written, so
+  // that the kernel's record sequence number is known.
+  if (!established_ ||
+      shutdown_ ||
+      ssl_ == nullptr ||
+      !SSL_is_init_finished(ssl_.get()) ||
+      write_size_ != 0 ||
+      BIO_pending(enc_out_) != 0 ||
+      current_write_ != nullptr ||
+      current_empty_write_ != nullptr ||
+      pending_cleartext_input_.size() != 0) {
+    return;
+  }
+
+#if HAVE_KERNEL_TLS
+  crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
+  Debug(this, "Starting kernel TLS");
+  kernel_tls_state_ = KernelTLSState::kUnavailable;
+
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl_.get());
+  int nid = SSL_CIPHER_get_cipher_nid(cipher);
+  if (nid != NID_aes_128_gcm && nid != NID_aes_256_gcm)
+    return;
+
+  // In TLS 1.2, the Finished message is the only record this side has
+  // encrypted with the current keys, so no application data must have been
+  // written yet.
+  int version = SSL_version(ssl_.get());
+  if (version == TLS1_2_VERSION) {
+    if (cleartext_written_)
+      return;
+#ifdef TLS_1_3_VERSION
+  } else if (version == TLS1_3_VERSION) {
+    if (kernel_tls_secret_.empty())
+      return;
+#endif
+  } else {
+    return;
+  }
+
+  if (underlying_stream()->GetAsyncWrap()->provider_type() !=
+      AsyncWrap::PROVIDER_TCPWRAP) {
+    return;
+  }
+  int fd = underlying_stream()->GetFD();
+  static const char kUlp[] = "tls";
+  if (fd < 0 || setsockopt(fd, SOL_TCP, TCP_ULP, kUlp, sizeof(kUlp)) != 0)
+    return;
+
+  if (version == TLS1_2_VERSION) {
+    StartKernelTLS();
+    return;
+  }
+
+  if (!SSL_key_update(ssl_.get(), SSL_KEY_UPDATE_NOT_REQUESTED) ||
+      SSL_do_handshake(ssl_.get()) != 1 ||
+      BIO_pending(enc_out_) == 0) {
+    return;
+  }
+  kernel_tls_state_ = KernelTLSState::kKeyUpdate;
+  EncOut();
+#else
+  kernel_tls_state_ = KernelTLSState::kUnavailable;
+#endif  // HAVE_KERNEL_TLS
+}
+
+
+void TLSWrap::StartKernelTLS() {
+  kernel_tls_state_ = KernelTLSState::kUnavailable;
+#if HAVE_KERNEL_TLS
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl_.get());
+  const EVP_MD* md = SSL_CIPHER_get_handshake_digest(cipher);
+  const bool aes_128 = SSL_CIPHER_get_cipher_nid(cipher) == NID_aes_128_gcm;
+  const size_t key_length = aes_128 ? 16 : 32;
+  unsigned char key[32];
+  unsigned char iv[12];
+  uint64_t sequence;
+  uint16_t version;
+  bool ok;
+
+  if (SSL_version(ssl_.get()) == TLS1_2_VERSION) {
+    // AES-GCM has no MAC keys, so the key block is the client and server
+    // write keys followed by their 4 byte implicit nonces. The explicit part
+    // of the nonce only has to be unique, and the kernel increments it along
+    // with the sequence number.
+    unsigned char key_block[2 * 32 + 2 * 4];
+    const size_t side = is_server() ? 1 : 0;
+    ok = DeriveKeyBlock(ssl_.get(), md, key_block, 2 * key_length + 2 * 4);
+    memcpy(key, key_block + side * key_length, key_length);
+    memcpy(iv, key_block + 2 * key_length + side * 4, 4);
+    OPENSSL_cleanse(key_block, sizeof(key_block));
+    sequence = 1;
+    for (size_t i = 0; i < 8; i++)
+      iv[4 + i] = (sequence >> (8 * (7 - i))) & 0xff;
+    version = TLS_1_2_VERSION;
+  } else {
+#ifdef TLS_1_3_VERSION
+    // The KeyUpdate switched to the next traffic secret, and the kernel
+    // writes its first record.
+    unsigned char secret[EVP_MAX_MD_SIZE];
+    const size_t secret_length = kernel_tls_secret_.size();
+    ok = HkdfExpandLabel(md, kernel_tls_secret_.data(), secret_length,
+                         "traffic upd", secret, secret_length) &&
+         HkdfExpandLabel(md, secret, secret_length, "key", key, key_length) &&
+         HkdfExpandLabel(md, secret, secret_length, "iv", iv, sizeof(iv));
+    OPENSSL_cleanse(secret, sizeof(secret));
+    sequence = 0;
+    version = TLS_1_3_VERSION;
+#else
+    ok = false;
+#endif
+  }
+  OPENSSL_cleanse(kernel_tls_secret_.data(), kernel_tls_secret_.size());
+  kernel_tls_secret_.clear();
+
+  int fd = underlying_stream()->GetFD();
+  if (ok && aes_128) {
+    ok = SetTransmitKey<tls12_crypto_info_aes_gcm_128>(
+        fd, version, TLS_CIPHER_AES_GCM_128, key, iv, sequence);
+  } else if (ok) {
+    ok = SetTransmitKey<tls12_crypto_info_aes_gcm_256>(
+        fd, version, TLS_CIPHER_AES_GCM_256, key, iv, sequence);
+  }
+  OPENSSL_cleanse(key, sizeof(key));
+  OPENSSL_cleanse(iv, sizeof(iv));
+
+  if (ok) {
+    Debug(this, "Kernel TLS is active");
+    // Renegotiation would need OpenSSL to write records again.
+    SSL_set_options(ssl_.get(), SSL_OP_NO_RENEGOTIATION);
+    kernel_tls_state_ = KernelTLSState::kActive;
+  }
+#endif  // HAVE_KERNEL_TLS
+}
+
+
+int TLSWrap::KernelTLSWrite(uv_buf_t* bufs, size_t count) {
+  StreamWriteResult res = underlying_stream()->Write(bufs, count);
+  if (res.err != 0)
+    return res.err;
+
+  if (!res.async) {
+    BaseObjectPtr<TLSWrap> strong_ref{this};
+    env()->SetImmediate([this, strong_ref](Environment* env) {
+      OnStreamAfterWrite(nullptr, 0);
+    });
   }
+  return 0;
 }
 
 
@@ -702,6 +1096,16 @@ int TLSWrap::DoWrite(WriteWrap* w,
     return UV_EPROTO;
   }
 
+  MaybeStartKernelTLS();
+  if (kernel_tls_state_ == KernelTLSState::kActive) {
+    CHECK_NULL(current_write_);
+    current_write_ = w;
+    int err = KernelTLSWrite(bufs, count);
+    if (err != 0)
+      current_write_ = nullptr;
+    return err;
+  }
+
   size_t length = 0;
   size_t i;
   size_t nonempty_i = 0;
@@ -754,9 +1158,26 @@ int TLSWrap::DoWrite(WriteWrap* w,
   }
 
   AllocatedBuffer data;
+
+  // Until the KeyUpdate that starts kernel TLS has been written, it is not
+  // known whether OpenSSL or the kernel is going to encrypt the data.
+  if (kernel_tls_state_ == KernelTLSState::kKeyUpdate) {
+    Debug(this, "Saving data until kernel TLS is started");
+    CHECK_EQ(pending_cleartext_input_.size(), 0);
+    data = env()->AllocateManaged(length);
+    size_t offset = 0;
+    for (i = 0; i < count; i++) {
+      memcpy(data.data() + offset, bufs[i].base, bufs[i].len);
+      offset += bufs[i].len;
+    }
+    pending_cleartext_input_ = std::move(data);
+    return 0;
+  }
+
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  int written = 0;
+  size_t written = 0;
+  int ret = 0;
 
   // It is common for zero length buffers to be written,
   // don't copy data if there there is one buffer with data
@@ -775,25 +1196,31 @@ int TLSWrap::DoWrite(WriteWrap* w,
     }
 
     crypto::NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(length);
-    written = SSL_write(ssl_.get(), data.data(), length);
+    ret = WriteCleartext(data.data(), length, &written);
+
+    if (ret == -1 && written != 0) {
+      AllocatedBuffer rest = env()->AllocateManaged(length - written);
+      memcpy(rest.data(), data.data() + written, length - written);
+      data = std::move(rest);
+    }
   } else {
     // Only one buffer: try to write directly, only store if it fails
     uv_buf_t* buf = &bufs[nonempty_i];
     crypto::NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(buf->len);
-    written = SSL_write(ssl_.get(), buf->base, buf->len);
+    ret = WriteCleartext(buf->base, buf->len, &written);
 
-    if (written == -1) {
-      data = env()->AllocateManaged(length);
-      memcpy(data.data(), buf->base, buf->len);
+    if (ret == -1) {
+      data = env()->AllocateManaged(length - written);
+      memcpy(data.data(), buf->base + written, length - written);
     }
   }
 
-  CHECK(written == -1 || written == static_cast<int>(length));
-  Debug(this, "Writing %zu bytes, written = %d", length, written);
+  CHECK(ret == -1 || written == length);
+  Debug(this, "Writing %zu bytes, written = %zu", length, written);
 
-  if (written == -1) {
+  if (ret == -1) {
     int err;
-    Local<Value> arg = GetSSLError(written, &err, &error_);
+    Local<Value> arg = GetSSLError(ret, &err, &error_);
 
     // If we stopped writing because of an error, it's fatal, discard the data.
     if (!arg.IsEmpty()) {
@@ -880,8 +1307,22 @@ int TLSWrap::DoShutdown(ShutdownWrap* req_wrap) {
   Debug(this, "DoShutdown()");
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  if (ssl_ && SSL_shutdown(ssl_.get()) == 0)
+  if (kernel_tls_state_ == KernelTLSState::kActive) {
+    // The close_notify alert has to be encrypted by the kernel. It must not
+    // overtake a pending write, so the shutdown waits for that write, and
+    // for the socket to have room for the alert.
+    shutdown_ = true;
+    CHECK_NULL(pending_shutdown_);
+    if (current_write_ != nullptr || !SendKernelTLSCloseNotify()) {
+      Debug(this, "Deferring shutdown until close_notify is sent");
+      pending_shutdown_ = req_wrap;
+      if (current_write_ == nullptr)
+        ScheduleCloseNotifyRetry();
+      return 0;
+    }
+  } else if (ssl_ && SSL_shutdown(ssl_.get()) == 0) {
     SSL_shutdown(ssl_.get());
+  }
 
   shutdown_ = true;
   EncOut();
@@ -889,6 +1330,83 @@ int TLSWrap::DoShutdown(ShutdownWrap* req_wrap) {
 }
 
 
+bool TLSWrap::SendKernelTLSCloseNotify() {
+#if HAVE_KERNEL_TLS
+  int fd = underlying_stream()->GetFD();
+  if (!ssl_ || fd < 0)
+    return true;
+
+  unsigned char alert[] = { SSL3_AL_WARNING, SSL_AD_CLOSE_NOTIFY };
+  unsigned char record_type = SSL3_RT_ALERT;
+  char control[CMSG_SPACE(sizeof(record_type))];
+  struct iovec iov = { alert, sizeof(alert) };
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(record_type));
+  memcpy(CMSG_DATA(cmsg), &record_type, sizeof(record_type));
+
+  ssize_t r;
+  do {
+    r = sendmsg(fd, &msg, MSG_DONTWAIT);
+  } while (r == -1 && errno == EINTR);
+
+  if (r == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+    return false;
+  // On other errors, the shutdown of the stream reports the broken socket.
+  if (r == static_cast<ssize_t>(sizeof(alert)))
+    SSL_set_shutdown(ssl_.get(), SSL_SENT_SHUTDOWN);
+#endif  // HAVE_KERNEL_TLS
+  return true;
+}
+
+
+void TLSWrap::FinishKernelTLSShutdown() {
+  if (pending_shutdown_ == nullptr || current_write_ != nullptr)
+    return;
+
+  if (!SendKernelTLSCloseNotify())
+    return ScheduleCloseNotifyRetry();
+
+  Debug(this, "Finishing deferred shutdown");
+  ShutdownWrap* req_wrap = pending_shutdown_;
+  pending_shutdown_ = nullptr;
+  int err = stream_->DoShutdown(req_wrap);
+  if (err != 0)
+    req_wrap->Done(err);
+}
+
+
+void TLSWrap::ScheduleCloseNotifyRetry() {
+  // libuv has no way to pass the record type along with a write, so wait
+  // for the peer to drain the send buffer by retrying.
+  if (close_notify_timer_ == nullptr) {
+    close_notify_timer_ = new uv_timer_t();
+    close_notify_timer_->data = this;
+    uv_timer_init(env()->event_loop(), close_notify_timer_);
+  }
+  uv_timer_start(close_notify_timer_,
+                 OnCloseNotifyTimer,
+                 kCloseNotifyRetryInterval,
+                 0);
+}
+
+
+void TLSWrap::OnCloseNotifyTimer(uv_timer_t* handle) {
+  TLSWrap* wrap = static_cast<TLSWrap*>(handle->data);
+  Environment* env = wrap->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  wrap->FinishKernelTLSShutdown();
+}
+
+
 void TLSWrap::SetVerifyMode(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -944,8 +1462,34 @@ void TLSWrap::EnableKeylogCallback(
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
   CHECK_NOT_NULL(wrap->sc_);
-  SSL_CTX_set_keylog_callback(wrap->sc_->ctx_.get(),
-      SSLWrap<TLSWrap>::KeylogCallback);
+  wrap->keylog_enabled_ = true;
+  SSL_CTX_set_keylog_callback(wrap->sc_->ctx_.get(), KeylogCallback);
+}
+
+
+void TLSWrap::KeylogCallback(const SSL* s, const char* line) {
+  TLSWrap* w = static_cast<TLSWrap*>(SSL_get_app_data(s));
+
+  // Lines have the form "<label> <client random> <secret>", in hex.
+  if (w->kernel_tls_state_ == KernelTLSState::kRequested) {
+    const char* label = w->is_server() ? "SERVER_TRAFFIC_SECRET_0 " :
+                                         "CLIENT_TRAFFIC_SECRET_0 ";
+    const char* hex = strrchr(line, ' ');
+    if (strncmp(line, label, strlen(label)) == 0 && hex != nullptr) {
+      hex++;
+      size_t length = strlen(hex) / 2;
+      if (length <= EVP_MAX_MD_SIZE) {
+        w->kernel_tls_secret_.resize(length);
+        for (size_t i = 0; i < length; i++) {
+          char byte[] = { hex[2 * i], hex[2 * i + 1], '\0' };
+          w->kernel_tls_secret_[i] = strtoul(byte, nullptr, 16);
+        }
+      }
+    }
+  }
+
+  if (w->keylog_enabled_)
+    SSLWrap<TLSWrap>::KeylogCallback(s, line);
 }
 
 // Check required capabilities were not excluded from the OpenSSL build:
@@ -958,6 +1502,36 @@ void TLSWrap::EnableKeylogCallback(
 # define HAVE_SSL_TRACE 1
 #endif
 
+void TLSWrap::EnableDynamicRecordSizing(
+    const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  wrap->dynamic_record_sizing_ = true;
+}
+
+void TLSWrap::EnableKernelTLS(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK_NOT_NULL(wrap->sc_);
+  if (wrap->kernel_tls_state_ != KernelTLSState::kOff)
+    return;
+#if HAVE_KERNEL_TLS
+  wrap->kernel_tls_state_ = KernelTLSState::kRequested;
+  // The TLS 1.3 traffic secrets are only available through the keylog
+  // callback.
+  SSL_CTX_set_keylog_callback(wrap->sc_->ctx_.get(), KeylogCallback);
+#else
+  wrap->kernel_tls_state_ = KernelTLSState::kUnavailable;
+#endif
+}
+
+void TLSWrap::IsKernelTLS(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  args.GetReturnValue().Set(
+      wrap->kernel_tls_state_ == KernelTLSState::kActive);
+}
+
 void TLSWrap::EnableTrace(
     const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
@@ -993,6 +1567,14 @@ void TLSWrap::DestroySSL(const FunctionCallbackInfo<Value>& args) {
   // And destroy
   wrap->InvokeQueued(UV_ECANCELED, "Canceled because of SSL destruction");
 
+  if (wrap->close_notify_timer_ != nullptr)
+    uv_timer_stop(wrap->close_notify_timer_);
+  if (wrap->pending_shutdown_ != nullptr) {
+    ShutdownWrap* req_wrap = wrap->pending_shutdown_;
+    wrap->pending_shutdown_ = nullptr;
+    req_wrap->Done(UV_ECANCELED);
+  }
+
   // Destroy the SSL structure and friends
   wrap->SSLWrap<TLSWrap>::DestroySSL();
   wrap->enc_in_ = nullptr;
@@ -1291,6 +1873,10 @@ void TLSWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "enableSessionCallbacks", EnableSessionCallbacks);
   env->SetProtoMethod(t, "enableKeylogCallback", EnableKeylogCallback);
   env->SetProtoMethod(t, "enableTrace", EnableTrace);
+  env->SetProtoMethod(t, "enableDynamicRecordSizing",
+                      EnableDynamicRecordSizing);
+  env->SetProtoMethod(t, "enableKernelTLS", EnableKernelTLS);
+  env->SetProtoMethod(t, "isKernelTLS", IsKernelTLS);
   env->SetProtoMethod(t, "destroySSL", DestroySSL);
   env->SetProtoMethod(t, "enableCertCb", EnableCertCb);
 
@@ -33,6 +33,7 @@
 #include <openssl/ssl.h>
 
 #include <string>
+#include <vector>
 
 namespace node {
 
@@ -108,6 +109,30 @@ class TLSWrap : public AsyncWrap,
   // Maximum number of buffers passed to uv_write()
   static const int kSimultaneousBufferCount = 10;
 
+  // With dynamic record sizing, the first kDynamicRecordBoostThreshold bytes
+  // of cleartext after the handshake, or after the connection has been idle
+  // for kDynamicRecordIdleTimeout milliseconds, are sent in records that fit
+  // into a single TCP segment. Everything else is sent in full sized records.
+  static const int kDynamicRecordSmallSize = 1300;
+  static const size_t kDynamicRecordBoostThreshold = 128 * 1024;
+  static const uint64_t kDynamicRecordIdleTimeout = 1000;
+
+  // Interval in ms at which a close_notify alert that did not fit into the
+  // socket's send buffer is retried with kernel TLS.
+  static const uint64_t kCloseNotifyRetryInterval = 10;
+
+  // Kernel TLS offload of the sending direction. It is requested from JS
+  // before the handshake, and started at the first point after it where
+  // OpenSSL has nothing left to write. For TLS 1.3, a KeyUpdate is sent first
+  // so that the kernel starts at record 0 of a known traffic secret.
+  enum class KernelTLSState {
+    kOff,
+    kRequested,
+    kKeyUpdate,  // Waiting for the KeyUpdate to be written.
+    kActive,
+    kUnavailable
+  };
+
   TLSWrap(Environment* env,
           v8::Local<v8::Object> obj,
           Kind kind,
@@ -126,6 +151,29 @@ class TLSWrap : public AsyncWrap,
   void ClearIn();  // SSL_write() clear data "in" to SSL.
   void ClearOut();  // SSL_read() clear text "out" from SSL.
 
+  // SSL_write() clear text, applying dynamic record sizing. Returns the
+  // result of the last SSL_write() call and stores the number of bytes that
+  // were accepted in `written`.
+  int WriteCleartext(const char* data, size_t length, size_t* written);
+
+  // Start kernel TLS, if it was requested and this is a point where it can
+  // be started.
+  void MaybeStartKernelTLS();
+  // Hand the keys for the sending direction to the kernel. Sets
+  // kernel_tls_state_ to kActive on success, and to kUnavailable otherwise.
+  void StartKernelTLS();
+  // Write cleartext straight to the underlying stream once kernel TLS is
+  // active. current_write_ is done when that write is.
+  int KernelTLSWrite(uv_buf_t* bufs, size_t count);
+  // Have the kernel send a close_notify alert. Returns false if the socket's
+  // send buffer is full and this needs to be retried.
+  bool SendKernelTLSCloseNotify();
+  // Send the close_notify alert of a deferred shutdown and shut down the
+  // underlying stream, once no write is pending and the alert fits.
+  void FinishKernelTLSShutdown();
+  void ScheduleCloseNotifyRetry();
+  static void OnCloseNotifyTimer(uv_timer_t* handle);
+
   // Call Done() on outstanding WriteWrap request.
   bool InvokeQueued(int status, const char* error_str = nullptr);
 
@@ -162,7 +210,12 @@ class TLSWrap : public AsyncWrap,
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableKeylogCallback(
       const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void KeylogCallback(const SSL* s, const char* line);
   static void EnableTrace(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableDynamicRecordSizing(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableKernelTLS(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void IsKernelTLS(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableCertCb(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DestroySSL(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -203,6 +256,25 @@ class TLSWrap : public AsyncWrap,
   std::string error_;
   int cycle_depth_ = 0;
 
+  bool dynamic_record_sizing_ = false;
+  // Cleartext bytes written since the handshake or the last idle period.
+  size_t dynamic_record_bytes_ = 0;
+  uint64_t last_write_time_ = 0;
+
+  KernelTLSState kernel_tls_state_ = KernelTLSState::kOff;
+  // The first TLS 1.3 traffic secret of this side, from the keylog callback.
+  std::vector<unsigned char> kernel_tls_secret_;
+  // Whether SSL_write() has encrypted any application data.
+  bool cleartext_written_ = false;
+  // Shutdown that waits for the kernel to accept the close_notify alert.
+  ShutdownWrap* pending_shutdown_ = nullptr;
+  uv_timer_t* close_notify_timer_ = nullptr;
+
+  // Whether keylog lines are passed to JS. The keylog callback of the
+  // SecureContext is shared by all of its connections, and is also used to
+  // capture the traffic secret for kernel TLS.
+  bool keylog_enabled_ = false;
+
   // If true - delivered EOF to the js-land, either after `close_notify`, or
   // after the `UV_EOF` on socket.
   bool eof_ = false;
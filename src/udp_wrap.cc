@@ -21,12 +21,25 @@
 
 #include "udp_wrap.h"
 #include "env-inl.h"
+#include "memory_tracker-inl.h"
 #include "node_buffer.h"
 #include "node_sockaddr-inl.h"
 #include "handle_wrap.h"
 #include "req_wrap-inl.h"
+#include "socket_options.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace node {
 
 using v8::Array;
@@ -35,6 +48,7 @@ using v8::DontDelete;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Int32;
 using v8::Integer;
 using v8::Local;
 using v8::MaybeLocal;
@@ -178,6 +192,11 @@ void UDPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "setBroadcast", SetBroadcast);
   env->SetProtoMethod(t, "setTTL", SetTTL);
   env->SetProtoMethod(t, "bufferSize", BufferSize);
+  env->SetProtoMethod(t, "setSocketOption", SetSocketOption);
+  env->SetProtoMethod(t, "getSocketOption", GetSocketOption);
+  env->SetProtoMethod(t, "setRecvBatchSize", SetRecvBatchSize);
+  env->SetProtoMethod(t, "sendBatch", SendBatch);
+  env->SetProtoMethod(t, "sendBatch6", SendBatch6);
 
   t->Inherit(HandleWrap::GetConstructorTemplate(env));
 
@@ -200,6 +219,9 @@ void UDPWrap::Initialize(Local<Object> target,
 
   Local<Object> constants = Object::New(env->isolate());
   NODE_DEFINE_CONSTANT(constants, UV_UDP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, kBindReusePort);
+  NODE_DEFINE_CONSTANT(constants, kMaxRecvBatchSize);
+  socket_options::DefineConstants(context, constants);
   target->Set(context,
               env->constants_string(),
               constants).Check();
@@ -254,6 +276,18 @@ void UDPWrap::DoBind(const FunctionCallbackInfo<Value>& args, int family) {
     return;
   struct sockaddr_storage addr_storage;
   int err = sockaddr_for_family(family, address.out(), port, &addr_storage);
+  if (err == 0 && (flags & kBindReusePort)) {
+    flags &= ~kBindReusePort;
+    uv_os_sock_t sock;
+    err = NewReusePortSocket(family, SOCK_DGRAM, &sock);
+    if (err == 0) {
+      err = uv_udp_open(&wrap->handle_, sock);
+#ifndef _WIN32
+      if (err != 0)
+        close(sock);
+#endif
+    }
+  }
   if (err == 0) {
     err = uv_udp_bind(&wrap->handle_,
                       reinterpret_cast<const sockaddr*>(&addr_storage),
@@ -350,6 +384,64 @@ void UDPWrap::BufferSize(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// setSocketOption(option, value)
+void UDPWrap::SetSocketOption(const FunctionCallbackInfo<Value>& args) {
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  CHECK(args[0]->IsUint32());
+  CHECK(args[1]->IsInt32());
+  uint32_t id = args[0].As<Uint32>()->Value();
+  CHECK_LT(id, socket_options::kOptionCount);
+
+  int err = socket_options::SetOption(
+      reinterpret_cast<uv_handle_t*>(&wrap->handle_),
+      static_cast<socket_options::Option>(id),
+      args[1].As<Int32>()->Value());
+  args.GetReturnValue().Set(err);
+}
+
+
+// getSocketOption(option, ctx)
+void UDPWrap::GetSocketOption(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(args[0]->IsUint32());
+  uint32_t id = args[0].As<Uint32>()->Value();
+  CHECK_LT(id, socket_options::kOptionCount);
+
+  int value;
+  int err = socket_options::GetOption(
+      reinterpret_cast<uv_handle_t*>(&wrap->handle_),
+      static_cast<socket_options::Option>(id),
+      &value);
+  if (err != 0) {
+    env->CollectUVExceptionInfo(args[1], err, "getsockopt");
+    return args.GetReturnValue().SetUndefined();
+  }
+  args.GetReturnValue().Set(value);
+}
+
+
+// setRecvBatchSize(count)
+void UDPWrap::SetRecvBatchSize(const FunctionCallbackInfo<Value>& args) {
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  CHECK(args[0]->IsUint32());
+  const size_t count = args[0].As<Uint32>()->Value();
+  CHECK_LE(count, kMaxRecvBatchSize);
+
+  wrap->recv_batch_size_ = count;
+  wrap->recv_batch_storage_.reset();
+  args.GetReturnValue().Set(0);
+}
+
+
 void UDPWrap::Connect(const FunctionCallbackInfo<Value>& args) {
   DoConnect(args, AF_INET);
 }
@@ -606,6 +698,123 @@ ssize_t UDPWrap::Send(uv_buf_t* bufs_ptr,
 }
 
 
+void UDPWrap::DoSendBatch(const FunctionCallbackInfo<Value>& args,
+                          int family) {
+  Environment* env = Environment::GetCurrent(args);
+
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  CHECK(args.Length() == 2 || args.Length() == 4);
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsUint32());
+
+  bool sendto = args.Length() == 4;
+  if (sendto) {
+    // sendBatch(list, list.length, port, address)
+    CHECK(args[2]->IsUint32());
+    CHECK(args[3]->IsString());
+  }
+
+  Local<Array> messages = args[0].As<Array>();
+  size_t count = args[1].As<Uint32>()->Value();
+
+  // Unlike send(), every element of the list is a datagram of its own.
+  MaybeStackBuffer<uv_buf_t, 64> bufs(count);
+  for (size_t i = 0; i < count; i++) {
+    Local<Value> message = messages->Get(env->context(), i).ToLocalChecked();
+    bufs[i] = uv_buf_init(Buffer::Data(message), Buffer::Length(message));
+  }
+
+  int err = 0;
+  struct sockaddr_storage addr_storage;
+  sockaddr* addr = nullptr;
+  if (sendto) {
+    const unsigned short port = args[2].As<Uint32>()->Value();
+    node::Utf8Value address(env->isolate(), args[3]);
+    err = sockaddr_for_family(family, address.out(), port, &addr_storage);
+    if (err == 0)
+      addr = reinterpret_cast<sockaddr*>(&addr_storage);
+  }
+
+  if (err != 0)
+    return args.GetReturnValue().Set(err);
+
+  ssize_t sent = wrap->TrySendBatch(*bufs, count, addr);
+  args.GetReturnValue().Set(static_cast<double>(sent));
+}
+
+// Sends as many of the datagrams in |bufs| as the socket accepts without
+// blocking. Returns how many were sent, or an error code if sending the first
+// one failed for a reason other than the socket not being writable. The
+// caller hands the remaining datagrams to Send().
+ssize_t UDPWrap::TrySendBatch(uv_buf_t* bufs,
+                              size_t count,
+                              const sockaddr* addr) {
+  if (IsHandleClosing()) return UV_EBADF;
+
+  // Datagrams that have been queued by an earlier Send() must go out first.
+  if (UNLIKELY(env()->options()->test_udp_no_try_send) ||
+      handle_.send_queue_count > 0) {
+    return 0;
+  }
+
+  size_t sent = 0;
+#ifdef __linux__
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(&handle_), &fd);
+  if (err != 0) return err;
+
+  socklen_t addrlen = 0;
+  if (addr != nullptr) {
+    addrlen = addr->sa_family == AF_INET6 ? sizeof(sockaddr_in6) :
+                                            sizeof(sockaddr_in);
+  }
+
+  constexpr size_t kMaxMessagesPerCall = 64;
+  struct mmsghdr msgs[kMaxMessagesPerCall];
+  while (sent < count) {
+    const size_t n = std::min(count - sent, kMaxMessagesPerCall);
+    memset(msgs, 0, n * sizeof(msgs[0]));
+    for (size_t i = 0; i < n; i++) {
+      msghdr* h = &msgs[i].msg_hdr;
+      h->msg_name = const_cast<sockaddr*>(addr);
+      h->msg_namelen = addrlen;
+      // uv_buf_t is layout-compatible with struct iovec on Unix.
+      h->msg_iov = reinterpret_cast<iovec*>(&bufs[sent + i]);
+      h->msg_iovlen = 1;
+    }
+
+    int r;
+    do {
+      r = sendmmsg(fd, msgs, n, 0);
+    } while (r == -1 && errno == EINTR);
+
+    if (r == -1) {
+      if (sent > 0 || errno == EAGAIN || errno == EWOULDBLOCK)
+        break;
+      return uv_translate_sys_error(errno);
+    }
+    sent += r;
+    if (static_cast<size_t>(r) < n)
+      break;
+  }
+#else
+  for (; sent < count; sent++) {
+    int err = uv_udp_try_send(&handle_, &bufs[sent], 1, addr);
+    if (err < 0) {
+      if (sent > 0 || err == UV_EAGAIN || err == UV_ENOSYS)
+        break;
+      return err;
+    }
+  }
+#endif
+  return sent;
+}
+
+
 ReqWrap<uv_udp_send_t>* UDPWrap::CreateSendWrap(size_t msg_size) {
   SendWrap* req_wrap = new SendWrap(env(),
                                     current_send_req_wrap_,
@@ -625,6 +834,16 @@ void UDPWrap::Send6(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void UDPWrap::SendBatch(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET);
+}
+
+
+void UDPWrap::SendBatch6(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET6);
+}
+
+
 AsyncWrap* UDPWrap::GetAsyncWrap() {
   return this;
 }
@@ -687,6 +906,14 @@ void UDPWrap::OnAlloc(uv_handle_t* handle,
 }
 
 uv_buf_t UDPWrap::OnAlloc(size_t suggested_size) {
+  if (recv_batch_size_ > 0) {
+    // When receiving in batches, every read goes into the same buffer, which
+    // libuv splits into one slot per datagram for recvmmsg().
+    const size_t size = recv_batch_size_ * kMaxDatagramSize;
+    if (!recv_batch_storage_)
+      recv_batch_storage_.reset(new char[size]);
+    return uv_buf_init(recv_batch_storage_.get(), size);
+  }
   return env()->AllocateManaged(suggested_size).release();
 }
 
@@ -703,6 +930,9 @@ void UDPWrap::OnRecv(ssize_t nread,
                      const uv_buf_t& buf_,
                      const sockaddr* addr,
                      unsigned int flags) {
+  if (recv_batch_size_ > 0)
+    return OnRecvBatch(nread, buf_, addr, flags);
+
   Environment* env = this->env();
   AllocatedBuffer buf(env, buf_);
   if (nread == 0 && addr == nullptr) {
@@ -730,6 +960,83 @@ void UDPWrap::OnRecv(ssize_t nread,
   MakeCallback(env->onmessage_string(), arraysize(argv), argv);
 }
 
+void UDPWrap::OnRecvBatch(ssize_t nread,
+                          const uv_buf_t& buf,
+                          const sockaddr* addr,
+                          unsigned int flags) {
+  Environment* env = this->env();
+  if (nread == 0 && addr == nullptr)
+    return;
+
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  if (nread < 0) {
+    recv_batch_.clear();
+    Local<Value> argv[] = {
+      Integer::New(env->isolate(), nread),
+      object(),
+      Undefined(env->isolate()),
+      Undefined(env->isolate())
+    };
+    MakeCallback(env->onmessage_string(), arraysize(argv), argv);
+    return;
+  }
+
+  BatchedDatagram received;
+  received.data = buf.base;
+  received.length = nread;
+  memcpy(&received.address,
+         addr,
+         addr->sa_family == AF_INET6 ? sizeof(sockaddr_in6) :
+                                       sizeof(sockaddr_in));
+  recv_batch_.push_back(received);
+
+  // libuv reports the datagrams read by one recvmmsg() call last to first,
+  // and flags all but the final callback.
+  if (flags & UV_UDP_MMSG_CHUNK)
+    return;
+
+  const size_t count = recv_batch_.size();
+  size_t total = 0;
+  for (const BatchedDatagram& datagram : recv_batch_)
+    total += datagram.length;
+
+  // Copy the whole batch into one Buffer of its exact size, so that the
+  // storage slots can be reused by the next read right away.
+  AllocatedBuffer data = env->AllocateManaged(total);
+  MaybeStackBuffer<Local<Value>, kMaxRecvBatchSize> rinfos(count);
+  size_t offset = 0;
+  for (size_t i = 0; i < count; i++) {
+    const BatchedDatagram& datagram = recv_batch_[count - 1 - i];
+    memcpy(data.data() + offset, datagram.data, datagram.length);
+    offset += datagram.length;
+
+    Local<Object> rinfo = AddressToJS(
+        env, reinterpret_cast<const sockaddr*>(&datagram.address));
+    rinfo->Set(env->context(),
+               env->size_string(),
+               Integer::NewFromUnsigned(env->isolate(), datagram.length))
+        .Check();
+    rinfos[i] = rinfo;
+  }
+  recv_batch_.clear();
+
+  Local<Value> argv[] = {
+    Integer::NewFromUnsigned(env->isolate(), count),
+    object(),
+    data.ToBuffer().ToLocalChecked(),
+    Array::New(env->isolate(), *rinfos, count)
+  };
+  MakeCallback(env->onmessagebatch_string(), arraysize(argv), argv);
+}
+
+void UDPWrap::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize(
+      "recv_batch_storage",
+      recv_batch_storage_ ? recv_batch_size_ * kMaxDatagramSize : 0);
+}
+
 MaybeLocal<Object> UDPWrap::Instantiate(Environment* env,
                                         AsyncWrap* parent,
                                         UDPWrap::SocketType type) {
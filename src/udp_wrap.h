@@ -30,6 +30,9 @@
 #include "uv.h"
 #include "v8.h"
 
+#include <memory>
+#include <vector>
+
 namespace node {
 
 class UDPWrapBase;
@@ -150,6 +153,11 @@ class UDPWrap final : public HandleWrap,
   static void SetBroadcast(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetTTL(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void BufferSize(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetSocketOption(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetSocketOption(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetRecvBatchSize(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch6(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   // UDPListener implementation
   uv_buf_t OnAlloc(size_t suggested_size) override;
@@ -175,13 +183,26 @@ class UDPWrap final : public HandleWrap,
   static v8::MaybeLocal<v8::Object> Instantiate(Environment* env,
                                                 AsyncWrap* parent,
                                                 SocketType type);
-  SET_NO_MEMORY_INFO()
+  void MemoryInfo(MemoryTracker* tracker) const override;
   SET_MEMORY_INFO_NAME(UDPWrap)
   SET_SELF_SIZE(UDPWrap)
 
+  // Largest datagram that libuv reads into a single slot of the receive
+  // buffer, and the most slots it fills with one recvmmsg() call.
+  static constexpr size_t kMaxDatagramSize = 64 * 1024;
+  static constexpr size_t kMaxRecvBatchSize = 20;
+
  private:
   typedef uv_udp_t HandleType;
 
+  // A datagram read by recvmmsg() that has not been passed to JS yet. |data|
+  // points into recv_batch_storage_.
+  struct BatchedDatagram {
+    const char* data;
+    size_t length;
+    sockaddr_storage address;
+  };
+
   template <typename T,
             int (*F)(const typename T::HandleType*, sockaddr*, int*)>
   friend void GetSockOrPeerName(const v8::FunctionCallbackInfo<v8::Value>&);
@@ -194,6 +215,13 @@ class UDPWrap final : public HandleWrap,
                      int family);
   static void DoSend(const v8::FunctionCallbackInfo<v8::Value>& args,
                      int family);
+  static void DoSendBatch(const v8::FunctionCallbackInfo<v8::Value>& args,
+                          int family);
+  ssize_t TrySendBatch(uv_buf_t* bufs, size_t count, const sockaddr* addr);
+  void OnRecvBatch(ssize_t nread,
+                   const uv_buf_t& buf,
+                   const sockaddr* addr,
+                   unsigned int flags);
   static void SetMembership(const v8::FunctionCallbackInfo<v8::Value>& args,
                             uv_membership membership);
   static void SetSourceMembership(
@@ -213,6 +241,10 @@ class UDPWrap final : public HandleWrap,
 
   bool current_send_has_callback_;
   v8::Local<v8::Object> current_send_req_wrap_;
+
+  size_t recv_batch_size_ = 0;
+  std::unique_ptr<char[]> recv_batch_storage_;
+  std::vector<BatchedDatagram> recv_batch_;
 };
 
 }  // namespace node
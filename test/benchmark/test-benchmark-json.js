@@ -0,0 +1,7 @@
+'use strict';
+
+require('../common');
+
+const runBenchmark = require('../common/benchmark');
+
+runBenchmark('json', { NODEJS_BENCHMARK_ZERO_ALLOWED: 1 });
@@ -0,0 +1,83 @@
+#include "node_internals.h"
+#include "gtest/gtest.h"
+
+using node::NodeArrayBufferAllocator;
+using node::SmallBufferPool;
+
+TEST(SmallBufferPoolTest, SizeClasses) {
+  EXPECT_FALSE(SmallBufferPool::IsPooledSize(0));
+  EXPECT_TRUE(SmallBufferPool::IsPooledSize(1));
+  EXPECT_TRUE(SmallBufferPool::IsPooledSize(64 * 1024));
+  EXPECT_FALSE(SmallBufferPool::IsPooledSize(64 * 1024 + 1));
+
+  EXPECT_EQ(SmallBufferPool::RoundUp(1), 64u);
+  EXPECT_EQ(SmallBufferPool::RoundUp(64), 64u);
+  EXPECT_EQ(SmallBufferPool::RoundUp(65), 128u);
+  EXPECT_EQ(SmallBufferPool::RoundUp(4000), 4096u);
+  EXPECT_EQ(SmallBufferPool::RoundUp(64 * 1024), 64u * 1024);
+}
+
+TEST(SmallBufferPoolTest, GetAndPut) {
+  SmallBufferPool pool;
+  EXPECT_EQ(pool.Get(100), nullptr);
+
+  void* block = malloc(SmallBufferPool::RoundUp(100));
+  EXPECT_TRUE(pool.Put(block, 100));
+  EXPECT_EQ(pool.cached_bytes(), 128u);
+
+  // Different size class.
+  EXPECT_EQ(pool.Get(200), nullptr);
+  // Same size class.
+  EXPECT_EQ(pool.Get(128), block);
+  EXPECT_EQ(pool.cached_bytes(), 0u);
+  EXPECT_EQ(pool.Get(128), nullptr);
+  free(block);
+}
+
+TEST(SmallBufferPoolTest, BoundedSizeClasses) {
+  SmallBufferPool pool;
+  for (size_t i = 0; i < SmallBufferPool::kMaxBlocksPerClass; i++)
+    EXPECT_TRUE(pool.Put(malloc(64), 64));
+  void* extra = malloc(64);
+  EXPECT_FALSE(pool.Put(extra, 64));
+  free(extra);
+  EXPECT_EQ(pool.cached_bytes(), 64u * SmallBufferPool::kMaxBlocksPerClass);
+  pool.Clear();
+  EXPECT_EQ(pool.cached_bytes(), 0u);
+}
+
+TEST(SmallBufferPoolTest, AllocatorRecyclesSmallBlocks) {
+  SmallBufferPool* pool = SmallBufferPool::ForCurrentThread();
+  ASSERT_NE(pool, nullptr);
+  pool->Clear();
+
+  NodeArrayBufferAllocator allocator;
+  void* first = allocator.AllocateUninitialized(1000);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(allocator.total_mem_usage(), 1000u);
+  allocator.Free(first, 1000);
+  EXPECT_EQ(allocator.total_mem_usage(), 0u);
+  EXPECT_EQ(pool->cached_bytes(), 1024u);
+
+  // A request from the same size class reuses the block, and zero-filling
+  // allocations still return zeroed memory.
+  *allocator.zero_fill_field() = 1;
+  char* second = static_cast<char*>(allocator.Allocate(1020));
+  EXPECT_EQ(second, first);
+  EXPECT_EQ(pool->cached_bytes(), 0u);
+  for (size_t i = 0; i < 1020; i++)
+    EXPECT_EQ(second[i], 0);
+
+  // Reallocation keeps the block recyclable.
+  second = static_cast<char*>(allocator.Reallocate(second, 1020, 10));
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(allocator.total_mem_usage(), 10u);
+  allocator.Free(second, 10);
+  EXPECT_EQ(pool->cached_bytes(), 64u);
+
+  // Large blocks bypass the pool.
+  void* large = allocator.AllocateUninitialized(1024 * 1024);
+  allocator.Free(large, 1024 * 1024);
+  EXPECT_EQ(pool->cached_bytes(), 64u);
+  pool->Clear();
+}
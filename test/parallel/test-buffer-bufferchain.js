@@ -0,0 +1,108 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { BufferChain } = require('buffer');
+const net = require('net');
+const { Writable } = require('stream');
+
+{
+  const list = new BufferChain();
+  assert.strictEqual(list.length, 0);
+  assert.deepStrictEqual(list.toArray(), []);
+  assert.deepStrictEqual(list.toBuffer(), Buffer.alloc(0));
+
+  const a = Buffer.from('abc');
+  const b = new Uint8Array([0x64, 0x65]);
+  assert.strictEqual(list.append(a).append(b), list);
+  assert.strictEqual(list.length, 5);
+  assert.deepStrictEqual(list.toArray(), [a, b]);
+  assert.strictEqual(list.toArray()[0], a);
+  assert.deepStrictEqual(list.toBuffer(), Buffer.from('abcde'));
+
+  // toArray() returns a copy.
+  list.toArray().pop();
+  assert.strictEqual(list.toArray().length, 2);
+}
+
+{
+  const list = new BufferChain([Buffer.from('x'), Buffer.from('yz')]);
+  assert.strictEqual(list.length, 3);
+  assert.deepStrictEqual(list.toBuffer(), Buffer.from('xyz'));
+}
+
+[null, 'abc', 1, {}].forEach((value) => {
+  assert.throws(() => new BufferChain().append(value), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    name: 'TypeError'
+  });
+});
+
+assert.throws(() => new BufferChain('abc'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  name: 'TypeError'
+});
+
+// Streams that implement _writev() receive all chunks in a single call.
+{
+  const chunks = [Buffer.from('a'), Buffer.from('b'), Buffer.from('c')];
+  const writable = new Writable({
+    write: common.mustNotCall(),
+    writev: common.mustCall((data, cb) => {
+      assert.strictEqual(data.length, 3);
+      for (let i = 0; i < 3; i++)
+        assert.strictEqual(data[i].chunk, chunks[i]);
+      cb();
+    })
+  });
+  writable.write(new BufferChain(chunks), common.mustCall());
+}
+
+// Streams that only implement _write() receive the chunks one by one.
+{
+  const received = [];
+  const writable = new Writable({
+    write: common.mustCall((chunk, encoding, cb) => {
+      received.push(chunk);
+      cb();
+    }, 2)
+  });
+  writable.write(new BufferChain([Buffer.from('a'), Buffer.from('b')]));
+  writable.end(common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(received), Buffer.from('ab'));
+  }));
+}
+
+// In object mode, a BufferChain is an ordinary object.
+{
+  const list = new BufferChain([Buffer.from('a')]);
+  const writable = new Writable({
+    objectMode: true,
+    write: common.mustCall((chunk, encoding, cb) => {
+      assert.strictEqual(chunk, list);
+      cb();
+    })
+  });
+  writable.write(list);
+}
+
+// Sockets hand the chunks to the native writev() without flattening them.
+{
+  const server = net.createServer(common.mustCall((socket) => {
+    const received = [];
+    socket.on('data', (chunk) => received.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      assert.strictEqual(Buffer.concat(received).toString(), 'hello world');
+      server.close();
+    }));
+  }));
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port, common.mustCall(() => {
+      const list = new BufferChain([
+        Buffer.from('hello'),
+        Buffer.from(' '),
+        Buffer.from('world')
+      ]);
+      client.end(list);
+    }));
+  }));
+}
@@ -98,3 +98,22 @@ assert.deepStrictEqual(
 assert.deepStrictEqual(Buffer.concat([new Uint8Array([0x41, 0x42]),
                                       new Uint8Array([0x43, 0x44])]),
                        Buffer.from('ABCD'));
+
+// Many small chunks are copied in order.
+{
+  const chunks = [];
+  for (let i = 0; i < 1000; i++) chunks.push(Buffer.from([i & 0xff]));
+  const flat = Buffer.concat(chunks);
+  assert.strictEqual(flat.length, 1000);
+  for (let i = 0; i < 1000; i++) assert.strictEqual(flat[i], i & 0xff);
+}
+
+// Holes are reported like any other invalid element.
+assert.throws(() => {
+  // eslint-disable-next-line no-sparse-arrays
+  Buffer.concat([Buffer.from('hello'), , Buffer.from('world')]);
+}, {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: 'The "list[1]" argument must be an instance of Buffer ' +
+           'or Uint8Array. Received undefined'
+});
@@ -413,3 +413,24 @@ assert.throws(() => {
   code: 'ERR_INVALID_ARG_VALUE',
   name: 'TypeError'
 });
+
+// Fills larger than the internal block size keep the pattern intact, including
+// across block boundaries and for patterns that do not divide the block size.
+const patterns = ['abc', 'abcdefg', 'aaaa', 'Љa', 'x'.repeat(20000) + 'y'];
+for (const pattern of patterns) {
+  for (const size of [1000, 16 * 1024 + 5, 100 * 1024 + 3]) {
+    const buf = Buffer.allocUnsafe(size).fill(pattern);
+    const expected = Buffer.from(pattern.repeat(
+      Math.ceil(size / Buffer.byteLength(pattern)) + 1)).slice(0, size);
+    assert.ok(buf.equals(expected), `pattern of length ${pattern.length}`);
+  }
+}
+
+{
+  const buf = Buffer.alloc(64 * 1024 + 7);
+  buf.fill(Buffer.from([1, 2, 3]), 5, buf.length - 1);
+  assert.strictEqual(buf[4], 0);
+  assert.strictEqual(buf[buf.length - 1], 0);
+  for (let i = 5; i < buf.length - 1; i++)
+    assert.strictEqual(buf[i], (i - 5) % 3 + 1);
+}
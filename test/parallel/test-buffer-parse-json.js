@@ -0,0 +1,131 @@
+'use strict';
+
+require('../common');
+const assert = require('assert');
+const { parseJSON } = require('buffer');
+
+// Results must match JSON.parse() of the decoded text.
+[
+  '0',
+  '-0',
+  '1',
+  '-123456789012345',
+  '1234567890123456789',
+  '0.1',
+  '-0.000001',
+  '3.141592653589793',
+  '1e3',
+  '1E-7',
+  '2.5e+300',
+  '0.00000000000000000000000001',
+  '123456789.123456789',
+  'true',
+  'false',
+  'null',
+  '""',
+  '"plain ascii that is longer than a single eight byte word"',
+  '"café ☃ 😀"',
+  '"esc\\"aped\\\\ \\/ \\b\\f\\n\\r\\t"',
+  '"\\u0041\\u00e9\\u2603\\ud83d\\ude00"',
+  '"lone \\ud800 surrogate"',
+  '[]',
+  '{}',
+  ' \t\r\n[ 1 , "two" , { "three" : [ 3 ] } , null ] \n',
+  '{"a":1,"b":{"c":[true,false,null]},"a":2}',
+  '{"__proto__":{"polluted":true},"0":"zero","":"empty"}',
+  JSON.stringify(Array.from({ length: 100 }, (_, i) => ({
+    id: i,
+    name: `item ${i}`,
+    score: i / 8,
+    tags: ['x', 'y\n', 'zü'],
+  }))),
+].forEach((text) => {
+  const expected = JSON.parse(text);
+  assert.deepStrictEqual(parseJSON(Buffer.from(text)), expected, text);
+  assert.deepStrictEqual(
+    parseJSON(Buffer.from(text), { lazyStringThreshold: 0 }), expected, text);
+});
+
+// -0 is preserved.
+assert(Object.is(parseJSON(Buffer.from('-0')), -0));
+assert(Object.is(parseJSON(Buffer.from('-0.0')), -0));
+
+// __proto__ becomes an own property, as with JSON.parse().
+{
+  const obj = parseJSON(Buffer.from('{"__proto__":{"polluted":true}}'));
+  assert.strictEqual(Object.getPrototypeOf(obj), Object.prototype);
+  assert.deepStrictEqual(Object.keys(obj), ['__proto__']);
+  assert.strictEqual({}.polluted, undefined);
+}
+
+// Other views are read as raw bytes.
+{
+  const bytes = Buffer.from('{"x":[1,2]}');
+  const u8 = new Uint8Array(bytes.buffer, bytes.byteOffset, bytes.length);
+  assert.deepStrictEqual(parseJSON(u8), { x: [1, 2] });
+  const dv = new DataView(bytes.buffer, bytes.byteOffset, bytes.length);
+  assert.deepStrictEqual(parseJSON(dv), { x: [1, 2] });
+}
+
+// Lazily materialized strings do not observe later changes to the source.
+{
+  const value = 'a'.repeat(1024);
+  const source = Buffer.from(JSON.stringify({ value, short: 'b' }));
+  const obj = parseJSON(source, { lazyStringThreshold: 16 });
+  source.fill('z');
+  assert.strictEqual(obj.value, value);
+  assert.strictEqual(obj.short, 'b');
+}
+
+// Invalid UTF-8 is replaced the same way buf.toString() does it.
+{
+  const source = Buffer.from([0x22, 0x61, 0xff, 0x62, 0x22]);
+  assert.strictEqual(parseJSON(source), JSON.parse(source.toString()));
+}
+
+// Syntax errors report the byte offset of the offending input.
+[
+  ['', 'Unexpected end of JSON input'],
+  ['   ', 'Unexpected end of JSON input'],
+  ['[1,2', 'Unexpected end of JSON input'],
+  ['"abc', 'Unexpected end of JSON input'],
+  ['{"a" 1}', 'Unexpected token 1 in JSON at position 5'],
+  ['[1,]', 'Unexpected token ] in JSON at position 3'],
+  ['{"a":1,}', 'Unexpected token } in JSON at position 7'],
+  ['{a:1}', 'Unexpected token a in JSON at position 1'],
+  ['01', 'Unexpected token 1 in JSON at position 1'],
+  ['1.', 'Unexpected end of JSON input'],
+  ['1.e5', 'Unexpected token e in JSON at position 2'],
+  ['-', 'Unexpected end of JSON input'],
+  ['+1', 'Unexpected token + in JSON at position 0'],
+  ['tru', 'Unexpected end of JSON input'],
+  ['nul!', 'Unexpected token ! in JSON at position 3'],
+  ['"\\x"', 'Unexpected token x in JSON at position 2'],
+  ['"\\u12g4"', 'Unexpected token g in JSON at position 5'],
+  ['"a\tb"', 'Unexpected byte 0x09 in JSON at position 2'],
+  ['1 2', 'Unexpected token 2 in JSON at position 2'],
+  ['\ufeff{}', 'Unexpected byte 0xef in JSON at position 0'],
+].forEach(([text, message]) => {
+  assert.throws(() => parseJSON(Buffer.from(text)), {
+    name: 'SyntaxError',
+    message
+  }, text);
+});
+
+assert.throws(() => parseJSON(Buffer.from('['.repeat(1e4))), {
+  code: 'ERR_OUT_OF_RANGE',
+  name: 'RangeError'
+});
+
+[undefined, null, 'string', 1, {}, [], new ArrayBuffer(1)].forEach((source) => {
+  assert.throws(() => parseJSON(source), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    name: 'TypeError'
+  });
+});
+
+[-1, 1.5, '1', null].forEach((lazyStringThreshold) => {
+  assert.throws(() => parseJSON(Buffer.from('1'), { lazyStringThreshold }), {
+    code: /^ERR_(OUT_OF_RANGE|INVALID_ARG_TYPE)$/
+  });
+});
@@ -0,0 +1,67 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const { sortKeys } = require('buffer');
+
+// Variable-length keys.
+{
+  const source = Buffer.from('pearfigapplefi');
+  const offsets = new Uint32Array([0, 4, 7, 12]);
+  const lengths = new Uint32Array([4, 3, 5, 2]);
+  assert.deepStrictEqual(sortKeys(source, offsets, lengths),
+                         new Uint32Array([2, 3, 1, 0]));
+}
+
+// Fixed-length keys, compared against a JS comparator.
+{
+  const keyLength = 8;
+  const count = 1000;
+  const source = Buffer.allocUnsafe(keyLength * count);
+  for (let i = 0; i < source.length; i++)
+    source[i] = (i * 7919 + (i >> 3) * 104729) & 0x3;
+  const offsets = new Uint32Array(count);
+  for (let i = 0; i < count; i++) offsets[i] = i * keyLength;
+
+  const expected = Array.from({ length: count }, (_, i) => i).sort((a, b) => {
+    return Buffer.compare(
+      source.subarray(offsets[a], offsets[a] + keyLength),
+      source.subarray(offsets[b], offsets[b] + keyLength)) || a - b;
+  });
+  assert.deepStrictEqual(Array.from(sortKeys(source, offsets, keyLength)),
+                         expected);
+}
+
+// Equal keys keep their relative order.
+{
+  const source = Buffer.from('bbaabbaa');
+  const offsets = new Uint32Array([0, 2, 4, 6]);
+  assert.deepStrictEqual(sortKeys(source, offsets, 2),
+                         new Uint32Array([1, 3, 0, 2]));
+}
+
+assert.deepStrictEqual(sortKeys(Buffer.alloc(0), new Uint32Array(0), 0),
+                       new Uint32Array(0));
+
+assert.throws(() => sortKeys(Buffer.alloc(4), new Uint32Array([0, 2]), 3), {
+  code: 'ERR_BUFFER_OUT_OF_BOUNDS',
+  name: 'RangeError',
+  message: '"offsets[1]" is outside of buffer bounds'
+});
+
+assert.throws(() => sortKeys('abc', new Uint32Array(0), 0), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => sortKeys(Buffer.alloc(4), [0], 1), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => sortKeys(Buffer.alloc(4), new Uint32Array(1), '1'), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => sortKeys(Buffer.alloc(4), new Uint32Array(1), -1), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => {
+  sortKeys(Buffer.alloc(4), new Uint32Array(2), new Uint32Array(1));
+}, {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
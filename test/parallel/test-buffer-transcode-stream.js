@@ -0,0 +1,87 @@
+'use strict';
+const common = require('../common');
+
+if (!common.hasIntl)
+  common.skip('missing Intl');
+
+const assert = require('assert');
+const { createTranscodeStream, transcode } = require('buffer');
+
+function convert(chunks, from, to, options) {
+  return new Promise((resolve, reject) => {
+    const stream = createTranscodeStream(from, to, options);
+    const output = [];
+    stream.on('data', (chunk) => output.push(chunk));
+    stream.on('end', () => resolve(Buffer.concat(output)));
+    stream.on('error', reject);
+    for (const chunk of chunks)
+      stream.write(chunk);
+    stream.end();
+  });
+}
+
+function splitEvery(buf, size) {
+  const chunks = [];
+  for (let i = 0; i < buf.length; i += size)
+    chunks.push(buf.slice(i, i + size));
+  return chunks;
+}
+
+const text = 'Grüße aus Köln, €100 – 𝄞 ok';
+
+(async () => {
+  // Multi-byte sequences split across chunks at every possible position.
+  const utf8 = Buffer.from(text, 'utf8');
+  const utf16le = Buffer.from(text, 'utf16le');
+  for (const size of [1, 2, 3, 5, 1024]) {
+    assert.deepStrictEqual(
+      await convert(splitEvery(utf8, size), 'utf8', 'utf16le'), utf16le);
+    assert.deepStrictEqual(
+      await convert(splitEvery(utf16le, size), 'ucs2', 'utf-8'), utf8);
+  }
+
+  // Latin-1 fast paths.
+  const latin1 = Buffer.from('Grüße, ¿qué tal? ÿ', 'latin1');
+  assert.deepStrictEqual(
+    await convert(splitEvery(latin1, 3), 'latin1', 'utf8'),
+    Buffer.from(latin1.toString('latin1'), 'utf8'));
+  assert.deepStrictEqual(
+    await convert(splitEvery(latin1, 3), 'binary', 'utf16le'),
+    Buffer.from(latin1.toString('latin1'), 'utf16le'));
+
+  // Same results as the one-shot transcode(), including substitutions.
+  assert.deepStrictEqual(await convert([utf8], 'utf8', 'latin1'),
+                         transcode(utf8, 'utf8', 'latin1'));
+  assert.deepStrictEqual(await convert([utf8], 'utf8', 'ascii'),
+                         transcode(utf8, 'utf8', 'ascii'));
+
+  // Empty input.
+  assert.deepStrictEqual(await convert([], 'utf8', 'utf16le'),
+                         Buffer.alloc(0));
+
+  // A truncated sequence at the end of the stream is substituted...
+  assert.deepStrictEqual(
+    await convert([Buffer.from([0x61, 0xe2, 0x82])], 'utf8', 'utf16le'),
+    Buffer.from('a�', 'utf16le'));
+  // ...or reported in fatal mode.
+  await assert.rejects(
+    convert([Buffer.from([0x61, 0xff])], 'utf8', 'utf16le', { fatal: true }),
+    { code: 'U_ILLEGAL_CHAR_FOUND' });
+  await assert.rejects(
+    convert([Buffer.from('€')], 'utf8', 'latin1', { fatal: true }),
+    { code: 'U_INVALID_CHAR_FOUND' });
+})().then(common.mustCall());
+
+assert.throws(() => createTranscodeStream('utf8', 'not-an-encoding'), {
+  code: 'ERR_ENCODING_NOT_SUPPORTED',
+  name: 'RangeError'
+});
+assert.throws(() => createTranscodeStream('hex', 'utf8'), {
+  code: 'ERR_ENCODING_NOT_SUPPORTED'
+});
+assert.throws(() => createTranscodeStream(1, 'utf8'), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => createTranscodeStream('utf8', 'latin1', 'fatal'), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
@@ -0,0 +1,63 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+const messages = Array.from({ length: 50 }, (_, i) => `datagram ${i}`);
+
+{
+  // Batches are delivered through 'messages' when it has listeners.
+  const server = dgram.createSocket({ type: 'udp4', recvBatchSize: 8 });
+  const client = dgram.createSocket('udp4');
+  const received = [];
+
+  server.on('message', common.mustNotCall());
+  server.on('messages', common.mustCallAtLeast((msgs, rinfos) => {
+    assert(Array.isArray(msgs));
+    assert.strictEqual(msgs.length, rinfos.length);
+    assert(msgs.length >= 1 && msgs.length <= 8);
+    for (let i = 0; i < msgs.length; i++) {
+      assert(Buffer.isBuffer(msgs[i]));
+      assert.strictEqual(rinfos[i].size, msgs[i].length);
+      assert.strictEqual(rinfos[i].address, '127.0.0.1');
+      assert.strictEqual(rinfos[i].port, client.address().port);
+      received.push(msgs[i].toString());
+    }
+    if (received.length === messages.length) {
+      assert.deepStrictEqual(received, messages);
+      server.close();
+      client.close();
+    }
+  }));
+
+  server.bind(0, '127.0.0.1', common.mustCall(() => {
+    client.sendBatch(messages, server.address().port, '127.0.0.1');
+  }));
+}
+
+{
+  // Without a 'messages' listener, each datagram is emitted as 'message'.
+  const server = dgram.createSocket({ type: 'udp4', recvBatchSize: 20 });
+  const client = dgram.createSocket('udp4');
+  const received = [];
+
+  server.on('message', common.mustCall((msg, rinfo) => {
+    assert.strictEqual(rinfo.size, msg.length);
+    received.push(msg.toString());
+    if (received.length === messages.length) {
+      assert.deepStrictEqual(received, messages);
+      server.close();
+      client.close();
+    }
+  }, messages.length));
+
+  server.bind(0, '127.0.0.1', common.mustCall(() => {
+    client.sendBatch(messages, server.address().port, '127.0.0.1');
+  }));
+}
+
+[0, 21, 1.5, '8', null].forEach((recvBatchSize) => {
+  assert.throws(() => dgram.createSocket({ type: 'udp4', recvBatchSize }), {
+    code: /^ERR_(OUT_OF_RANGE|INVALID_ARG_TYPE)$/
+  });
+});
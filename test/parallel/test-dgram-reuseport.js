@@ -0,0 +1,50 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+if (common.isWindows) {
+  const socket = dgram.createSocket({ type: 'udp4', reusePort: true });
+  socket.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOTSUP');
+    socket.close();
+  }));
+  socket.bind(0, common.localhostIPv4, common.mustNotCall());
+  return;
+}
+
+// Several sockets can be bound to the same port when all of them set
+// `reusePort`, and between them they receive every datagram.
+const kDatagrams = 30;
+const first = dgram.createSocket({ type: 'udp4', reusePort: true });
+const second = dgram.createSocket({ type: 'udp4', reusePort: true });
+const client = dgram.createSocket('udp4');
+let received = 0;
+
+function onMessage() {
+  if (++received === kDatagrams) {
+    first.close();
+    second.close();
+    client.close();
+  }
+}
+first.on('message', onMessage);
+second.on('message', onMessage);
+
+first.bind(0, common.localhostIPv4, common.mustCall(() => {
+  const { port } = first.address();
+
+  // A socket without `reusePort` still cannot share the port.
+  const other = dgram.createSocket('udp4');
+  other.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'EADDRINUSE');
+    other.close();
+  }));
+  other.bind(port, common.localhostIPv4, common.mustNotCall());
+
+  second.bind(port, common.localhostIPv4, common.mustCall(() => {
+    assert.strictEqual(second.address().port, port);
+    for (let i = 0; i < kDatagrams; i++)
+      client.send(`datagram ${i}`, port, common.localhostIPv4);
+  }));
+}));
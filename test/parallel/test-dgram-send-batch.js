@@ -0,0 +1,83 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+const messages = Array.from({ length: 100 }, (_, i) => `message ${i}`);
+
+{
+  // Every element of the list is sent as a datagram of its own, in order.
+  const server = dgram.createSocket('udp4');
+  const client = dgram.createSocket('udp4');
+  const received = [];
+
+  server.on('message', common.mustCall((msg, rinfo) => {
+    assert.strictEqual(rinfo.size, msg.length);
+    received.push(msg.toString());
+    if (received.length === messages.length) {
+      assert.deepStrictEqual(received, messages);
+      server.close();
+      client.close();
+    }
+  }, messages.length));
+
+  server.bind(0, common.mustCall(() => {
+    const { port } = server.address();
+    client.sendBatch(messages, port, '127.0.0.1',
+                     common.mustCall((err, sent) => {
+                       assert.ifError(err);
+                       assert.strictEqual(sent, messages.length);
+                     }));
+  }));
+}
+
+{
+  // Connected sockets, mixed message types and empty datagrams.
+  const server = dgram.createSocket('udp4');
+  const client = dgram.createSocket('udp4');
+  const list = ['a', Buffer.from('bc'), new Uint8Array([100]), ''];
+  const received = [];
+
+  server.on('message', common.mustCall((msg) => {
+    received.push(msg.toString());
+    if (received.length === list.length) {
+      assert.deepStrictEqual(received, ['a', 'bc', 'd', '']);
+      server.close();
+      client.close();
+    }
+  }, list.length));
+
+  server.bind(0, common.mustCall(() => {
+    client.connect(server.address().port, common.mustCall(() => {
+      assert.throws(() => client.sendBatch(list, 1234), {
+        code: 'ERR_SOCKET_DGRAM_IS_CONNECTED'
+      });
+      client.sendBatch(list, common.mustCall((err, sent) => {
+        assert.ifError(err);
+        assert.strictEqual(sent, list.length);
+      }));
+    }));
+  }));
+}
+
+{
+  const socket = dgram.createSocket('udp4');
+
+  socket.sendBatch([], common.PORT, common.mustCall((err, sent) => {
+    assert.ifError(err);
+    assert.strictEqual(sent, 0);
+    socket.close();
+  }));
+
+  [null, 'string', Buffer.alloc(1), [1], [{}]].forEach((list) => {
+    assert.throws(() => socket.sendBatch(list, common.PORT), {
+      code: 'ERR_INVALID_ARG_TYPE'
+    });
+  });
+  assert.throws(() => socket.sendBatch(['a'], 0), {
+    code: 'ERR_SOCKET_BAD_PORT'
+  });
+  assert.throws(() => socket.sendBatch(['a'], common.PORT, 42), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
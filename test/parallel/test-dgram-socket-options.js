@@ -0,0 +1,32 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+const socket = dgram.createSocket('udp4');
+
+// The socket is created when it is bound.
+assert.throws(() => socket.setSocketOption('SO_BUSY_POLL', 0), {
+  code: common.isLinux ? 'EBADF' : 'ENOTSUP'
+});
+// TCP options do not apply to UDP sockets.
+assert.throws(() => socket.setSocketOption('TCP_NOTSENT_LOWAT', 1), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+assert.throws(() => socket.setSocketOption('SO_BUSY_POLL', '1'), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+socket.bind(0, common.localhostIPv4, common.mustCall(() => {
+  if (common.isLinux) {
+    // Raising SO_BUSY_POLL may require privileges; lowering it does not.
+    assert.strictEqual(socket.setSocketOption('SO_BUSY_POLL', 0), socket);
+    assert.strictEqual(socket.getSocketOption('SO_BUSY_POLL'), 0);
+  } else {
+    assert.throws(() => socket.getSocketOption('SO_BUSY_POLL'), {
+      code: 'ENOTSUP'
+    });
+  }
+  socket.close();
+}));
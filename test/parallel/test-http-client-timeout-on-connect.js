@@ -1,11 +1,12 @@
-// Flags: --expose-internals
-
 'use strict';
 
 const common = require('../common');
 const assert = require('assert');
 const http = require('http');
-const { kTimeout } = require('internal/timers');
+
+// The timeout set with req.setTimeout() before the socket is connected is
+// applied to the socket once it connects, fires once, and does not fire
+// again after the request has been aborted.
 
 const server = http.createServer((req, res) => {
   // This space is intentionally left blank.
@@ -14,17 +15,21 @@ const server = http.createServer((req, res) => {
 server.listen(0, common.localhostIPv4, common.mustCall(() => {
   const port = server.address().port;
   const req = http.get(`http://${common.localhostIPv4}:${port}`);
+  let connected = false;
 
   req.setTimeout(1);
   req.on('socket', common.mustCall((socket) => {
-    assert.strictEqual(socket[kTimeout], null);
     socket.on('connect', common.mustCall(() => {
-      assert.strictEqual(socket[kTimeout]._idleTimeout, 1);
+      connected = true;
     }));
+    socket.on('timeout', common.mustCall());
+  }));
+  req.on('timeout', common.mustCall(() => {
+    assert.strictEqual(connected, true);
+    req.abort();
   }));
-  req.on('timeout', common.mustCall(() => req.abort()));
   req.on('error', common.mustCall((err) => {
     assert.strictEqual(err.message, 'socket hang up');
-    server.close();
+    setTimeout(() => server.close(), common.platformTimeout(50));
   }));
 }));
@@ -0,0 +1,224 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// Sends `request` over a raw connection and returns what the server sent
+// until it closed the connection.
+function rawRequest(port, request, cb) {
+  const socket = net.connect(port, common.mustCall(() => {
+    socket.write(request);
+  }));
+  let response = '';
+  socket.setEncoding('latin1');
+  socket.on('data', (chunk) => response += chunk);
+  socket.on('close', common.mustCall(() => cb(response)));
+}
+
+function withoutDate(response) {
+  return response.replace(/Date: [^\r]*\r\n/g, '');
+}
+
+// Requests and responses through the http client.
+{
+  const server = http.createFastServer(common.mustCall((req, res) => {
+    assert.strictEqual(req.httpVersion, '1.1');
+    assert.strictEqual(req.getHeader('X-Test'), 'yes');
+    assert.strictEqual(req.headers['x-test'], 'yes');
+    if (req.method === 'POST') {
+      assert.strictEqual(req.url, '/post');
+      assert.strictEqual(req.body.toString(), 'hello world');
+    } else {
+      assert.strictEqual(req.url, '/get?x=1');
+      assert.strictEqual(req.body, null);
+    }
+    assert.throws(() => res.setHeader('Transfer-Encoding', 'chunked'), {
+      code: 'ERR_HTTP_INVALID_HEADER_VALUE'
+    });
+    assert.throws(() => res.setHeader('X-Foo', 'a\nb'), {
+      code: 'ERR_INVALID_CHAR'
+    });
+    res.setHeader('X-Method', req.method);
+    res.setHeader('Set-Cookie', ['a=1', 'b=2']);
+    res.end(req.method === 'POST' ? req.body : 'ok');
+    assert.throws(() => res.setHeader('X-Late', '1'), {
+      code: 'ERR_HTTP_HEADERS_SENT'
+    });
+  }, 2));
+
+  server.listen(0, common.mustCall(() => {
+    const agent = new http.Agent({ keepAlive: true, maxSockets: 1 });
+    const options = {
+      port: server.address().port,
+      agent,
+      headers: { 'X-Test': 'yes' }
+    };
+    http.get({ ...options, path: '/get?x=1' }, common.mustCall((res) => {
+      assert.strictEqual(res.statusCode, 200);
+      assert.strictEqual(res.headers['x-method'], 'GET');
+      assert.strictEqual(res.headers['content-length'], '2');
+      assert.strictEqual(res.headers.connection, 'keep-alive');
+      assert.deepStrictEqual(res.headers['set-cookie'], ['a=1', 'b=2']);
+      assert.ok(res.headers.date);
+      res.setEncoding('utf8');
+      let body = '';
+      res.on('data', (chunk) => body += chunk);
+      res.on('end', common.mustCall(() => {
+        assert.strictEqual(body, 'ok');
+        const req = http.request({ ...options, method: 'POST', path: '/post' },
+                                 common.mustCall((res) => {
+                                   assert.strictEqual(res.headers['x-method'],
+                                                      'POST');
+                                   res.resume();
+                                   res.on('end', common.mustCall(() => {
+                                     agent.destroy();
+                                     server.close();
+                                   }));
+                                 }));
+        req.write('hello ');
+        req.end('world');
+      }));
+    }));
+  }));
+}
+
+// Pipelined requests are answered in order even if the responses are not
+// ready in order.
+{
+  const server = http.createFastServer(common.mustCall((req, res) => {
+    const delay = req.url === '/1' ? 20 : 0;
+    setTimeout(() => {
+      res.statusCode = req.url === '/2' ? 204 : 200;
+      res.end(req.url);
+    }, delay);
+  }, 3));
+
+  server.listen(0, common.mustCall(() => {
+    rawRequest(server.address().port,
+               'GET /1 HTTP/1.1\r\nHost: a\r\n\r\n' +
+               'HEAD /2 HTTP/1.1\r\nHost: a\r\n\r\n' +
+               'GET /3 HTTP/1.1\r\nHost: a\r\nConnection: close\r\n\r\n',
+               common.mustCall((response) => {
+                 assert.strictEqual(withoutDate(response),
+                                    'HTTP/1.1 200 OK\r\n' +
+                                    'Connection: keep-alive\r\n' +
+                                    'Content-Length: 2\r\n\r\n/1' +
+                                    'HTTP/1.1 204 No Content\r\n' +
+                                    'Connection: keep-alive\r\n\r\n' +
+                                    'HTTP/1.1 200 OK\r\n' +
+                                    'Connection: close\r\n' +
+                                    'Content-Length: 2\r\n\r\n/3');
+                 server.close();
+               }));
+  }));
+}
+
+// Bodies larger than maxBodySize and upgrade requests are rejected.
+{
+  const server = http.createFastServer({ maxBodySize: 4 },
+                                       common.mustNotCall());
+  server.listen(0, common.mustCall(() => {
+    const { port } = server.address();
+    rawRequest(port,
+               'POST / HTTP/1.1\r\nHost: a\r\nContent-Length: 5\r\n\r\n12345',
+               common.mustCall((response) => {
+                 assert.ok(response.startsWith('HTTP/1.1 413 '), response);
+                 rawRequest(port,
+                            'GET / HTTP/1.1\r\nHost: a\r\n' +
+                            'Connection: Upgrade\r\nUpgrade: test\r\n\r\n',
+                            common.mustCall((response) => {
+                              assert.ok(response.startsWith('HTTP/1.1 400 '),
+                                        response);
+                              server.close();
+                            }));
+               }));
+  }));
+}
+
+// Requests that expect 100-continue get an interim response before their
+// body is read. Other expectations, and announced bodies that are too large,
+// are rejected without reading the body.
+{
+  const server = http.createFastServer({ maxBodySize: 8 },
+                                       common.mustCall((req, res) => {
+                                         res.end(req.body);
+                                       }));
+  server.listen(0, common.mustCall(() => {
+    const { port } = server.address();
+    const req = http.request({
+      port,
+      method: 'POST',
+      headers: { 'Expect': '100-continue', 'Content-Length': 5 }
+    }, common.mustCall((res) => {
+      let body = '';
+      res.setEncoding('utf8');
+      res.on('data', (chunk) => body += chunk);
+      res.on('end', common.mustCall(() => {
+        assert.strictEqual(body, 'hello');
+        rawRequest(port,
+                   'POST / HTTP/1.1\r\nHost: a\r\nExpect: other\r\n' +
+                   'Content-Length: 5\r\n\r\n',
+                   common.mustCall((response) => {
+                     assert.strictEqual(withoutDate(response),
+                                        'HTTP/1.1 417 Expectation Failed\r\n' +
+                                        'Connection: close\r\n' +
+                                        'Content-Length: 0\r\n\r\n');
+                     rawRequest(port,
+                                'POST / HTTP/1.1\r\nHost: a\r\n' +
+                                'Expect: 100-continue\r\n' +
+                                'Content-Length: 9\r\n\r\n',
+                                common.mustCall((response) => {
+                                  assert.ok(
+                                    response.startsWith('HTTP/1.1 413 '),
+                                    response);
+                                  server.close();
+                                }));
+                   }));
+      }));
+    }));
+    req.on('continue', common.mustCall(() => req.end('hello')));
+  }));
+}
+
+// The server stops reading while too many requests wait for a response.
+{
+  const kMaxPendingRequests = 32;
+  const kRequests = 40;
+  let pending = [];
+  let received = 0;
+  const server = http.createFastServer(common.mustCall((req, res) => {
+    received++;
+    if (received > kMaxPendingRequests) {
+      res.end();
+      return;
+    }
+    pending.push(res);
+    if (pending.length < kMaxPendingRequests)
+      return;
+    setTimeout(common.mustCall(() => {
+      assert.strictEqual(received, kMaxPendingRequests);
+      for (const res of pending)
+        res.end();
+      pending = [];
+    }), common.platformTimeout(50));
+  }, kRequests));
+
+  server.listen(0, common.mustCall(() => {
+    let request = '';
+    for (let i = 1; i < kRequests; i++)
+      request += 'GET / HTTP/1.1\r\nHost: a\r\n\r\n';
+    request += 'GET / HTTP/1.1\r\nHost: a\r\nConnection: close\r\n\r\n';
+    rawRequest(server.address().port, request,
+               common.mustCall((response) => {
+                 assert.strictEqual(response.split('HTTP/1.1 200 OK').length,
+                                    kRequests + 1);
+                 server.close();
+               }));
+  }));
+}
+
+assert.throws(() => http.createFastServer({ maxBodySize: -1 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
@@ -0,0 +1,152 @@
+// Flags: --expose-internals
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+const {
+  serializeHeaders,
+  kHeaderSourceEntries,
+  kHeaderSourceObject,
+  kHeaderConnection,
+  kHeaderConnectionClose,
+  kHeaderConnectionKeepAlive,
+  kHeaderTransferEncoding,
+  kHeaderChunked,
+  kHeaderContentLength,
+  kHeaderDate,
+  kHeaderExpect,
+  kHeaderTrailer
+} = internalBinding('http_parser');
+
+const flags = new Uint32Array(1);
+
+{
+  const lines = serializeHeaders({
+    'Content-Type': 'text/plain',
+    'content-length': 5,
+    'Set-Cookie': ['a=1', 'b=2'],
+    'Cookie': ['c=3', 'd=4'],
+    'X-Empty': ''
+  }, kHeaderSourceObject, flags);
+  assert.strictEqual(lines,
+                     'Content-Type: text/plain\r\n' +
+                     'content-length: 5\r\n' +
+                     'Set-Cookie: a=1\r\n' +
+                     'Set-Cookie: b=2\r\n' +
+                     'Cookie: c=3; d=4\r\n' +
+                     'X-Empty: \r\n');
+  assert.strictEqual(flags[0], kHeaderContentLength);
+}
+
+{
+  const lines = serializeHeaders([
+    ['Connection', 'keep-alive, Close'],
+    ['Connection', 'keep-alive'],
+    ['Transfer-Encoding', 'gzip, chunked'],
+    ['Date', 'now'],
+    ['Expect', '100-continue'],
+    ['Trailer', 'X-Sum']
+  ], kHeaderSourceEntries, flags);
+  assert.ok(lines.startsWith('Connection: keep-alive, Close\r\n'));
+  assert.strictEqual(flags[0],
+                     kHeaderConnection | kHeaderConnectionClose |
+                     kHeaderConnectionKeepAlive | kHeaderTransferEncoding |
+                     kHeaderChunked | kHeaderDate | kHeaderExpect |
+                     kHeaderTrailer);
+
+  serializeHeaders([['Connection', 'closed'], ['TE', 'chunked']],
+                   kHeaderSourceEntries, flags);
+  assert.strictEqual(flags[0], kHeaderConnection | kHeaderConnectionKeepAlive);
+}
+
+// Headers that the JS implementation rejects or has to coerce are left to it.
+for (const headers of [
+  { '': 'x' },
+  { 'a b': 'x' },
+  { 'X-Foo': 'a\r\nb' },
+  { 'X-Foo': 'Ā' },
+  { 'X-Foo': undefined },
+  { 'X-Foo': { toString() { return 'x'; } } },
+  { 'X-Foo': ['a', null] },
+  { 'a b': [] },
+]) {
+  assert.strictEqual(
+    serializeHeaders(headers, kHeaderSourceObject, flags), undefined);
+}
+assert.strictEqual(
+  serializeHeaders([null], kHeaderSourceEntries, flags), undefined);
+
+// Symbols are ignored like in the JS implementation.
+assert.strictEqual(
+  serializeHeaders({ [Symbol('x')]: 'a', 'X-Foo': 'b' },
+                   kHeaderSourceObject, flags),
+  'X-Foo: b\r\n');
+
+// Proxies and accessors are left to JS without being read, so that the code
+// behind them runs only once.
+{
+  const get = common.mustNotCall();
+  const proxyTarget = [['X-Foo', 'a']];
+  for (const [headers, source] of [
+    [new Proxy({ 'X-Foo': 'a' }, { get }), kHeaderSourceObject],
+    [new Proxy(proxyTarget, { get }), kHeaderSourceEntries],
+    [Object.defineProperty({}, 'X-Foo', { get, enumerable: true }),
+     kHeaderSourceObject],
+    [{ 'X-Foo': Object.defineProperty([], 0, { get, enumerable: true }) },
+     kHeaderSourceObject],
+    [[Object.defineProperty(['X-Foo'], 1, { get, enumerable: true })],
+     kHeaderSourceEntries],
+  ]) {
+    assert.strictEqual(serializeHeaders(headers, source, flags), undefined);
+  }
+}
+
+// The serialized head is what the client receives, and invalid headers are
+// still rejected with the usual errors.
+const server = http.createServer(common.mustCall((req, res) => {
+  assert.throws(() => res.writeHead(200, { 'X-Foo': 'a\nb' }), {
+    code: 'ERR_INVALID_CHAR'
+  });
+  assert.throws(() => res.writeHead(200, [['X Foo', 'a']]), {
+    code: 'ERR_INVALID_HTTP_TOKEN'
+  });
+  assert.throws(() => res.writeHead(200, { 'bad name': [] }), {
+    code: 'ERR_INVALID_HTTP_TOKEN'
+  });
+  const getter = common.mustCall(() => 'a');
+  assert.throws(() => res.writeHead(200, {
+    get 'X Foo'() { return getter(); }
+  }), {
+    code: 'ERR_INVALID_HTTP_TOKEN'
+  });
+  res.sendDate = false;
+  res.writeHead(200, [
+    ['Content-Length', 2],
+    ['Cookie', ['a=1', 'b=2']],
+    ['X-Latin1', 'é']
+  ]);
+  res.end('ok');
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    client.end('GET / HTTP/1.1\r\nConnection: close\r\n\r\n');
+  }));
+  let response = '';
+  client.setEncoding('latin1');
+  client.on('data', (chunk) => response += chunk);
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(response,
+                       'HTTP/1.1 200 OK\r\n' +
+                       'Content-Length: 2\r\n' +
+                       'Cookie: a=1; b=2\r\n' +
+                       'X-Latin1: é\r\n' +
+                       'Connection: close\r\n' +
+                       '\r\n' +
+                       'ok');
+    server.close();
+  }));
+}));
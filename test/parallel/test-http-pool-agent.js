@@ -0,0 +1,132 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+
+assert.throws(() => new http.PoolAgent({ scheduling: 'random' }), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+assert.throws(() => new http.PoolAgent({ lookupTTL: -1 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => new http.PoolAgent({ maxSockets: 0 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => new http.PoolAgent().preconnect({}, 0), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+
+const server = http.createServer((req, res) => {
+  res.end(req.url);
+});
+
+function get(agent, path) {
+  return new Promise((resolve, reject) => {
+    http.get({
+      agent,
+      host: 'localhost',
+      port: server.address().port,
+      path
+    }, (res) => {
+      let data = '';
+      res.setEncoding('utf8');
+      res.on('data', (chunk) => data += chunk);
+      res.on('end', () => resolve(data));
+    }).on('error', reject);
+  });
+}
+
+function metricsOf(agent) {
+  const metrics = agent.getMetrics();
+  const names = Object.keys(metrics);
+  assert.strictEqual(names.length, 1);
+  assert.strictEqual(names[0], `localhost:${server.address().port}:`);
+  return metrics[names[0]];
+}
+
+async function testQueue() {
+  // Requests over maxSockets are queued and reuse the socket.
+  const agent = new http.PoolAgent({ maxSockets: 1 });
+  const requests = [];
+  for (let i = 0; i < 5; i++)
+    requests.push(get(agent, `/${i}`));
+  assert.strictEqual(metricsOf(agent).pending, 4);
+  assert.deepStrictEqual(await Promise.all(requests),
+                         ['/0', '/1', '/2', '/3', '/4']);
+
+  const metrics = metricsOf(agent);
+  assert.strictEqual(metrics.pending, 0);
+  assert.strictEqual(metrics.requests, 5);
+  assert.strictEqual(metrics.connects, 1);
+  assert.strictEqual(metrics.reused, 4);
+  assert.strictEqual(metrics.reuseRate, 0.8);
+  assert.ok(metrics.connectTime.min > 0);
+  assert.ok(metrics.connectTime.max <= 60e9);
+  agent.destroy();
+}
+
+async function testPreconnect() {
+  const agent = new http.PoolAgent({ maxSockets: 4 });
+  await new Promise((resolve, reject) => {
+    agent.preconnect({ host: 'localhost', port: server.address().port }, 2,
+                     (err) => (err ? reject(err) : resolve()));
+  });
+  let metrics = metricsOf(agent);
+  assert.strictEqual(metrics.idle, 2);
+  assert.strictEqual(metrics.connects, 2);
+
+  assert.strictEqual(await get(agent, '/warm'), '/warm');
+  metrics = metricsOf(agent);
+  assert.strictEqual(metrics.connects, 2);
+  assert.strictEqual(metrics.reused, 1);
+  agent.destroy();
+}
+
+async function testScheduling(scheduling) {
+  const agent = new http.PoolAgent({ scheduling, lookupTTL: 1000 });
+  const paths = ['/a', '/b', '/c', '/d'];
+  assert.deepStrictEqual(await Promise.all(paths.map((p) => get(agent, p))),
+                         paths);
+  // Wait for the sockets to be released.
+  await new Promise((resolve) => setImmediate(resolve));
+  assert.strictEqual(metricsOf(agent).idle, paths.length);
+  assert.deepStrictEqual(await Promise.all(paths.map((p) => get(agent, p))),
+                         paths);
+  const metrics = metricsOf(agent);
+  assert.strictEqual(metrics.requests, 8);
+  assert.strictEqual(metrics.connects + metrics.reused, 8);
+  assert.ok(metrics.reused >= 4);
+  agent.destroy();
+}
+
+async function testRemovePool() {
+  // The pool of an origin is removed once all of its sockets are closed.
+  const agent = new http.PoolAgent({ keepAlive: false });
+  const [pools] = Object.getOwnPropertySymbols(agent)
+    .map((symbol) => agent[symbol])
+    .filter((value) => value instanceof Map);
+  assert.strictEqual(await get(agent, '/once'), '/once');
+  assert.strictEqual(pools.size, 1);
+  while (pools.size > 0)
+    await new Promise((resolve) => setImmediate(resolve));
+  assert.deepStrictEqual(agent.getMetrics(), {});
+
+  // The same happens when the idle sockets of a keep-alive agent are closed.
+  const keepAliveAgent = new http.PoolAgent();
+  assert.strictEqual(await get(keepAliveAgent, '/idle'), '/idle');
+  await new Promise((resolve) => setImmediate(resolve));
+  assert.strictEqual(metricsOf(keepAliveAgent).idle, 1);
+  keepAliveAgent.destroy();
+  while (Object.keys(keepAliveAgent.getMetrics()).length > 0)
+    await new Promise((resolve) => setImmediate(resolve));
+}
+
+server.listen(0, common.mustCall(async () => {
+  await testQueue();
+  await testPreconnect();
+  await testRemovePool();
+  for (const scheduling of ['lifo', 'fifo', 'latency'])
+    await testScheduling(scheduling);
+  server.close();
+}));
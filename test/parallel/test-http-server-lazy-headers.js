@@ -0,0 +1,99 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+const { getIncomingHeader } = require('_http_incoming');
+
+assert.throws(() => http.createServer({ lazyHeaders: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+// More headers than the parser hands to JS in one go.
+const fillers = [];
+for (let i = 0; i < 40; i++)
+  fillers.push(`X-Filler-${i}: value ${i}`);
+
+const request = [
+  'GET /lazy HTTP/1.1',
+  'Host: localhost',
+  'user-agent: test',
+  'Cookie: a=1',
+  'X-Dup: one  ',
+  ...fillers,
+  'cookie: b=2',
+  'Set-Cookie: c=3',
+  'Set-Cookie: d=4',
+  'x-dup: two',
+  'Host: ignored',
+  'Connection: close',
+  '', ''
+].join('\r\n');
+
+// Without lazyHeaders, the headers are plain data properties.
+assert.strictEqual('headers' in http.IncomingMessage.prototype, false);
+assert.strictEqual('rawHeaders' in http.IncomingMessage.prototype, false);
+assert.strictEqual('getHeader' in http.IncomingMessage.prototype, false);
+
+function check(req) {
+  const get = (name) => getIncomingHeader(req, name);
+  assert.strictEqual(req.url, '/lazy');
+  assert.strictEqual(get('HOST'), 'localhost');
+  assert.strictEqual(get('cookie'), 'a=1; b=2');
+  assert.deepStrictEqual(get('Set-Cookie'), ['c=3', 'd=4']);
+  assert.strictEqual(get('X-Dup'), 'one, two');
+  assert.strictEqual(get('x-filler-39'), 'value 39');
+  assert.strictEqual(get('x-missing'), undefined);
+}
+
+function isDataProperty(obj, name) {
+  return 'value' in Object.getOwnPropertyDescriptor(obj, name);
+}
+
+function test(lazyHeaders, cb) {
+  const server = http.createServer({ lazyHeaders },
+                                   common.mustCall((req, res) => {
+                                     assert.strictEqual(
+                                       isDataProperty(req, 'headers'),
+                                       !lazyHeaders);
+                                     check(req);
+                                     const { headers, rawHeaders } = req;
+                                     assert(isDataProperty(req, 'headers'));
+                                     assert(isDataProperty(req, 'rawHeaders'));
+                                     check(req);
+                                     res.end();
+                                     server.close();
+                                     cb({ headers, rawHeaders });
+                                   }));
+  server.listen(0, common.mustCall(() => {
+    net.connect(server.address().port).end(request).resume();
+  }));
+}
+
+test(false, common.mustCall((eager) => {
+  assert.strictEqual(eager.rawHeaders.length, 2 * 50);
+  assert.strictEqual(eager.rawHeaders[7], 'one');
+  test(true, common.mustCall((lazy) => {
+    assert.deepStrictEqual(lazy.rawHeaders, eager.rawHeaders);
+    assert.deepStrictEqual(lazy.headers, eager.headers);
+  }));
+}));
+
+// The headers can still be replaced.
+{
+  const server = http.createServer({ lazyHeaders: true },
+                                   common.mustCall((req, res) => {
+                                     req.headers = { foo: 'bar' };
+                                     assert(isDataProperty(req, 'headers'));
+                                     assert.strictEqual(
+                                       getIncomingHeader(req, 'Foo'), 'bar');
+                                     assert.strictEqual(req.rawHeaders[0],
+                                                        'Host');
+                                     res.end();
+                                     server.close();
+                                   }));
+  server.listen(0, common.mustCall(() => {
+    http.get({ port: server.address().port }, (res) => res.resume());
+  }));
+}
@@ -0,0 +1,67 @@
+'use strict';
+
+// Header names and values reach JavaScript as cached static-table strings,
+// copied short strings or external strings depending on where and how long
+// they are. Check that all of them round-trip unchanged when the same header
+// block is sent repeatedly over one session, so that the dynamic table gets
+// reused.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+
+const long = 'x'.repeat(300);
+const requests = 10;
+
+const server = http2.createServer();
+server.on('stream', common.mustCall((stream, headers, flags, rawHeaders) => {
+  const n = Number(headers['x-n']);
+  assert.strictEqual(headers[':method'], 'GET');
+  assert.strictEqual(headers[':scheme'], 'http');
+  assert.strictEqual(headers[':path'], `/${n}`);
+  assert.strictEqual(headers['accept-encoding'], 'gzip, deflate');
+  assert.strictEqual(headers['x-long'], `${long}${n}`);
+  assert.strictEqual(headers.cookie, 'a=1; b=2');
+  assert.strictEqual(stream.authority, `localhost:${server.address().port}`);
+  assert.strictEqual(rawHeaders.filter((h) => h === 'cookie').length, 2);
+
+  stream.respond({
+    ':status': 200,
+    'content-type': 'text/plain',
+    'set-cookie': ['c=3', 'd=4'],
+    'x-long': long,
+    'x-n': n
+  });
+  stream.end();
+}, requests));
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`);
+  let done = 0;
+  for (let n = 0; n < requests; n++) {
+    const req = client.request({
+      ':path': `/${n}`,
+      'accept-encoding': 'gzip, deflate',
+      'cookie': ['a=1', 'b=2'],
+      'x-long': `${long}${n}`,
+      'x-n': n
+    });
+    req.on('response', common.mustCall((headers) => {
+      assert.strictEqual(headers[':status'], 200);
+      assert.strictEqual(headers['content-type'], 'text/plain');
+      assert.deepStrictEqual(headers['set-cookie'], ['c=3', 'd=4']);
+      assert.strictEqual(headers['x-long'], long);
+      assert.strictEqual(headers['x-n'], `${n}`);
+    }));
+    req.resume();
+    req.on('end', common.mustCall(() => {
+      if (++done === requests) {
+        client.close();
+        server.close();
+      }
+    }));
+    req.end();
+  }
+}));
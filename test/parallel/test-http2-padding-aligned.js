@@ -23,8 +23,9 @@ const makeDuplexPair = require('../common/duplexpair');
 
   const { clientSide, serverSide } = makeDuplexPair();
 
-  // The lengths of the expected writes... note that this is highly
-  // sensitive to how the internals are implemented.
+  // The lengths of the expected frames... note that this is highly
+  // sensitive to how the internals are implemented. Frames that are sent
+  // together are written as one chunk, so only the totals are compared.
   const serverLengths = [24, 9, 9, 32];
   const clientLengths = [9, 9, 48, 9, 1, 21, 1, 16];
 
@@ -38,12 +39,18 @@ const makeDuplexPair = require('../common/duplexpair');
   assert.strictEqual(
     (clientLengths.reduce((i, n) => i + n) - 9 - 9) % 8, 0);
 
-  serverSide.on('data', common.mustCall((chunk) => {
-    assert.strictEqual(chunk.length, serverLengths.shift());
-  }, serverLengths.length));
-  clientSide.on('data', common.mustCall((chunk) => {
-    assert.strictEqual(chunk.length, clientLengths.shift());
-  }, clientLengths.length));
+  let serverReceived = 0;
+  let clientReceived = 0;
+  serverSide.on('data', common.mustCallAtLeast((chunk) => {
+    serverReceived += chunk.length;
+  }));
+  clientSide.on('data', common.mustCallAtLeast((chunk) => {
+    clientReceived += chunk.length;
+  }));
+  process.on('exit', () => {
+    assert.strictEqual(serverReceived, serverLengths.reduce((i, n) => i + n));
+    assert.strictEqual(clientReceived, clientLengths.reduce((i, n) => i + n));
+  });
 
   server.emit('connection', serverSide);
 
@@ -22,6 +22,7 @@ function onStream(stream, headers, flags) {
     assert.strictEqual(typeof state.localClose, 'number');
     assert.strictEqual(typeof state.remoteClose, 'number');
     assert.strictEqual(typeof state.localWindowSize, 'number');
+    assert.strictEqual(typeof state.remoteWindowSize, 'number');
   }
 
   // Test Session State.
@@ -0,0 +1,59 @@
+'use strict';
+
+// Small DATA chunks are copied into the session's outgoing buffer while
+// large ones are written from the stream's own buffers. Check that mixing
+// both, with and without padding, keeps the data of concurrent streams
+// intact and completes every write.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+const { PADDING_STRATEGY_ALIGNED, PADDING_STRATEGY_NONE } = http2.constants;
+
+const sizes = [1, 7, 100, 1023, 1024, 1025, 4000, 17000, 3, 512];
+const streams = 4;
+
+function chunkFor(stream, i) {
+  return Buffer.alloc(sizes[i % sizes.length], `${stream}:${i};`);
+}
+
+function expectedBody(stream, count) {
+  const chunks = [];
+  for (let i = 0; i < count; i++)
+    chunks.push(chunkFor(stream, i));
+  return Buffer.concat(chunks);
+}
+
+for (const paddingStrategy of [PADDING_STRATEGY_NONE,
+                               PADDING_STRATEGY_ALIGNED]) {
+  const count = sizes.length * 5;
+  const server = http2.createServer({ paddingStrategy });
+  server.on('stream', common.mustCall((stream, headers) => {
+    const id = Number(headers[':path'].slice(1));
+    stream.respond();
+    for (let i = 0; i < count; i++)
+      stream.write(chunkFor(id, i), common.mustCall());
+    stream.end();
+  }, streams));
+
+  server.listen(0, common.mustCall(() => {
+    const client = http2.connect(`http://localhost:${server.address().port}`,
+                                 { paddingStrategy });
+    let closed = 0;
+    for (let id = 0; id < streams; id++) {
+      const req = client.request({ ':path': `/${id}` });
+      const chunks = [];
+      req.on('data', (chunk) => chunks.push(chunk));
+      req.on('end', common.mustCall(() => {
+        assert.deepStrictEqual(Buffer.concat(chunks), expectedBody(id, count));
+        if (++closed === streams) {
+          client.close();
+          server.close();
+        }
+      }));
+      req.end();
+    }
+  }));
+}
@@ -0,0 +1,104 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+const {
+  STREAM_SCHEDULER_DEFAULT,
+  STREAM_SCHEDULER_WEIGHTED,
+  STREAM_SCHEDULER_URGENCY,
+  STREAM_SCHEDULER_SMALL_FIRST
+} = http2.constants;
+
+assert.throws(() => http2.createServer({ streamScheduler: 4 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => http2.createServer({ streamScheduler: 'urgency' }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+// Runs `requests` on one session of a server using `streamScheduler`. Once
+// all of them have arrived, `check` is called with the server side streams
+// and must respond to them. Every response body is read in full.
+function test(streamScheduler, requests, check) {
+  return new Promise((resolve) => {
+    const streams = [];
+    const server = http2.createServer({ streamScheduler });
+    server.on('stream', common.mustCall((stream) => {
+      streams.push(stream);
+      if (streams.length === requests.length)
+        check(streams);
+    }, requests.length));
+
+    server.listen(0, common.mustCall(() => {
+      const client = http2.connect(`http://localhost:${server.address().port}`);
+      let done = 0;
+      for (const [headers, options] of requests) {
+        const req = client.request({ ':path': '/', ...headers }, options);
+        let length = 0;
+        req.on('data', (chunk) => length += chunk.length);
+        req.on('response', common.mustCall((headers) => {
+          req.on('end', common.mustCall(() => {
+            if (headers['content-length'] !== undefined)
+              assert.strictEqual(length, Number(headers['content-length']));
+            if (++done === requests.length) {
+              client.close();
+              server.close(resolve);
+            }
+          }));
+        }));
+        req.end();
+      }
+    }));
+  });
+}
+
+function respond(stream, length) {
+  const headers = length === undefined ? {} : { 'content-length': length };
+  stream.respond(headers);
+  stream.end(Buffer.alloc(length || 0));
+}
+
+async function main() {
+  // Stream dependencies are only followed by the default scheduler.
+  const dependent = [[{}, {}], [{}, { parent: 1, weight: 100 }]];
+  await test(STREAM_SCHEDULER_DEFAULT, dependent, ([first, second]) => {
+    assert.strictEqual(first.state.sumDependencyWeight, 100);
+    assert.strictEqual(second.state.weight, 100);
+    respond(first);
+    respond(second);
+  });
+  await test(STREAM_SCHEDULER_WEIGHTED, dependent, ([first, second]) => {
+    assert.strictEqual(first.state.sumDependencyWeight, 0);
+    assert.strictEqual(second.state.weight, 100);
+    respond(first);
+    respond(second);
+  });
+
+  const urgent = [
+    [{ priority: 'u=0' }],
+    [{ priority: 'i, u=7' }],
+    [{ priority: 'i' }],
+    [{}]
+  ];
+  await test(STREAM_SCHEDULER_URGENCY, urgent, (streams) => {
+    assert.deepStrictEqual(streams.map((stream) => stream.state.weight),
+                           [256, 1, 32, 32]);
+    streams.forEach((stream) => respond(stream, 100));
+  });
+
+  const sized = [[{}], [{}], [{}], [{}]];
+  await test(STREAM_SCHEDULER_SMALL_FIRST, sized, (streams) => {
+    const lengths = [10, 1e6, 20000, undefined];
+    streams.forEach((stream, i) => {
+      assert.strictEqual(stream.state.remoteWindowSize, 65535);
+      respond(stream, lengths[i]);
+    });
+    assert.deepStrictEqual(streams.map((stream) => stream.state.weight),
+                           [256, 32, 128, 16]);
+  });
+}
+
+main().then(common.mustCall());
@@ -0,0 +1,22 @@
+'use strict';
+// Flags: --expose-internals
+const common = require('../common');
+
+if (!common.hasIntl)
+  common.skip('missing Intl');
+
+const assert = require('assert');
+const { internalBinding } = require('internal/test/binding');
+const { getTranscoder, transcodeChunk } = internalBinding('icu');
+
+// Converters that cannot be opened are reported as an ICU error code instead
+// of leaving the stream without a handle.
+assert.strictEqual(typeof getTranscoder('not-an-encoding', 'utf8', 0),
+                   'number');
+assert.strictEqual(typeof getTranscoder('utf8', 'not-an-encoding', 0),
+                   'number');
+
+const transcoder = getTranscoder('utf8', 'utf16le', 0);
+assert.strictEqual(typeof transcoder, 'object');
+assert.deepStrictEqual(transcodeChunk(transcoder, Buffer.from('a'), 1),
+                       Buffer.from('a', 'utf16le'));
@@ -0,0 +1,110 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+const N = 20;
+
+function connectClients(port, onDone) {
+  let closed = 0;
+  for (let i = 0; i < N; i++) {
+    const client = net.connect(port);
+    client.resume();
+    client.on('close', () => {
+      if (++closed === N)
+        onDone();
+    });
+  }
+}
+
+// All accepted connections are passed to 'connections' in batches.
+{
+  const server = net.createServer({
+    acceptBatching: true,
+    acceptMetrics: true
+  });
+  assert.strictEqual(server.getAcceptMetrics(), null);
+
+  let accepted = 0;
+  server.on('connection', common.mustNotCall());
+  server.on('connections', common.mustCallAtLeast((sockets) => {
+    assert.ok(Array.isArray(sockets));
+    assert.ok(sockets.length > 0);
+    for (const socket of sockets) {
+      assert.ok(socket instanceof net.Socket);
+      assert.strictEqual(socket.server, server);
+      socket.end('ok');
+    }
+    accepted += sockets.length;
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const { backlog, latency } = server.getAcceptMetrics();
+    connectClients(server.address().port, common.mustCall(() => {
+      assert.strictEqual(accepted, N);
+      assert.ok(backlog.min >= 1);
+      assert.ok(backlog.max <= N);
+      assert.ok(latency.min >= 1);
+      assert.ok(latency.percentile(50) >= latency.min);
+      server.close();
+    }));
+  }));
+}
+
+// Without a 'connections' listener, 'connection' is emitted for each
+// connection of a batch.
+{
+  const server = net.createServer({ acceptBatching: true },
+                                  common.mustCall((socket) => {
+                                    socket.end();
+                                  }, N));
+  assert.strictEqual(server.getAcceptMetrics(), null);
+  server.listen(0, common.mustCall(() => {
+    assert.strictEqual(server.getAcceptMetrics(), null);
+    connectClients(server.address().port, common.mustCall(() => {
+      server.close();
+    }));
+  }));
+}
+
+// Accept metrics can be recorded without batching.
+{
+  const server = net.createServer({ acceptMetrics: true },
+                                  common.mustCall((socket) => {
+                                    socket.end();
+                                  }, N));
+  server.listen(0, common.mustCall(() => {
+    const { backlog, latency } = server.getAcceptMetrics();
+    connectClients(server.address().port, common.mustCall(() => {
+      assert.ok(backlog.max >= 1);
+      assert.ok(latency.max >= latency.min);
+      server.close();
+    }));
+  }));
+}
+
+// maxConnections applies to each connection of a batch.
+{
+  const server = net.createServer({ acceptBatching: true });
+  server.maxConnections = 1;
+  let accepted;
+  server.on('connections', common.mustCall((sockets) => {
+    assert.strictEqual(sockets.length, 1);
+    accepted = sockets[0];
+  }));
+  server.listen(0, common.mustCall(() => {
+    const { port } = server.address();
+    const first = net.connect(port, common.mustCall(() => {
+      // The second connection exceeds maxConnections and is closed.
+      const second = net.connect(port);
+      second.on('error', () => {});
+      second.on('close', common.mustCall(() => {
+        first.destroy();
+        accepted.destroy();
+        server.close();
+      }));
+      second.resume();
+    }));
+  }));
+}
@@ -0,0 +1,56 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// Test that the `onread` option of net.createServer() applies to incoming
+// connections, and that a buffer provider can rotate buffers from a pool
+// that is shared between them.
+
+const message = Buffer.alloc(64 * 1024, 'x');
+const clients = 3;
+const pool = [];
+let allocated = 0;
+const received = new Map();
+
+function acquire() {
+  if (pool.length > 0)
+    return pool.pop();
+  allocated++;
+  return Buffer.alloc(1024);
+}
+
+const server = net.createServer({
+  onread: {
+    buffer: acquire,
+    callback(nread, buf) {
+      assert.ok(this instanceof net.Socket);
+      assert.ok(nread <= buf.length);
+      received.set(this, (received.get(this) || 0) + nread);
+      // The buffer now belongs to this callback until it is returned to the
+      // pool, which here happens right away.
+      pool.push(buf);
+    }
+  }
+}, common.mustCall((socket) => {
+  socket.on('data', common.mustNotCall());
+  socket.on('end', common.mustCall(() => {
+    assert.strictEqual(received.get(socket), message.length);
+    socket.end();
+  }));
+}, clients));
+
+server.listen(0, common.mustCall(() => {
+  let closed = 0;
+  for (let i = 0; i < clients; i++) {
+    net.connect(server.address().port, common.mustCall(function() {
+      this.end(message);
+    })).on('close', common.mustCall(() => {
+      if (++closed === clients) {
+        server.close();
+        // Buffers are recycled rather than allocated per read.
+        assert.ok(allocated <= clients);
+      }
+    })).resume();
+  }
+}));
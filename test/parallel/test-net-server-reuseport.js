@@ -0,0 +1,58 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+if (common.isWindows) {
+  const server = net.createServer();
+  server.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOTSUP');
+  }));
+  server.listen({ port: 0, host: common.localhostIPv4, reusePort: true },
+                common.mustNotCall());
+  return;
+}
+
+// Several servers can listen on the same port when all of them set
+// `reusePort`, and between them they accept every connection.
+const kServers = 3;
+const kConnections = 30;
+const servers = [];
+let accepted = 0;
+
+function onConnection(socket) {
+  socket.end();
+  if (++accepted === kConnections)
+    servers.forEach((server) => server.close());
+}
+
+function listen(port, callback) {
+  const server = net.createServer(onConnection);
+  servers.push(server);
+  server.listen({ port, host: common.localhostIPv4, reusePort: true },
+                common.mustCall(() => callback(server.address().port)));
+}
+
+listen(0, common.mustCall((port) => {
+  // A server without `reusePort` still cannot share the port.
+  const other = net.createServer();
+  other.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'EADDRINUSE');
+  }));
+  other.listen({ port, host: common.localhostIPv4 }, common.mustNotCall());
+
+  let listening = 1;
+  for (let i = 1; i < kServers; i++) {
+    listen(port, common.mustCall((samePort) => {
+      assert.strictEqual(samePort, port);
+      if (++listening === kServers)
+        connect(port);
+    }));
+  }
+}));
+
+function connect(port) {
+  for (let i = 0; i < kConnections; i++) {
+    net.connect(port, common.localhostIPv4).resume();
+  }
+}
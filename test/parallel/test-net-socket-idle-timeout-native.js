@@ -0,0 +1,66 @@
+// Flags: --expose-internals
+'use strict';
+
+// Tests that the idle timeouts of TCP sockets are tracked by the handle,
+// without a JS timer, and that activity on the socket restarts them.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { kTimeout } = require('internal/timers');
+
+const server = net.createServer(common.mustCall((conn) => {
+  conn.on('data', () => {});
+  conn.on('end', () => conn.end());
+}, 3));
+
+server.listen(0, common.mustCall(() => {
+  const { port } = server.address();
+  let pending = 3;
+  const done = () => {
+    if (--pending === 0)
+      server.close();
+  };
+
+  // An idle socket times out once.
+  {
+    const socket = net.connect(port, common.mustCall(() => {
+      socket.setTimeout(common.platformTimeout(50), common.mustCall(() => {
+        assert.strictEqual(socket[kTimeout], null);
+        setTimeout(() => socket.end(), common.platformTimeout(200));
+      }));
+      assert.strictEqual(socket[kTimeout], null);
+      assert.strictEqual(typeof socket._handle.ontimeout, 'function');
+    }));
+    socket.on('close', done);
+  }
+
+  // Writes keep a socket from timing out.
+  {
+    const timeout = common.platformTimeout(200);
+    let writes = 0;
+    const socket = net.connect(port, common.mustCall(() => {
+      socket.setTimeout(timeout);
+      const interval = setInterval(() => {
+        if (++writes === 10) {
+          clearInterval(interval);
+          socket.end();
+        } else {
+          socket.write('x');
+        }
+      }, timeout / 4);
+    }));
+    socket.on('timeout', common.mustNotCall());
+    socket.on('close', done);
+  }
+
+  // setTimeout(0) disables the timeout.
+  {
+    const socket = net.connect(port, common.mustCall(() => {
+      socket.setTimeout(common.platformTimeout(50), common.mustNotCall());
+      socket.setTimeout(0);
+      setTimeout(() => socket.end(), common.platformTimeout(200));
+    }));
+    socket.on('close', done);
+  }
+}));
@@ -0,0 +1,139 @@
+'use strict';
+
+// Tests the typed socket option API of net.Socket and net.Server over
+// loopback.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// Argument validation does not depend on the platform.
+{
+  const socket = new net.Socket();
+  assert.throws(() => socket.setSocketOption('SO_KEEPALIVE', 1), {
+    code: 'ERR_INVALID_ARG_VALUE'
+  });
+  assert.throws(() => socket.setSocketOption('TCP_NOTSENT_LOWAT', true), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => socket.setSocketOption('TCP_NOTSENT_LOWAT', -1), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+  assert.throws(() => socket.setSocketOption('TCP_QUICKACK', 1), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => socket.getSocketOption('TCP_NOPUSH'), {
+    code: 'ERR_INVALID_ARG_VALUE'
+  });
+  assert.throws(() => socket.getSocketOption('TCP_USER_TIMEOUT'), {
+    code: 'EBADF'
+  });
+
+  const server = net.createServer();
+  assert.throws(() => server.setSocketOption('TCP_FASTOPEN', 16), {
+    code: 'ERR_SERVER_NOT_RUNNING'
+  });
+}
+
+if (!common.isLinux) {
+  // The options are not supported everywhere, but they must fail cleanly.
+  const server = net.createServer().listen(0, common.mustCall(() => {
+    try {
+      server.setSocketOption('TCP_DEFER_ACCEPT', 1);
+    } catch (err) {
+      assert.strictEqual(err.code, 'ENOTSUP');
+    }
+    server.close();
+  }));
+  return;
+}
+
+const server = net.createServer(common.mustCall((conn) => {
+  conn.setSocketOption('TCP_NOTSENT_LOWAT', 16384);
+  assert.strictEqual(conn.getSocketOption('TCP_NOTSENT_LOWAT'), 16384);
+  conn.setSocketOption('TCP_USER_TIMEOUT', 5000);
+  assert.strictEqual(conn.getSocketOption('TCP_USER_TIMEOUT'), 5000);
+  conn.setSocketOption('TCP_QUICKACK', true);
+  assert.strictEqual(typeof conn.getSocketOption('TCP_QUICKACK'), 'boolean');
+
+  // Raising SO_BUSY_POLL may require privileges; lowering it does not.
+  conn.setSocketOption('SO_BUSY_POLL', 0);
+  assert.strictEqual(conn.getSocketOption('SO_BUSY_POLL'), 0);
+
+  const info = conn.getTCPInfo();
+  assert.strictEqual(info.state, 1);  // TCP_ESTABLISHED
+  for (const key of ['rtt', 'rttVariance', 'rto', 'congestionWindow', 'mss'])
+    assert.ok(Number.isInteger(info[key]) && info[key] >= 0, key);
+  assert.ok(info.congestionWindow > 0);
+
+  // The handle writes into the view it is given, not at the start of the
+  // underlying ArrayBuffer.
+  const fields = Object.keys(info).length;
+  const backing = new Float64Array(fields + 2).fill(-1);
+  const view = new Float64Array(backing.buffer, 8, fields);
+  assert.strictEqual(conn._handle.getTCPInfo(view), 0);
+  assert.strictEqual(backing[0], -1);
+  assert.strictEqual(backing[fields + 1], -1);
+  assert.strictEqual(view[0], 1);
+
+  conn.end('ok');
+}));
+
+server.listen(0, common.localhostIPv4, common.mustCall(() => {
+  server.setSocketOption('TCP_DEFER_ACCEPT', 1);
+  assert.ok(server.getSocketOption('TCP_DEFER_ACCEPT') > 0);
+  server.setSocketOption('TCP_FASTOPEN', 16);
+
+  // Options set before connecting are applied before the connection is
+  // established.
+  const client = net.connect(server.address().port, common.localhostIPv4);
+  client.setSocketOption('TCP_USER_TIMEOUT', 3000);
+  client.on('connect', common.mustCall(() => {
+    assert.strictEqual(client.getSocketOption('TCP_USER_TIMEOUT'), 3000);
+    // TCP_DEFER_ACCEPT holds the connection until there is data.
+    client.write('hello');
+  }));
+
+  let data = '';
+  client.setEncoding('utf8');
+  client.on('data', (chunk) => data += chunk);
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(data, 'ok');
+    server.close();
+  }));
+}));
+
+// Options are also applied to sockets that are created before connect().
+{
+  const socket = new net.Socket();
+  socket.setSocketOption('TCP_NOTSENT_LOWAT', 4096);
+  const other = net.createServer(common.mustCall((conn) => {
+    conn.end();
+    other.close();
+  }));
+  other.listen(0, common.mustCall(() => {
+    socket.connect(other.address().port, common.mustCall(() => {
+      assert.strictEqual(socket.getSocketOption('TCP_NOTSENT_LOWAT'), 4096);
+      socket.end();
+    }));
+    socket.resume();
+  }));
+}
+
+// IPC sockets do not support these options.
+{
+  const tmpdir = require('../common/tmpdir');
+  tmpdir.refresh();
+  const ipc = net.createServer(common.mustCall((conn) => {
+    assert.throws(() => conn.setSocketOption('TCP_QUICKACK', true), {
+      code: 'ENOTSUP',
+      syscall: 'setsockopt'
+    });
+    assert.throws(() => conn.getTCPInfo(), { code: 'ENOTSUP' });
+    conn.end();
+    ipc.close();
+  }));
+  ipc.listen(common.PIPE, common.mustCall(() => {
+    net.connect(common.PIPE).resume();
+  }));
+}
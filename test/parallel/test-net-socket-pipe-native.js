@@ -0,0 +1,59 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// Tests socket.pipeNative() by running data through a proxy that forwards it
+// natively in both directions.
+
+const payload = Buffer.alloc(1024 * 1024, 'x');
+
+{
+  const socket = new net.Socket();
+  assert.throws(() => socket.pipeNative({}), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => socket.pipeNative(new net.Socket(), 'foo'), {
+    code: 'ERR_INVALID_CALLBACK'
+  });
+}
+
+const backend = net.createServer(common.mustCall((socket) => {
+  // Echo everything back.
+  socket.pipe(socket);
+}));
+
+function onConnection(client) {
+  const upstream = net.connect({
+    port: backend.address().port,
+    allowHalfOpen: true
+  });
+  client.on('end', common.mustCall());
+  client.pipeNative(upstream, common.mustCall((err, bytes) => {
+    assert.ifError(err);
+    assert.strictEqual(bytes, payload.length + 5);
+  }));
+  upstream.pipeNative(client, common.mustCall((err, bytes) => {
+    assert.ifError(err);
+    assert.strictEqual(bytes, payload.length + 5);
+    proxy.close();
+    backend.close();
+  }));
+}
+
+// Both directions are ended independently, so half-open sockets are needed.
+const proxy = net.createServer({ allowHalfOpen: true },
+                               common.mustCall(onConnection));
+
+backend.listen(0, common.mustCall(() => {
+  proxy.listen(0, common.mustCall(() => {
+    const client = net.connect(proxy.address().port);
+    let received = 0;
+    client.on('data', (data) => received += data.length);
+    client.on('end', common.mustCall(() => {
+      assert.strictEqual(received, payload.length + 5);
+    }));
+    client.write('hello');
+    client.end(payload);
+  }));
+}));
@@ -0,0 +1,36 @@
+// Flags: --experimental-timer-wheel
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// Tests socket timeouts that are kept in the native timer wheel.
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.setTimeout(200);
+  socket.resume();
+  socket.on('timeout', common.mustCall(() => {
+    // The timeout is refreshed by the incoming data.
+    assert.strictEqual(writes, 5);
+    socket.destroy();
+    server.close();
+  }));
+}));
+
+let writes = 0;
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port);
+  const interval = setInterval(() => {
+    client.write('ping');
+    if (++writes === 5)
+      clearInterval(interval);
+  }, 50);
+  client.on('close', common.mustCall());
+  client.resume();
+
+  // A cleared timeout does not fire.
+  const other = new net.Socket();
+  other.setTimeout(10, common.mustNotCall());
+  other.setTimeout(0);
+}));
@@ -0,0 +1,114 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+const { TCP, constants: TCPConstants } = internalBinding('tcp_wrap');
+const {
+  WriteWrap,
+  kLastWriteWasAsync,
+  streamBaseState
+} = internalBinding('stream_wrap');
+const { UV_ECANCELED } = internalBinding('uv');
+
+// Tests that small writes are coalesced when write coalescing is enabled,
+// that they stay pending until the data has been written, and that the data
+// arrives complete and in order.
+
+const chunks = [];
+for (let i = 0; i < 100; i++)
+  chunks.push(`chunk ${i};`);
+// A write that is too large to be coalesced must not overtake earlier data.
+chunks.push('x'.repeat(16 * 1024));
+chunks.push('last');
+const expected = chunks.join('');
+
+const server = net.createServer(common.mustCall((socket) => {
+  let received = '';
+  socket.setEncoding('utf8');
+  socket.on('data', (data) => received += data);
+  socket.on('end', common.mustCall(() => {
+    assert.strictEqual(received, expected);
+    server.close();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port);
+  assert.deepStrictEqual(client.getWriteCoalescingStats(), {
+    coalescedWrites: 0,
+    flushes: 0,
+    syscallsSaved: 0
+  });
+  assert.strictEqual(client.setWriteCoalescing(), client);
+
+  client.on('connect', common.mustCall(() => {
+    let pending = chunks.length;
+    for (const chunk of chunks) {
+      client.write(chunk, common.mustCall((err) => {
+        assert.ifError(err);
+        if (--pending === 0)
+          finish();
+      }));
+    }
+
+    // The first write waits to be flushed, and the rest is buffered behind
+    // it, so the socket applies backpressure.
+    assert.strictEqual(pending, chunks.length);
+    assert.strictEqual(client.writableLength, expected.length);
+    assert.strictEqual(client._handle.writeQueueSize, chunks[0].length);
+    assert.deepStrictEqual(client.getWriteCoalescingStats(), {
+      coalescedWrites: 1,
+      flushes: 0,
+      syscallsSaved: 1
+    });
+
+    function finish() {
+      const stats = client.getWriteCoalescingStats();
+      assert(stats.coalescedWrites >= 1);
+      assert(stats.flushes >= 1);
+      assert.strictEqual(stats.syscallsSaved,
+                         stats.coalescedWrites - stats.flushes);
+      client.setWriteCoalescing(false);
+      client.end();
+    }
+  }));
+}));
+
+// A failure of the combined write, and closing the handle before it has been
+// written, are reported to every coalesced write.
+function writeCoalesced(handle, data, oncomplete) {
+  const req = new WriteWrap();
+  req.handle = handle;
+  req.oncomplete = oncomplete;
+  assert.strictEqual(handle.writeUtf8String(req, data), 0);
+  assert.strictEqual(streamBaseState[kLastWriteWasAsync], 1);
+}
+
+{
+  // The handle has no file descriptor yet, so writing to it fails.
+  const handle = new TCP(TCPConstants.SOCKET);
+  handle.setWriteCoalescing(true);
+  let firstStatus;
+  writeCoalesced(handle, 'hello', common.mustCall((status) => {
+    assert(status < 0);
+    firstStatus = status;
+  }));
+  writeCoalesced(handle, 'world', common.mustCall((status) => {
+    assert.strictEqual(status, firstStatus);
+    handle.close();
+  }));
+  assert.strictEqual(handle.writeQueueSize, 10);
+}
+
+{
+  const handle = new TCP(TCPConstants.SOCKET);
+  handle.setWriteCoalescing(true);
+  const oncomplete = common.mustCall((status) => {
+    assert.strictEqual(status, UV_ECANCELED);
+  }, 2);
+  writeCoalesced(handle, 'hello', oncomplete);
+  writeCoalesced(handle, 'world', oncomplete);
+  handle.close();
+}
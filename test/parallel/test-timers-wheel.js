@@ -0,0 +1,102 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { internalBinding } = require('internal/test/binding');
+const { TimerWheel, getLibuvNow } = internalBinding('timers');
+const { setUnrefWheelTimeout } = require('internal/timers');
+
+// Tests the native timer wheel used for the idle timeouts of sockets.
+
+const wheel = new TimerWheel(1);
+// The wheel measures time with the cached event loop time.
+const start = getLibuvNow();
+const fired = new Map();
+
+// Timeouts on all levels of the wheel, with some of them removed or
+// refreshed before they expire.
+const timeouts = [5, 20, 300, 1000, 70000];
+const ids = timeouts.map((timeout) => wheel.add(timeout));
+const removed = wheel.add(10);
+wheel.remove(removed);
+assert.strictEqual(wheel.active(), timeouts.length);
+
+const refreshed = ids[1];
+setTimeout(common.mustCall(() => wheel.refresh(refreshed)), 10);
+
+wheel.ontimeout = common.mustCallAtLeast((expired) => {
+  assert(Array.isArray(expired));
+  for (const id of expired) {
+    assert.notStrictEqual(id, removed);
+    assert(!fired.has(id));
+    fired.set(id, getLibuvNow() - start);
+  }
+
+  if (fired.size < 4)
+    return;
+
+  assert(fired.get(ids[0]) >= 5);
+  // Refreshed after 10 ms.
+  assert(fired.get(refreshed) >= 30);
+  assert(fired.get(ids[2]) >= 300);
+  assert(fired.get(ids[3]) >= 1000);
+  assert(!fired.has(ids[4]));
+
+  // Expired timeouts can be restarted.
+  assert.strictEqual(wheel.active(), 1);
+  wheel.refresh(ids[0]);
+  assert.strictEqual(wheel.active(), 2);
+  wheel.remove(ids[0]);
+  wheel.remove(ids[4]);
+  assert.strictEqual(wheel.active(), 0);
+  wheel.close();
+});
+
+// The wheel does not keep the event loop alive on its own.
+{
+  const unrefed = new TimerWheel(1);
+  unrefed.add(1e6);
+  unrefed.ontimeout = common.mustNotCall();
+}
+
+// The id of a timeout that is removed while the expired ids are delivered is
+// not handed out again before the callback has returned.
+{
+  const wheel = new TimerWheel(1);
+  const first = wheel.add(5);
+  const second = wheel.add(5);
+  const keepAlive = setTimeout(common.mustNotCall(), 1000);
+  wheel.ontimeout = common.mustCall((expired) => {
+    assert.deepStrictEqual(expired.sort((a, b) => a - b), [first, second]);
+    wheel.remove(second);
+    const added = wheel.add(5);
+    assert.notStrictEqual(added, second);
+    assert.notStrictEqual(added, first);
+    setImmediate(common.mustCall(() => {
+      // Now the id can be used again.
+      assert.strictEqual(wheel.add(5), second);
+      wheel.close();
+      clearTimeout(keepAlive);
+    }));
+  });
+}
+
+// A callback that clears a timeout which expired in the same tick and
+// schedules a new one does not make the new one fire early.
+{
+  const keepAlive = setTimeout(common.mustNotCall(), 1000);
+  let fired = false;
+  function onTimeout() {
+    assert(!fired);
+    fired = true;
+    clearTimeout(this === first ? second : first);
+    const start = getLibuvNow();
+    const next = setUnrefWheelTimeout(common.mustCall(() => {
+      assert(getLibuvNow() - start >= 50);
+      clearTimeout(next);
+      clearTimeout(keepAlive);
+    }), 50);
+  }
+  const first = setUnrefWheelTimeout(onTimeout, 5);
+  const second = setUnrefWheelTimeout(onTimeout, 5);
+}
@@ -0,0 +1,64 @@
+'use strict';
+const common = require('../common');
+const fixtures = require('../common/fixtures');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// With dynamicRecordSizing, the first 128 KiB after the handshake are sent
+// in small records, and everything after that in full sized ones. Every
+// record is decrypted into its own chunk on the receiving side.
+
+const assert = require('assert');
+const tls = require('tls');
+
+const smallRecordSize = 1300;
+const threshold = 128 * 1024;
+
+assert.throws(() => new tls.TLSSocket(null, { dynamicRecordSizing: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => tls.createServer({ dynamicRecordSizing: 'yes' }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+const buf = Buffer.alloc(4 * threshold, 'x');
+
+function test(maxSendFragment, cb) {
+  const server = tls.createServer({
+    key: fixtures.readKey('agent1-key.pem'),
+    cert: fixtures.readKey('agent1-cert.pem'),
+    dynamicRecordSizing: true
+  }, common.mustCall((c) => {
+    if (maxSendFragment !== undefined)
+      assert.strictEqual(c.setMaxSendFragment(maxSendFragment), true);
+    c.end(buf);
+  })).listen(0, common.mustCall(() => {
+    const c = tls.connect(server.address().port, {
+      rejectUnauthorized: false
+    }, common.mustCall(() => {
+      let received = 0;
+      let largest = 0;
+      c.on('data', (chunk) => {
+        if (received < threshold)
+          assert.ok(chunk.length <= smallRecordSize);
+        else
+          largest = Math.max(largest, chunk.length);
+        received += chunk.length;
+      });
+
+      c.on('end', common.mustCall(() => {
+        assert.strictEqual(received, buf.length);
+        assert.ok(largest > smallRecordSize);
+        // The limit set with setMaxSendFragment() still applies after the
+        // small records.
+        if (maxSendFragment !== undefined)
+          assert.ok(largest <= maxSendFragment);
+        c.destroy();
+        server.close(cb);
+      }));
+    }));
+  }));
+}
+
+test(undefined, common.mustCall(() => test(4096)));
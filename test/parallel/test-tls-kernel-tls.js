@@ -0,0 +1,89 @@
+'use strict';
+const common = require('../common');
+const fixtures = require('../common/fixtures');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// With kernelTLS, data must arrive intact in both directions whether or not
+// the kernel took over encryption, which depends on the platform and on the
+// loaded kernel modules.
+
+const assert = require('assert');
+const tls = require('tls');
+
+assert.throws(() => new tls.TLSSocket(null, { kernelTLS: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => tls.createServer({ kernelTLS: 'yes' }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+const request = Buffer.alloc(100 * 1024, 'q');
+const response = Buffer.alloc(1024 * 1024, 'r');
+
+function test(options, check) {
+  return new Promise((resolve) => {
+    const server = tls.createServer({
+      key: fixtures.readKey('agent1-key.pem'),
+      cert: fixtures.readKey('agent1-cert.pem'),
+      kernelTLS: true,
+      ...options
+    }, common.mustCall((conn) => {
+      const chunks = [];
+      conn.on('data', (chunk) => {
+        chunks.push(chunk);
+        if (Buffer.concat(chunks).length < request.length)
+          return;
+        assert.deepStrictEqual(Buffer.concat(chunks), request);
+        conn.end(response);
+        check(conn);
+      });
+    })).listen(0, common.mustCall(() => {
+      const conn = tls.connect({
+        port: server.address().port,
+        rejectUnauthorized: false,
+        kernelTLS: true,
+        ...options
+      }, common.mustCall(() => {
+        conn.write(request);
+      }));
+      // The secrets captured for the kernel are not passed to JS.
+      const emit = conn.emit;
+      conn.emit = function(event, ...args) {
+        assert.notStrictEqual(event, 'keylog');
+        return emit.call(this, event, ...args);
+      };
+      const chunks = [];
+      conn.on('data', (chunk) => chunks.push(chunk));
+      conn.on('end', common.mustCall(() => {
+        assert.deepStrictEqual(Buffer.concat(chunks), response);
+        check(conn);
+        conn.end();
+        server.close(resolve);
+      }));
+    }));
+  });
+}
+
+async function main() {
+  const maybe = (conn) => {
+    assert.strictEqual(typeof conn.isKernelTLS(), 'boolean');
+  };
+  const never = (conn) => assert.strictEqual(conn.isKernelTLS(), false);
+
+  await test({ maxVersion: 'TLSv1.2', ciphers: 'AES128-GCM-SHA256' }, maybe);
+  await test({ maxVersion: 'TLSv1.2', ciphers: 'AES256-GCM-SHA384' }, maybe);
+  await test({ minVersion: 'TLSv1.3', ciphers: 'TLS_AES_128_GCM_SHA256' },
+             maybe);
+  await test({ minVersion: 'TLSv1.3', ciphers: 'TLS_AES_256_GCM_SHA384' },
+             maybe);
+  // Only AES-GCM is handed to the kernel.
+  await test({ maxVersion: 'TLSv1.2', ciphers: 'AES128-SHA256' }, never);
+  await test({
+    minVersion: 'TLSv1.3',
+    ciphers: 'TLS_CHACHA20_POLY1305_SHA256'
+  }, never);
+}
+
+main().then(common.mustCall());
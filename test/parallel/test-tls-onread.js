@@ -0,0 +1,58 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const tls = require('tls');
+
+// Test that the `onread` option delivers decrypted data into the supplied
+// buffers on both ends of a TLS connection.
+
+const message = Buffer.alloc(100 * 1024);
+for (let i = 0; i < message.length; i++)
+  message[i] = i % 251;
+
+function collector(buffer, chunks) {
+  return {
+    buffer,
+    callback(nread, buf) {
+      assert.ok(nread > 0 && nread <= buf.length);
+      chunks.push(Buffer.from(buf.subarray(0, nread)));
+    }
+  };
+}
+
+const serverChunks = [];
+const serverBuffers = [Buffer.alloc(4096), Buffer.alloc(4096)];
+let next = 0;
+
+const server = tls.createServer({
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+  onread: collector(() => serverBuffers[next++ % 2], serverChunks)
+}, common.mustCall((socket) => {
+  socket.on('data', common.mustNotCall());
+  socket.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(serverChunks), message);
+    socket.end(message);
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const clientChunks = [];
+  const clientBuffer = Buffer.alloc(1000);
+  const client = tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false,
+    onread: collector(clientBuffer, clientChunks)
+  }, common.mustCall(() => {
+    client.end(message);
+  }));
+  client.on('data', common.mustNotCall());
+  client.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(clientChunks), message);
+    server.close();
+  }));
+}));
@@ -0,0 +1,114 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Sessions created by one server can be resumed by another server in the
+// process that uses a session cache with the same name, both by session
+// ticket and by session ID.
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+const { SSL_OP_NO_TICKET } = require('crypto').constants;
+
+const key = fixtures.readKey('agent1-key.pem');
+const cert = fixtures.readKey('agent1-cert.pem');
+
+function listen(options) {
+  const server = tls.createServer({ key, cert, ...options }, (socket) => {
+    socket.end('ok');
+  });
+  return new Promise((resolve) => {
+    server.listen(0, () => resolve(server));
+  });
+}
+
+function connect(server, session) {
+  return new Promise((resolve) => {
+    let tlsSession;
+    const socket = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+      session
+    });
+    socket.on('session', (s) => { tlsSession = s; });
+    socket.resume();
+    socket.on('close', common.mustCall(() => {
+      resolve({ reused: socket.isSessionReused(), session: tlsSession });
+    }));
+  });
+}
+
+async function test(options, expectReused) {
+  const first = await listen(options);
+  const second = await listen(options);
+
+  const { reused, session } = await connect(first);
+  assert.strictEqual(reused, false);
+  assert(session);
+  const resumed = await connect(second, session);
+  assert.strictEqual(resumed.reused, expectReused);
+
+  first.close();
+  second.close();
+}
+
+(async function() {
+  const sessionCache = { name: 'test-tls-shared-session-cache' };
+
+  // Without a shared cache, the servers have their own ticket keys.
+  await test({}, false);
+
+  // TLS 1.3 and TLS 1.2 session tickets.
+  await test({ sessionCache }, true);
+  await test({ sessionCache, maxVersion: 'TLSv1.2' }, true);
+
+  // TLS 1.2 session IDs.
+  await test({ maxVersion: 'TLSv1.2', secureOptions: SSL_OP_NO_TICKET },
+             false);
+  await test({
+    sessionCache,
+    maxVersion: 'TLSv1.2',
+    secureOptions: SSL_OP_NO_TICKET
+  }, true);
+
+  // Explicit ticket keys take precedence over the ones of the cache.
+  const first = await listen({ sessionCache });
+  const second = await listen({ sessionCache });
+  assert.deepStrictEqual(first.getTicketKeys(), second.getTicketKeys());
+  second.setTicketKeys(Buffer.alloc(48, 1));
+  assert.deepStrictEqual(second.getTicketKeys(), Buffer.alloc(48, 1));
+  const { session } = await connect(first);
+  assert.strictEqual((await connect(second, session)).reused, false);
+  first.close();
+  second.close();
+})().then(common.mustCall());
+
+[null, 'cache', []].forEach((sessionCache) => {
+  assert.throws(() => tls.createServer({ sessionCache }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    message: /options\.sessionCache/
+  });
+});
+
+assert.throws(() => tls.createServer({ sessionCache: {} }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: /options\.sessionCache\.name/
+});
+
+[0, -1, 1.5].forEach((maxSize) => {
+  assert.throws(() => tls.createServer({
+    sessionCache: { name: 'test', maxSize }
+  }), {
+    code: 'ERR_OUT_OF_RANGE',
+    message: /options\.sessionCache\.maxSize/
+  });
+});
+
+assert.throws(() => tls.createServer({
+  sessionCache: { name: 'test', ticketKeyRotation: -1 }
+}), {
+  code: 'ERR_OUT_OF_RANGE',
+  message: /options\.sessionCache\.ticketKeyRotation/
+});
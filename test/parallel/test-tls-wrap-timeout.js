@@ -1,12 +1,14 @@
-// Flags: --expose_internals
-
 'use strict';
 const common = require('../common');
-const { kTimeout, TIMEOUT_MAX } = require('internal/timers');
 
 if (!common.hasCrypto)
   common.skip('missing crypto');
 
+// The idle timeout of a TCP socket that a TLS socket is layered on is
+// tracked natively. TLS traffic on the socket must keep it from firing, it
+// must fire once the traffic stops, and it must not fire after the socket
+// has been closed.
+
 const assert = require('assert');
 const tls = require('tls');
 const net = require('net');
@@ -17,39 +19,43 @@ const options = {
   cert: fixtures.readKey('agent1-cert.pem')
 };
 
+const timeout = common.platformTimeout(200);
+const writes = 10;
+
 const server = tls.createServer(options, common.mustCall((c) => {
-  setImmediate(() => {
-    c.write('hello', () => {
-      setImmediate(() => {
-        c.destroy();
-        server.close();
-      });
-    });
-  });
+  let count = 0;
+  const interval = setInterval(() => {
+    c.write('x');
+    if (++count === writes)
+      clearInterval(interval);
+  }, timeout / 4);
+  c.on('error', () => {});
 }));
 
-let socket;
-let lastIdleStart;
+let received = 0;
 
-server.listen(0, () => {
-  socket = net.connect(server.address().port, function() {
-    const s = socket.setTimeout(TIMEOUT_MAX, function() {
-      throw new Error('timeout');
-    });
+server.listen(0, common.mustCall(() => {
+  const socket = net.connect(server.address().port, common.mustCall(() => {
+    const s = socket.setTimeout(timeout, common.mustCall(() => {
+      // Only after the server has stopped writing.
+      assert.strictEqual(received, writes);
+      socket.destroy();
+    }));
     assert.ok(s instanceof net.Socket);
 
-    assert.notStrictEqual(socket[kTimeout]._idleTimeout, -1);
-    lastIdleStart = socket[kTimeout]._idleStart;
-
     const tsocket = tls.connect({
       socket: socket,
       rejectUnauthorized: false
     });
-    tsocket.resume();
-  });
-});
-
-process.on('exit', () => {
-  assert.strictEqual(socket[kTimeout]._idleTimeout, -1);
-  assert(lastIdleStart < socket[kTimeout]._idleStart);
-});
+    tsocket.on('data', (chunk) => {
+      received += chunk.length;
+    });
+    tsocket.on('error', () => {});
+  }));
+
+  socket.on('close', common.mustCall(() => {
+    assert.strictEqual(socket._handle, null);
+    // Give a stale timer the chance to fire more than once.
+    setTimeout(() => server.close(), timeout * 2);
+  }));
+}));
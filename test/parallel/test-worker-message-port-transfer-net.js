@@ -0,0 +1,113 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { MessageChannel, Worker } = require('worker_threads');
+
+// Tests transferring net.Socket and net.Server instances to worker threads.
+// They are listed in the transfer list, and their handles are what arrives.
+
+if (common.isWindows) {
+  const server = net.createServer().listen(0, common.mustCall(() => {
+    const { port1, port2 } = new MessageChannel();
+    port2.once('message', common.mustNotCall());
+    assert.throws(() => {
+      port1.postMessage(server, [server]);
+    }, {
+      name: 'DataCloneError',
+      message: /^Cannot transfer network handle: /
+    });
+    port1.close();
+    server.close();
+  }));
+  return;
+}
+
+{
+  const server = net.createServer().listen(0, common.mustCall(() => {
+    const { port1, port2 } = new MessageChannel();
+    port2.once('message', common.mustNotCall());
+    assert.throws(() => {
+      port1.postMessage(server._handle);
+    }, {
+      name: 'DataCloneError',
+      message: 'Network handle must be listed in the transfer list'
+    });
+    assert.throws(() => {
+      port1.postMessage(null, [server, server._handle]);
+    }, {
+      name: 'DataCloneError',
+      message: 'Transfer list contains duplicate network handle'
+    });
+    assert.strictEqual(server.listening, true);
+    port1.close();
+    server.close();
+  }));
+}
+
+// Connections accepted on the main thread are served by a worker.
+{
+  const worker = new Worker(`
+    const net = require('net');
+    const { parentPort } = require('worker_threads');
+    parentPort.on('message', (handle) => {
+      const socket = new net.Socket({ handle });
+      socket.setEncoding('utf8');
+      socket.on('data', (data) => socket.end(data.toUpperCase()));
+    });
+  `, { eval: true });
+
+  const server = net.createServer({ pauseOnConnect: true });
+  server.on('connection', common.mustCall((socket) => {
+    worker.postMessage(socket, [socket]);
+    socket.on('close', common.mustCall(() => {
+      assert.strictEqual(socket.destroyed, true);
+      server.close(common.mustCall(() => worker.terminate()));
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    let response = '';
+    client.setEncoding('utf8');
+    client.on('data', (data) => response += data);
+    client.on('end', common.mustCall(() => {
+      assert.strictEqual(response, 'HELLO');
+    }));
+    client.end('hello');
+  }));
+}
+
+// A listening server is moved to a worker.
+{
+  const worker = new Worker(`
+    const net = require('net');
+    const { parentPort } = require('worker_threads');
+    parentPort.once('message', (handle) => {
+      const server = net.createServer((socket) => {
+        socket.end('worker');
+        server.close();
+      });
+      server.listen(handle, () => parentPort.postMessage('listening'));
+    });
+  `, { eval: true });
+
+  const server = net.createServer(common.mustNotCall());
+  server.on('close', common.mustCall(() => {
+    assert.strictEqual(server.listening, false);
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const { port } = server.address();
+    worker.postMessage(server, { transfer: [server] });
+    worker.once('message', common.mustCall(() => {
+      const client = net.connect(port);
+      let response = '';
+      client.setEncoding('utf8');
+      client.on('data', (data) => response += data);
+      client.on('end', common.mustCall(() => {
+        assert.strictEqual(response, 'worker');
+      }));
+    }));
+  }));
+}
@@ -201,6 +201,13 @@ if (common.hasCrypto) { // eslint-disable-line node-core/crypto-check
   testInitialized(new Signal(), 'Signal');
 }
 
+{
+  const { TimerWheel } = internalBinding('timers');
+  const wheel = new TimerWheel(1);
+  testInitialized(wheel, 'TimerWheel');
+  wheel.close();
+}
+
 {
   async function openTest() {
     const fd = await fsPromises.open(__filename, 'r');
@@ -46,6 +46,7 @@ const customTypesMap = {
   'brotli options': 'zlib.html#zlib_class_brotlioptions',
 
   'Buffer': 'buffer.html#buffer_class_buffer',
+  'BufferChain': 'buffer.html#buffer_class_bufferchain',
 
   'ChildProcess': 'child_process.html#child_process_class_childprocess',
 